@@ -100,6 +100,7 @@ enum initRFlags{
 
 #define ST7735_TFTWIDTH  128
 #define ST7735_TFTHEIGHT 160
+#define ST7735_SPI_MAX_HZ 15000000    // 66 ns minimum serial write cycle
 
 
 // Color definitions
@@ -126,6 +127,24 @@ void ST7735_InitB(void);
 void ST7735_InitR(enum initRFlags option);
 
 
+//------------ST7735_SetSPIClock------------
+// Change the SSI0 clock, for example after a new PLL_Init.
+// The init functions already set the fastest clock at or below
+// ST7735_SPI_MAX_HZ from the bus clock of the last PLL_Init.
+// Input: maxHz highest SSIClk allowed, in Hz
+// Output: resulting SSIClk in Hz, bus clock/(even divider)
+uint32_t ST7735_SetSPIClock(uint32_t maxHz);
+
+
+//------------ST7735_SetPixelStream------------
+// Choose how pixel data is sent after RAMWR: one 16-bit frame
+// per pixel (default) or two 8-bit frames as the original
+// driver did.  Both send the same bytes.
+// Input: on 1 for 16-bit frames, 0 for 8-bit frames
+// Output: none
+void ST7735_SetPixelStream(int on);
+
+
 //------------ST7735_DrawPixel------------
 // Color the pixel at the given coordinates with the given color.
 // Requires 13 bytes of transmission
@@ -183,6 +202,31 @@ void ST7735_FillScreen(uint16_t color);
 void ST7735_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
 
 
+//------------ST7735_FillRectDMA------------
+// Same as ST7735_FillRect, but the pixels are sent by uDMA
+// from a single color word, so the function returns as soon
+// as the address window is set.  Any other ST7735 function
+// waits for the fill to finish before it sends a command.
+// Requires (11 + 2*w*h) bytes of transmission (assuming image fully on screen)
+// Input: x     horizontal position of the top left corner of the rectangle, columns from the left edge
+//        y     vertical position of the top left corner of the rectangle, rows from the top edge
+//        w     horizontal width of the rectangle
+//        h     vertical height of the rectangle
+//        color 16-bit color, which can be produced by ST7735_Color565()
+//        done  called from the SSI0 interrupt when the last pixel is queued, 0 for none
+// Output: none
+void ST7735_FillRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, void (*done)(void));
+
+
+//------------ST7735_FillScreenDMA------------
+// Fill the screen with the given color using uDMA.
+// Requires 40,971 bytes of transmission
+// Input: color 16-bit color, which can be produced by ST7735_Color565()
+//        done  called from the SSI0 interrupt when the last pixel is queued, 0 for none
+// Output: none
+void ST7735_FillScreenDMA(uint16_t color, void (*done)(void));
+
+
 //------------ST7735_Color565------------
 // Pass 8-bit (each) R,G,B and get back 16-bit packed color.
 // Input: r red value
@@ -220,14 +264,32 @@ uint16_t ST7735_SwapColor(uint16_t x) ;
 // Must be less than or equal to 128 pixels wide by 160 pixels high
 void ST7735_DrawBitmap(int16_t x, int16_t y, const uint16_t *image, int16_t w, int16_t h);
 
+
+//------------ST7735_DrawBitmapDMA------------
+// Same as ST7735_DrawBitmap, but the rows are sent by uDMA
+// straight from image[], so the function returns as soon as
+// the address window is set.  image[] must stay valid until
+// done is called (flash images always are).
+// Requires (11 + 2*w*h) bytes of transmission (assuming image fully on screen)
+// Input: x     horizontal position of the bottom left corner of the image, columns from the left edge
+//        y     vertical position of the bottom left corner of the image, rows from the top edge
+//        image pointer to a 16-bit color BMP image
+//        w     number of pixels wide
+//        h     number of pixels tall
+//        done  called from the SSI0 interrupt when the last pixel is queued, 0 for none
+// Output: none
+// Must be less than or equal to 128 pixels wide by 160 pixels high
+void ST7735_DrawBitmapDMA(int16_t x, int16_t y, const uint16_t *image, int16_t w, int16_t h, void (*done)(void));
+
 //------------ST7735_DrawCharS------------
-// Simple character draw function.  This is the same function from
-// Adafruit_GFX.c but adapted for this processor.  However, each call
-// to ST7735_DrawPixel() calls setAddrWindow(), which needs to send
-// many extra data and commands.  If the background color is the same
-// as the text color, no background will be printed, and text can be
-// drawn right over existing images without covering them with a box.
-// Requires (11 + 2*size*size)*6*8 (image fully on screen; textcolor != bgColor)
+// Simple character draw function.  The character cell is built a
+// font row at a time in a line buffer and sent in one address
+// window, clipped to the screen.  If the background color is the
+// same as the text color, no background will be printed, and text
+// can be drawn right over existing images without covering them
+// with a box; each vertical run of set font bits is then one
+// ST7735_FillRect().
+// Requires (11 + 2*size*size*6*8) bytes of transmission (image fully on screen; textcolor != bgColor)
 // Input: x         horizontal position of the top left corner of the character, columns from the left edge
 //        y         vertical position of the top left corner of the character, rows from the top edge
 //        c         character to be printed
@@ -237,6 +299,22 @@ void ST7735_DrawBitmap(int16_t x, int16_t y, const uint16_t *image, int16_t w, i
 // Output: none
 void ST7735_DrawCharS(int16_t x, int16_t y, char c, int16_t textColor, int16_t bgColor, uint8_t size);
 
+//------------ST7735_DrawText------------
+// Draw n characters side by side, 6*size pixels apart, in one
+// address window clipped to the screen.  The characters do not
+// have to be null terminated.  Same colors and size as
+// ST7735_DrawCharS(), transparent if textColor == bgColor.
+// Requires (11 + 2*n*size*size*6*8) bytes of transmission (text fully on screen; textcolor != bgColor)
+// Input: x         horizontal position of the top left corner of the first character
+//        y         vertical position of the top left corner of the first character
+//        pt        pointer to the first character
+//        n         number of characters
+//        textColor 16-bit color of the characters
+//        bgColor   16-bit color of the background
+//        size      number of pixels per character pixel
+// Output: none
+void ST7735_DrawText(int16_t x, int16_t y, const char *pt, uint32_t n, uint16_t textColor, uint16_t bgColor, uint8_t size);
+
 //------------ST7735_DrawChar------------
 // Advanced character draw function.  This is similar to the function
 // from Adafruit_GFX.c but adapted for this processor.  However, this
@@ -261,6 +339,7 @@ void ST7735_DrawChar(int16_t x, int16_t y, char c, int16_t textColor, int16_t bg
 //        pt        pointer to a null terminated string to be printed
 //        textColor 16-bit color of the characters
 // bgColor is Black and size is 1
+// The whole string goes out in one address window
 // Output: number of characters printed
 uint32_t ST7735_DrawString(uint16_t x, uint16_t y, char *pt, int16_t textColor);
 
@@ -300,6 +379,47 @@ void ST7735_SetRotation(uint8_t m) ;
 // Output: none
 void ST7735_InvertDisplay(int i) ;
 
+
+//------------ST7735_SetScrollArea------------
+// Define the lines moved by hardware vertical scrolling
+// (VSCRDEF) and set the scroll start back to 0.  A line is a
+// screen row in rotations 0 and 2 and a screen column in
+// rotations 1 and 3.  Lines before and after the area stay
+// fixed, so text can frame a chart.  Call again after
+// ST7735_SetRotation().
+// Requires 10 bytes of transmission
+// Input: first first line of the area, rows or columns from the edge
+//        count number of lines in the area
+// Output: pixels across a line, 0 if the area does not fit
+uint32_t ST7735_SetScrollArea(uint8_t first, uint8_t count);
+
+
+//------------ST7735_SetScrollStart------------
+// Scroll the area of ST7735_SetScrollArea (VSCSAD): the line
+// drawn at first+offset shows at first, lines wrap around the
+// end of the area.  Only the start address changes, the
+// memory is not touched.  Drawing inside the area still uses
+// the unscrolled lines.
+// Requires 3 bytes of transmission
+// Input: offset lines the picture moves towards first, 0 to count-1
+// Output: none
+void ST7735_SetScrollStart(uint8_t offset);
+
+
+//------------ST7735_DrawLineRuns------------
+// Draw one scroll line, a screen row in rotations 0 and 2 or a
+// screen column in rotations 1 and 3, from runs of one color.
+// The line goes out in one address window, each run as color
+// repeated length times; runs past the end are cut and pixels
+// after the last run take its color.
+// Requires (11 + 2*128) bytes of transmission (160 pixels in rotations 1 and 3)
+// Input: line   row or column from the edge
+//        color  16-bit color of each run
+//        length pixels in each run, from the top or left edge
+//        runs   number of runs
+// Output: none
+void ST7735_DrawLineRuns(uint8_t line, const uint16_t *color, const uint8_t *length, uint32_t runs);
+
 // graphics routines
 // y coordinates 0 to 31 used for labels and messages
 // y coordinates 32 to 159  128 pixels high
@@ -0,0 +1,70 @@
+/*!
+ * @file  ST7735_Chart.h
+ * @brief Scrolling strip chart on the ST7735, one line write per sample.
+ * ----------
+ * The chart is a scroll area of ST7735_SetScrollArea: each sample is drawn
+ * into the oldest line as a few runs of color and the hardware scroll start
+ * moves by one, so the history slides by without being redrawn. A line is a
+ * screen row in rotations 0 and 2 (time runs down, values across) and a
+ * screen column in rotations 1 and 3 (time runs across). Up to
+ * ST7735_CHART_TRACES traces, one per sensor, each in a fixed color and
+ * joined to its previous sample so fast moves stay continuous.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#ifndef __ST7735_CHART_H__
+#define __ST7735_CHART_H__
+
+#include <stdint.h>
+
+#define ST7735_CHART_TRACES     4           // one per sensor
+#define ST7735_CHART_THICKNESS  2           // pixels of a trace across the line
+#define ST7735_CHART_GAP        INT32_MIN   // sample value for no reading
+
+/**
+ * ST7735_Chart_Init
+ * ----------
+ * @param  first    first line of the chart, rows or columns from the edge.
+ * @param  count    lines of history.
+ * @param  min      value at the start (left or top) of a line.
+ * @param  max      value at the end of a line, below min to flip the axis.
+ * @param  bgColor  background of the chart.
+ * ----------
+ * @return 1 on success, 0 if the lines do not fit on the screen.
+ * ----------
+ * @brief  Set the scroll area up and clear it. Nothing else should draw
+ *         into those lines while the chart runs.
+ */
+int ST7735_Chart_Init(uint8_t first, uint8_t count, int32_t min, int32_t max, uint16_t bgColor);
+
+/**
+ * ST7735_Chart_getColor
+ * ----------
+ * @param  trace  0 to ST7735_CHART_TRACES - 1.
+ * ----------
+ * @return color of the trace, for a legend.
+ */
+uint16_t ST7735_Chart_getColor(uint8_t trace);
+
+/**
+ * ST7735_Chart_plot
+ * ----------
+ * @param  values  one value per trace, ST7735_CHART_GAP for none.
+ * @param  traces  number of values, at most ST7735_CHART_TRACES.
+ * ----------
+ * @return runs of color the line took.
+ * ----------
+ * @brief  Add a sample: draw it into the oldest line and scroll it to the
+ *         end of the chart.
+ */
+uint32_t ST7735_Chart_plot(const int32_t* values, uint8_t traces);
+
+#endif
@@ -0,0 +1,114 @@
+/*!
+ * @file  ST7735_DMA.h
+ * @brief uDMA transfers from memory to SSI0 for the ST7735 pixel stream.
+ * ----------
+ * uDMA channel 11 (SSI0 TX) feeds 16-bit pixels to the SSI0 TX FIFO while
+ * the CPU goes on. Fills repeat one color word through a non-incrementing
+ * source, bitmaps are read row by row straight from flash. The address
+ * window and RAMWR must already be sent with D/C left on data, ST7735.c
+ * does that in ST7735_FillRectDMA and ST7735_DrawBitmapDMA.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#ifndef __ST7735_DMA_H__
+#define __ST7735_DMA_H__
+
+#include <stdint.h>
+
+#define ST7735_DMA_CHANNEL    11        // SSI0 TX, channel map encoding 0
+#define ST7735_DMA_MAX_ITEMS  1024      // largest basic mode transfer
+
+/*
+ *  One entry of the uDMA channel control table, 16 bytes on the TM4C123.
+ */
+typedef struct {
+    uintptr_t srcEnd;                   // address of the last source item
+    uintptr_t dstEnd;                   // address of the last destination item
+    uint32_t  control;                  // UDMA_CHCTL_* bits
+    uint32_t  spare;
+} ST7735_DMA_Entry;
+
+typedef void (*ST7735_DMA_Callback)(void);
+
+/**
+ * ST7735_DMA_Init
+ * ----------
+ * @brief  Turn on uDMA, map channel 11 to SSI0 TX and enable the SSI0
+ *         interrupt that signals the end of each transfer. SSI0 must be
+ *         set up already.
+ */
+void ST7735_DMA_Init(void);
+
+/**
+ * ST7735_DMA_fill
+ * ----------
+ * @param  color  16-bit color sent for every pixel.
+ * @param  count  number of pixels.
+ * @param  done   called from the SSI0 interrupt once every pixel is queued, 0 for none.
+ * ----------
+ * @brief  Start sending one color count times. Waits for the previous job first.
+ */
+void ST7735_DMA_fill(uint16_t color, uint32_t count, ST7735_DMA_Callback done);
+
+/**
+ * ST7735_DMA_copy
+ * ----------
+ * @param  image   first pixel of the first row sent.
+ * @param  width   pixels per row.
+ * @param  rows    number of rows.
+ * @param  stride  pixels from the first pixel of one row to the first of the next, negative for bottom-up images.
+ * @param  done    called from the SSI0 interrupt once every pixel is queued, 0 for none.
+ * ----------
+ * @brief  Start sending an image, a row per transfer (split if over
+ *         ST7735_DMA_MAX_ITEMS). Waits for the previous job first.
+ */
+void ST7735_DMA_copy(const uint16_t* image, uint16_t width, uint16_t rows, int32_t stride, ST7735_DMA_Callback done);
+
+/**
+ * ST7735_DMA_busy
+ * ----------
+ * @return 1 while a job still has pixels to hand to SSI0, 0 otherwise.
+ */
+int ST7735_DMA_busy(void);
+
+/**
+ * ST7735_DMA_wait
+ * ----------
+ * @brief  Wait for the job and the SSI0 FIFO to finish and put SSI0 back in
+ *         8-bit frames, so commands can follow. Cheap when nothing is queued.
+ */
+void ST7735_DMA_wait(void);
+
+/**
+ * ST7735_DMA_setFrames16
+ * ----------
+ * @param  on  1 for 16-bit frames, 0 for 8-bit frames.
+ * ----------
+ * @brief  Switch SSI0 frame size once the last frame is out. Also used by
+ *         the CPU pixel stream of ST7735.c; ST7735_DMA_wait goes back to 8.
+ */
+void ST7735_DMA_setFrames16(uint8_t on);
+
+/**
+ * ST7735_DMA_getChunks
+ * ----------
+ * @return uDMA transfers started since ST7735_DMA_Init.
+ */
+uint32_t ST7735_DMA_getChunks(void);
+
+/**
+ * SSI0_Handler
+ * ----------
+ * @brief  uDMA completion on channel 11, starts the next chunk or ends the job.
+ */
+void SSI0_Handler(void);
+
+#endif
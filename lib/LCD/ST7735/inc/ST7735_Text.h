@@ -0,0 +1,103 @@
+/*!
+ * @file  ST7735_Text.h
+ * @brief Retained text cells for the ST7735, only changed cells go on the link.
+ * ----------
+ * The screen is the 21x16 grid of ST7735_SetCursor, 6x10 pixels per cell.
+ * Printing only writes characters and colors into a back buffer;
+ * ST7735_Text_flush compares it with what the screen shows and sends each
+ * run of changed cells of one color in a single address window. A dashboard
+ * that reprints the same lines every loop then costs SPI traffic for the
+ * digits that changed, nothing for the rest.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#ifndef __ST7735_TEXT_H__
+#define __ST7735_TEXT_H__
+
+#include <stdint.h>
+
+#define ST7735_TEXT_COLUMNS  21         // ST7735_SetCursor columns 0 to 20
+#define ST7735_TEXT_ROWS     16         // ST7735_SetCursor rows 0 to 15
+
+/**
+ * ST7735_Text_Init
+ * ----------
+ * @param  text  color of the characters printed from now on.
+ * @param  bg    color of the screen, which must already be cleared to it
+ *               (ST7735_InitR leaves it black).
+ * ----------
+ * @brief  Start with every cell blank on screen and in the back buffer,
+ *         cursor at (0, 0).
+ */
+void ST7735_Text_Init(uint16_t text, uint16_t bg);
+
+/**
+ * ST7735_Text_clear
+ * ----------
+ * @brief  Blank every cell and home the cursor. Takes effect at the next
+ *         flush, which only sends the cells that were not blank.
+ */
+void ST7735_Text_clear(void);
+
+/**
+ * ST7735_Text_setCursor
+ * ----------
+ * @param  x  column, 0 to 20.
+ * @param  y  row, 0 to 15.
+ * ----------
+ * @brief  Move the cursor, ignored when out of the grid.
+ */
+void ST7735_Text_setCursor(uint32_t x, uint32_t y);
+
+/**
+ * ST7735_Text_setColor
+ * ----------
+ * @param  text  color of the characters printed from now on.
+ * @param  bg    color of their cells.
+ */
+void ST7735_Text_setColor(uint16_t text, uint16_t bg);
+
+/**
+ * ST7735_Text_putChar
+ * ----------
+ * @param  ch  character, newline (10, 13 or 27) goes to the start of the
+ *             next row and blanks it.
+ * ----------
+ * @brief  Same cursor rules as ST7735_OutChar: no wrap, a red '*' in the
+ *         last column marks an overflowing line.
+ */
+void ST7735_Text_putChar(char ch);
+
+/**
+ * ST7735_Text_putString
+ * ----------
+ * @param  pt  null terminated string.
+ */
+void ST7735_Text_putString(const char* pt);
+
+/**
+ * ST7735_Text_putUDec
+ * ----------
+ * @param  n  unsigned number printed in decimal, no padding.
+ */
+void ST7735_Text_putUDec(uint32_t n);
+
+/**
+ * ST7735_Text_flush
+ * ----------
+ * @return number of cells sent.
+ * ----------
+ * @brief  Send the cells that differ from the screen, one window per run of
+ *         adjacent changed cells of the same colors.
+ */
+uint32_t ST7735_Text_flush(void);
+
+#endif
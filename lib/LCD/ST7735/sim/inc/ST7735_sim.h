@@ -0,0 +1,182 @@
+/*!
+ * @file  ST7735_sim.h
+ * @brief Fake uDMA, SSI0 and port A registers for host builds of the ST7735 driver.
+ * ----------
+ * With ST7735_HOST defined the registers used by ST7735.c and ST7735_DMA.c
+ * are plain variables, except SSI0_DR and SSI0_SR which go through a call so
+ * every frame written is counted with the SSI0 clock and frame size of the
+ * time, and UDMA_ENASET_R which runs the fake controller on each access.
+ * ST7735_Sim_run plays the uDMA controller: it checks the channel setup,
+ * moves every item of the enabled transfer to SSI0 and calls SSI0_Handler
+ * the way the completion interrupt would.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#ifndef __ST7735_SIM_H__
+#define __ST7735_SIM_H__
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"                       // bit field definitions
+
+#define ST7735_SIM_OUTPUT   (128 * 160 * 2 + 16) // data frames kept, a full screen in 8-bit frames and its address window
+
+/*
+ *  The registers ST7735.c and ST7735_DMA.c touch.
+ */
+typedef struct {
+    uint32_t  rcgcdma, prdma, rcgcssi, rcgcgpio, prgpio;
+    uint32_t  gpioDir, gpioAfsel, gpioDen, gpioPctl, gpioAmsel;
+    uint32_t  cs, dc, reset;            // TFT_CS, DC and RESET pins
+    uint32_t  cfg, chmap1, prioclr, altclr, useburstclr, reqmaskclr, enaset, chis;
+    uintptr_t ctlbase;
+    uint32_t  ssiCr0, ssiCr1, ssiDr, ssiSr, ssiDmactl, ssiCc, ssiCpsr;
+    uint32_t  nvicPri1, nvicEn0;
+} ST7735_Sim_Regs;
+
+/*
+ *  SSI0 traffic since ST7735_Sim_Init or the last ST7735_Sim_resetStats.
+ */
+typedef struct {
+    uint32_t frames;                    // frames the CPU wrote to SSI0_DR
+    uint32_t dmaFrames;                 // frames uDMA moved to SSI0_DR
+    uint32_t statusReads;               // SSI0_SR polls
+    uint64_t bits;                      // bits shifted out
+    uint64_t cycles;                    // bus clock cycles the bits take at the SSI0 clock of the time
+} ST7735_Sim_Stats;
+
+extern volatile ST7735_Sim_Regs ST7735_Sim_regs;
+
+volatile uint32_t* ST7735_Sim_dataRegister(void);
+volatile uint32_t* ST7735_Sim_statusRegister(void);
+volatile uint32_t* ST7735_Sim_enableRegister(void);
+
+#undef  SYSCTL_RCGCDMA_R
+#undef  SYSCTL_PRDMA_R
+#undef  SYSCTL_RCGCSSI_R
+#undef  SYSCTL_RCGCGPIO_R
+#undef  SYSCTL_PRGPIO_R
+#undef  GPIO_PORTA_DIR_R
+#undef  GPIO_PORTA_AFSEL_R
+#undef  GPIO_PORTA_DEN_R
+#undef  GPIO_PORTA_PCTL_R
+#undef  GPIO_PORTA_AMSEL_R
+#undef  UDMA_CFG_R
+#undef  UDMA_CTLBASE_R
+#undef  UDMA_CHMAP1_R
+#undef  UDMA_PRIOCLR_R
+#undef  UDMA_ALTCLR_R
+#undef  UDMA_USEBURSTCLR_R
+#undef  UDMA_REQMASKCLR_R
+#undef  UDMA_ENASET_R
+#undef  UDMA_CHIS_R
+#undef  SSI0_CR0_R
+#undef  SSI0_CR1_R
+#undef  SSI0_DR_R
+#undef  SSI0_SR_R
+#undef  SSI0_DMACTL_R
+#undef  SSI0_CC_R
+#undef  SSI0_CPSR_R
+#undef  NVIC_PRI1_R
+#undef  NVIC_EN0_R
+
+#define SYSCTL_RCGCDMA_R    (ST7735_Sim_regs.rcgcdma)
+#define SYSCTL_PRDMA_R      (ST7735_Sim_regs.prdma)
+#define SYSCTL_RCGCSSI_R    (ST7735_Sim_regs.rcgcssi)
+#define SYSCTL_RCGCGPIO_R   (ST7735_Sim_regs.rcgcgpio)
+#define SYSCTL_PRGPIO_R     (ST7735_Sim_regs.prgpio)
+#define GPIO_PORTA_DIR_R    (ST7735_Sim_regs.gpioDir)
+#define GPIO_PORTA_AFSEL_R  (ST7735_Sim_regs.gpioAfsel)
+#define GPIO_PORTA_DEN_R    (ST7735_Sim_regs.gpioDen)
+#define GPIO_PORTA_PCTL_R   (ST7735_Sim_regs.gpioPctl)
+#define GPIO_PORTA_AMSEL_R  (ST7735_Sim_regs.gpioAmsel)
+#define TFT_CS              (ST7735_Sim_regs.cs)
+#define DC                  (ST7735_Sim_regs.dc)
+#define RESET               (ST7735_Sim_regs.reset)
+#define UDMA_CFG_R          (ST7735_Sim_regs.cfg)
+#define UDMA_CTLBASE_R      (ST7735_Sim_regs.ctlbase)
+#define UDMA_CHMAP1_R       (ST7735_Sim_regs.chmap1)
+#define UDMA_PRIOCLR_R      (ST7735_Sim_regs.prioclr)
+#define UDMA_ALTCLR_R       (ST7735_Sim_regs.altclr)
+#define UDMA_USEBURSTCLR_R  (ST7735_Sim_regs.useburstclr)
+#define UDMA_REQMASKCLR_R   (ST7735_Sim_regs.reqmaskclr)
+#define UDMA_ENASET_R       (*ST7735_Sim_enableRegister())
+#define UDMA_CHIS_R         (ST7735_Sim_regs.chis)
+#define SSI0_CR0_R          (ST7735_Sim_regs.ssiCr0)
+#define SSI0_CR1_R          (ST7735_Sim_regs.ssiCr1)
+#define SSI0_DR_R           (*ST7735_Sim_dataRegister())
+#define SSI0_SR_R           (*ST7735_Sim_statusRegister())
+#define SSI0_DMACTL_R       (ST7735_Sim_regs.ssiDmactl)
+#define SSI0_CC_R           (ST7735_Sim_regs.ssiCc)
+#define SSI0_CPSR_R         (ST7735_Sim_regs.ssiCpsr)
+#define NVIC_PRI1_R         (ST7735_Sim_regs.nvicPri1)
+#define NVIC_EN0_R          (ST7735_Sim_regs.nvicEn0)
+
+/**
+ * ST7735_Sim_Init
+ * ----------
+ * @brief  Reset the registers to SSI0 set up in 8-bit frames and clear the
+ *         output capture and counters.
+ */
+void ST7735_Sim_Init(void);
+
+/**
+ * ST7735_Sim_run
+ * ----------
+ * @brief  Complete the enabled transfer on channel 11 and every transfer the
+ *         completion interrupt starts after it.
+ */
+void ST7735_Sim_run(void);
+
+/**
+ * ST7735_Sim_getOutput
+ * ----------
+ * @param  count  data frames captured since the last reset.
+ * ----------
+ * @return the frames sent with D/C on data, by the CPU or uDMA.
+ */
+const uint16_t* ST7735_Sim_getOutput(uint32_t* count);
+
+/**
+ * ST7735_Sim_resetOutput
+ * ----------
+ * @brief  Empty the output capture.
+ */
+void ST7735_Sim_resetOutput(void);
+
+/**
+ * ST7735_Sim_getChunks
+ * ----------
+ * @return transfers completed since ST7735_Sim_Init.
+ */
+uint32_t ST7735_Sim_getChunks(void);
+
+/**
+ * ST7735_Sim_getStats
+ * ----------
+ * @param  result  SSI0 traffic since ST7735_Sim_Init or the last ST7735_Sim_resetStats.
+ */
+void ST7735_Sim_getStats(ST7735_Sim_Stats* result);
+
+/**
+ * ST7735_Sim_resetStats
+ * ----------
+ * @brief  Clear the SSI0 traffic counters.
+ */
+void ST7735_Sim_resetStats(void);
+
+/**
+ * ST7735_Sim_getErrors
+ * ----------
+ * @return transfers the fake controller found set up wrong, or not acknowledged.
+ */
+uint32_t ST7735_Sim_getErrors(void);
+
+#endif
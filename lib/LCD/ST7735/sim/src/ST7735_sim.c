@@ -0,0 +1,249 @@
+/*!
+ * @file  ST7735_sim.c
+ * @brief Fake uDMA, SSI0 and port A registers for host builds of the ST7735 driver.
+ * ----------
+ * Only what the driver relies on is modelled: SSI0 frames with their size
+ * and clock, which never leave the FIFO busy, and basic mode transfers of
+ * 16-bit items on channel 11 into the SSI0 data register, with the
+ * completion interrupt. A transfer is checked against the channel map, the
+ * SSI0 DMA and frame size settings and its control word before it runs.
+ * A CPU write to SSI0_DR is counted on the next access to SSI0_DR or SSI0_SR,
+ * the driver always touches one of them before it changes the frame format.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "ST7735_DMA.h"
+#include "ST7735_sim.h"
+
+#define SIM_CHANNEL_BIT (1 << ST7735_DMA_CHANNEL)
+#define SIM_CHIS_OTHER  0x00000001              // another channel pending, the handler must leave it alone
+#define SIM_DR_EMPTY    0xFFFFFFFF              // nothing written to SSI0_DR since the last access
+
+volatile ST7735_Sim_Regs ST7735_Sim_regs;
+
+static uint16_t         output[ST7735_SIM_OUTPUT];
+static uint32_t         outputCount = 0;
+static uint32_t         chunks = 0;
+static uint32_t         errors = 0;
+static uint8_t          running = 0;    // inside ST7735_Sim_run
+static ST7735_Sim_Stats stats;
+
+/**
+ * sendFrames
+ * ----------
+ * Description: count frames shifted out at the current frame size and SSI0 clock.
+ */
+static void sendFrames(uint32_t frames) {
+    uint32_t bits = (ST7735_Sim_regs.ssiCr0 & SSI_CR0_DSS_M) + 1;
+    uint32_t scr = (ST7735_Sim_regs.ssiCr0 & SSI_CR0_SCR_M) >> SSI_CR0_SCR_S;
+
+    // SSIClk = SysClk / (CPSDVSR * (1 + SCR))
+    stats.bits += (uint64_t)frames * bits;
+    stats.cycles += (uint64_t)frames * bits * (ST7735_Sim_regs.ssiCpsr & SSI_CPSR_CPSDVSR_M) * (1 + scr);
+}
+
+/**
+ * capture
+ * ----------
+ * Description: keep a data frame in the output buffer.
+ */
+static void capture(uint16_t frame) {
+    if (outputCount < ST7735_SIM_OUTPUT) output[outputCount++] = frame;
+}
+
+/**
+ * commitWrite
+ * ----------
+ * Description: count the frame the CPU left in SSI0_DR, if any.
+ */
+static void commitWrite(void) {
+    if (ST7735_Sim_regs.ssiDr == SIM_DR_EMPTY) return;
+    stats.frames++;
+    sendFrames(1);
+    if (ST7735_Sim_regs.dc != 0) capture(ST7735_Sim_regs.ssiDr);
+    ST7735_Sim_regs.ssiDr = SIM_DR_EMPTY;
+}
+
+/**
+ * checkSetup
+ * ----------
+ * Description: 1 if the channel and SSI0 are set up for a transfer of entry.
+ */
+static int checkSetup(const ST7735_DMA_Entry* entry) {
+    uint32_t control = entry->control;
+
+    if ((UDMA_CFG_R & UDMA_CFG_MASTEN) == 0) return 0;
+    if ((UDMA_CHMAP1_R & UDMA_CHMAP1_CH11SEL_M) != 0) return 0;
+    if ((SSI0_DMACTL_R & SSI_DMACTL_TXDMAE) == 0) return 0;
+    if ((SSI0_CR1_R & SSI_CR1_SSE) == 0) return 0;
+    if ((SSI0_CR0_R & SSI_CR0_DSS_M) != SSI_CR0_DSS_16) return 0;
+    if ((NVIC_EN0_R & (1 << 7)) == 0) return 0;
+    if (entry->dstEnd != (uintptr_t)&SSI0_DR_R) return 0;
+    if ((control & UDMA_CHCTL_DSTINC_M) != UDMA_CHCTL_DSTINC_NONE) return 0;
+    if ((control & UDMA_CHCTL_DSTSIZE_M) != UDMA_CHCTL_DSTSIZE_16) return 0;
+    if ((control & UDMA_CHCTL_SRCSIZE_M) != UDMA_CHCTL_SRCSIZE_16) return 0;
+    if ((control & UDMA_CHCTL_SRCINC_M) != UDMA_CHCTL_SRCINC_16 &&
+        (control & UDMA_CHCTL_SRCINC_M) != UDMA_CHCTL_SRCINC_NONE) return 0;
+    if ((control & UDMA_CHCTL_XFERMODE_M) != UDMA_CHCTL_XFERMODE_BASIC) return 0;
+
+    return 1;
+}
+
+/**
+ * ST7735_Sim_Init
+ * ----------
+ * @brief  Reset the registers to SSI0 set up for the ST7735 in 8-bit frames
+ *         and clear the output capture and counters.
+ */
+void ST7735_Sim_Init(void) {
+    memset((void*)&ST7735_Sim_regs, 0, sizeof(ST7735_Sim_regs));
+    ST7735_Sim_regs.prdma = SYSCTL_PRDMA_R0;
+    ST7735_Sim_regs.prgpio = SYSCTL_PRGPIO_R0;
+    ST7735_Sim_regs.ssiCr0 = SSI_CR0_DSS_8;
+    ST7735_Sim_regs.ssiCr1 = SSI_CR1_SSE;
+    ST7735_Sim_regs.ssiCpsr = 2;
+    ST7735_Sim_regs.ssiDr = SIM_DR_EMPTY;
+    outputCount = 0;
+    chunks = 0;
+    errors = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * ST7735_Sim_dataRegister
+ * ----------
+ * @return SSI0_DR, after counting the frame written to it last.
+ */
+volatile uint32_t* ST7735_Sim_dataRegister(void) {
+    commitWrite();
+    return &ST7735_Sim_regs.ssiDr;
+}
+
+/**
+ * ST7735_Sim_statusRegister
+ * ----------
+ * @return SSI0_SR, transmit FIFO never full and never busy.
+ */
+volatile uint32_t* ST7735_Sim_statusRegister(void) {
+    commitWrite();
+    stats.statusReads++;
+    ST7735_Sim_regs.ssiSr = SSI_SR_TNF | SSI_SR_TFE;
+    return &ST7735_Sim_regs.ssiSr;
+}
+
+/**
+ * ST7735_Sim_enableRegister
+ * ----------
+ * @return UDMA_ENASET, after running the transfer enabled so far.
+ */
+volatile uint32_t* ST7735_Sim_enableRegister(void) {
+    ST7735_Sim_run();
+    return &ST7735_Sim_regs.enaset;
+}
+
+/**
+ * ST7735_Sim_run
+ * ----------
+ * @brief  Complete the enabled transfer on channel 11 and every transfer the
+ *         completion interrupt starts after it.
+ */
+void ST7735_Sim_run(void) {
+    if (running) return;                        // SSI0_Handler starting the next chunk
+    running = 1;
+    commitWrite();
+    while (ST7735_Sim_regs.enaset & SIM_CHANNEL_BIT) {
+        const ST7735_DMA_Entry* entry = (const ST7735_DMA_Entry*)ST7735_Sim_regs.ctlbase + ST7735_DMA_CHANNEL;
+        uint32_t                items = ((entry->control & UDMA_CHCTL_XFERSIZE_M) >> UDMA_CHCTL_XFERSIZE_S) + 1;
+        int                     increment = (entry->control & UDMA_CHCTL_SRCINC_M) == UDMA_CHCTL_SRCINC_16;
+        const uint16_t*         src = (const uint16_t*)entry->srcEnd - (increment ? items - 1 : 0);
+
+        ST7735_Sim_regs.enaset &= ~SIM_CHANNEL_BIT;     // basic mode channels disable when done
+
+        if (!checkSetup(entry)) errors++;         // still run it, so the job ends
+
+        for (uint32_t i = 0; i < items; i++) {
+            capture(*src);
+            if (increment) src++;
+        }
+        stats.dmaFrames += items;
+        sendFrames(items);
+        chunks++;
+
+        // completion interrupt, the handler must acknowledge channel 11 alone
+        ST7735_Sim_regs.chis = SIM_CHANNEL_BIT | SIM_CHIS_OTHER;
+        SSI0_Handler();
+        if (ST7735_Sim_regs.chis != SIM_CHANNEL_BIT) errors++;
+        ST7735_Sim_regs.chis = 0;
+    }
+    running = 0;
+}
+
+/**
+ * ST7735_Sim_getOutput
+ * ----------
+ * @param  count  pixels captured since the last reset.
+ * ----------
+ * @return the captured pixels.
+ */
+const uint16_t* ST7735_Sim_getOutput(uint32_t* count) {
+    commitWrite();
+    *count = outputCount;
+    return output;
+}
+
+/**
+ * ST7735_Sim_resetOutput
+ * ----------
+ * @brief  Empty the output capture.
+ */
+void ST7735_Sim_resetOutput(void) {
+    outputCount = 0;
+}
+
+/**
+ * ST7735_Sim_getChunks
+ * ----------
+ * @return transfers completed since ST7735_Sim_Init.
+ */
+uint32_t ST7735_Sim_getChunks(void) {
+    return chunks;
+}
+
+/**
+ * ST7735_Sim_getStats
+ * ----------
+ * @param  result  SSI0 traffic since ST7735_Sim_Init or the last ST7735_Sim_resetStats.
+ */
+void ST7735_Sim_getStats(ST7735_Sim_Stats* result) {
+    commitWrite();
+    *result = stats;
+}
+
+/**
+ * ST7735_Sim_resetStats
+ * ----------
+ * @brief  Clear the SSI0 traffic counters.
+ */
+void ST7735_Sim_resetStats(void) {
+    commitWrite();
+    memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * ST7735_Sim_getErrors
+ * ----------
+ * @return transfers the fake controller found set up wrong, or not acknowledged.
+ */
+uint32_t ST7735_Sim_getErrors(void) {
+    return errors;
+}
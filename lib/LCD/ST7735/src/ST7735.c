@@ -91,7 +91,14 @@
 #include <stdio.h>
 #include <stdint.h>
 #include "ST7735.h"
+#include "ST7735_DMA.h"
+#include "PLL.h"
+#ifdef ST7735_HOST
+#include "ST7735_sim.h"
+#else
 #include "tm4c123gh6pm.h"
+#endif
+#include "Timebase.h"
 
 // 16 rows (0 to 15) and 21 characters (0 to 20)
 // Requires (11 + size*size*6*8) bytes of transmission for each character
@@ -145,17 +152,20 @@ uint16_t StTextColor = ST7735_YELLOW;
 #define ST7735_GMCTRP1 0xE0
 #define ST7735_GMCTRN1 0xE1
 
+#ifndef ST7735_HOST                        // host builds get the pins from ST7735_sim.h
 #define TFT_CS                  (*((volatile uint32_t *)0x40004020))
+#define DC                      (*((volatile uint32_t *)0x40004100))
+#define RESET                   (*((volatile uint32_t *)0x40004200))
+#endif
 #define TFT_CS_LOW              0           // CS normally controlled by hardware
 #define TFT_CS_HIGH             0x08
-#define DC                      (*((volatile uint32_t *)0x40004100))
 #define DC_COMMAND              0
 #define DC_DATA                 0x40
-#define RESET                   (*((volatile uint32_t *)0x40004200))
 #define RESET_LOW               0
 #define RESET_HIGH              0x80
 
 #define SSI_CR0_SCR_M           0x0000FF00  // SSI Serial Clock Rate
+#define SSI_CR0_SCR_S           8
 #define SSI_CR0_SPH             0x00000080  // SSI Serial Clock Phase
 #define SSI_CR0_SPO             0x00000040  // SSI Serial Clock Polarity
 #define SSI_CR0_FRF_M           0x00000030  // SSI Frame Format Select
@@ -197,8 +207,10 @@ uint16_t StTextColor = ST7735_YELLOW;
 #define ST7735_RAMRD   0x2E
 
 #define ST7735_PTLAR   0x30
+#define ST7735_VSCRDEF 0x33
 #define ST7735_COLMOD  0x3A
 #define ST7735_MADCTL  0x36
+#define ST7735_VSCSAD  0x37
 
 #define ST7735_FRMCTR1 0xB1
 #define ST7735_FRMCTR2 0xB2
@@ -489,6 +501,8 @@ static uint8_t Rotation;           // 0 to 3
 static enum initRFlags TabColor;
 static int16_t _width = ST7735_TFTWIDTH;   // this could probably be a constant, except it is used in Adafruit_GFX and depends on image rotation
 static int16_t _height = ST7735_TFTHEIGHT;
+static uint8_t PixelStream = 1;    // pixel data in 16-bit frames, see startPixels()
+static uint8_t ScrollTop, ScrollCount; // scroll area of ST7735_SetScrollArea(), in memory lines
 
 
 // The Data/Command pin must be valid when the eighth bit is
@@ -509,6 +523,7 @@ static int16_t _height = ST7735_TFTHEIGHT;
 // NOTE: These functions will crash or stall indefinitely if
 // the SSI0 module is not initialized and enabled.
 void static writecommand(uint8_t c) {
+  ST7735_DMA_wait();                    // finish any uDMA pixel stream, back to 8-bit frames
                                         // wait until SSI0 not busy/transmit FIFO empty
   while((SSI0_SR_R&SSI_SR_BSY)==SSI_SR_BSY){};
   DC = DC_COMMAND;
@@ -523,18 +538,55 @@ void static writedata(uint8_t c) {
   DC = DC_DATA;
   SSI0_DR_R = c;                        // data out
 }
+
+// Pixel data that follows RAMWR goes out as one 16-bit SSI
+// frame per pixel, most significant byte first, which is the
+// same bit stream as two 8-bit frames with half the FIFO
+// writes and checks.  startPixels() switches the frame size
+// after setAddrWindow(); the next writecommand() switches it
+// back.  Not worth the switch for a single pixel.
+void static startPixels(void) {
+  if(PixelStream) ST7735_DMA_setFrames16(1);
+  DC = DC_DATA;
+}
+
+
+void static writepixel(uint16_t color) {
+  if(PixelStream){
+    while((SSI0_SR_R&SSI_SR_TNF)==0){}; // wait until transmit FIFO not full
+    SSI0_DR_R = color;                  // pixel out
+  } else{
+    writedata((uint8_t)(color >> 8));
+    writedata((uint8_t)color);
+  }
+}
+
+
+// Set the SSI0 clock divider for the fastest clock at or
+// below maxHz: SysClk/(CPSDVSR*(1+SCR)), CPSDVSR even from
+// 2 to 254.  SSI0 must be disabled.
+// Output: resulting SSIClk in Hz
+uint32_t static setSPIDivider(uint32_t maxHz) {
+  uint32_t bus = PLL_GetBusClock();
+  uint32_t div = (bus + maxHz - 1)/maxHz; // smallest total divider
+  uint32_t cpsdvsr, scr = 0;
+
+  if(div < 2) div = 2;
+  cpsdvsr = (div + 1)&~1;
+  while(cpsdvsr > 254){                 // slow clocks also need SCR
+    scr = scr + 1;
+    cpsdvsr = ((div + scr)/(scr + 1) + 1)&~1;
+  }
+  SSI0_CPSR_R = (SSI0_CPSR_R&~SSI_CPSR_CPSDVSR_M)+cpsdvsr;
+  SSI0_CR0_R = (SSI0_CR0_R&~SSI_CR0_SCR_M)+(scr<<SSI_CR0_SCR_S);
+  return bus/(cpsdvsr*(1 + scr));
+}
 // Subroutine to wait 1 msec
 // Inputs: None
 // Outputs: None
 // Notes: ...
-void Delay1ms(uint32_t n){uint32_t volatile time;
-  while(n){
-    time = 72724*2/91;  // 1msec, tuned at 80 MHz
-    while(time){
-      time--;
-    }
-    n--;
-  }
+void Delay1ms(uint32_t n){
+  Timebase_sleepUs(n*1000);             // exact at any bus clock, sleeps in WFI
 }
 
 // Rather than a bazillion writecommand() and writedata() calls, screen
@@ -736,20 +788,17 @@ void static commonInit(const uint8_t *cmdList) {
   SSI0_CR1_R &= ~SSI_CR1_MS;            // master mode
                                         // configure for system clock/PLL baud clock source
   SSI0_CC_R = (SSI0_CC_R&~SSI_CC_CS_M)+SSI_CC_CS_SYSPLL;
-//                                        // clock divider for 3.125 MHz SSIClk (50 MHz PIOSC/16)
-//  SSI0_CPSR_R = (SSI0_CPSR_R&~SSI_CPSR_CPSDVSR_M)+16;
-                                        // clock divider for 8 MHz SSIClk (80 MHz PLL/24)
-                                        // SysClk/(CPSDVSR*(1+SCR))
-                                        // 80/(10*(1+0)) = 8 MHz (slower than 4 MHz)
-  SSI0_CPSR_R = (SSI0_CPSR_R&~SSI_CPSR_CPSDVSR_M)+10; // must be even number
-  SSI0_CR0_R &= ~(SSI_CR0_SCR_M |       // SCR = 0 (8 Mbps data rate)
-                  SSI_CR0_SPH |         // SPH = 0
+                                        // fastest SSIClk the ST7735 takes at the PLL_Init bus clock
+                                        // 80 MHz/6 = 13.3 MHz, 50 MHz/4 = 12.5 MHz, 16 MHz/2 = 8 MHz
+  setSPIDivider(ST7735_SPI_MAX_HZ);
+  SSI0_CR0_R &= ~(SSI_CR0_SPH |         // SPH = 0
                   SSI_CR0_SPO);         // SPO = 0
                                         // FRF = Freescale format
   SSI0_CR0_R = (SSI0_CR0_R&~SSI_CR0_FRF_M)+SSI_CR0_FRF_MOTO;
                                         // DSS = 8-bit data
   SSI0_CR0_R = (SSI0_CR0_R&~SSI_CR0_DSS_M)+SSI_CR0_DSS_8;
   SSI0_CR1_R |= SSI_CR1_SSE;            // enable SSI
+  ST7735_DMA_Init();                    // uDMA channel 11 feeds SSI0 for the *DMA functions
 
   if(cmdList) commandList(cmdList);
 }
@@ -795,6 +844,34 @@ void ST7735_InitR(enum initRFlags option) {
 }
 
 
+//------------ST7735_SetSPIClock------------
+// Change the SSI0 clock, for example after a new PLL_Init.
+// The init functions already set the fastest clock at or below
+// ST7735_SPI_MAX_HZ from the bus clock of the last PLL_Init.
+// Input: maxHz highest SSIClk allowed, in Hz
+// Output: resulting SSIClk in Hz, bus clock/(even divider)
+uint32_t ST7735_SetSPIClock(uint32_t maxHz){
+  uint32_t hz;
+  ST7735_DMA_wait();                    // finish any uDMA pixel stream
+  while((SSI0_SR_R&SSI_SR_BSY)==SSI_SR_BSY){};
+  SSI0_CR1_R &= ~SSI_CR1_SSE;           // disable SSI
+  hz = setSPIDivider(maxHz);
+  SSI0_CR1_R |= SSI_CR1_SSE;            // enable SSI
+  return hz;
+}
+
+
+//------------ST7735_SetPixelStream------------
+// Choose how pixel data is sent after RAMWR: one 16-bit frame
+// per pixel (default) or two 8-bit frames as the original
+// driver did.  Both send the same bytes.
+// Input: on 1 for 16-bit frames, 0 for 8-bit frames
+// Output: none
+void ST7735_SetPixelStream(int on){
+  PixelStream = on ? 1 : 0;
+}
+
+
 // Set the region of the screen RAM to be modified
 // Pixel colors are sent left to right, top to bottom
 // (same as Font table is encoded; different from regular bitmap)
@@ -857,16 +934,15 @@ void ST7735_DrawPixel(int16_t x, int16_t y, uint16_t color) {
 //        color 16-bit color, which can be produced by ST7735_Color565()
 // Output: none
 void ST7735_DrawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
-  uint8_t hi = color >> 8, lo = color;
 
   // Rudimentary clipping
   if((x >= _width) || (y >= _height)) return;
   if((y+h-1) >= _height) h = _height-y;
   setAddrWindow(x, y, x, y+h-1);
 
+  startPixels();
   while (h--) {
-    writedata(hi);
-    writedata(lo);
+    writepixel(color);
   }
 }
 
@@ -881,16 +957,15 @@ void ST7735_DrawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
 //        color 16-bit color, which can be produced by ST7735_Color565()
 // Output: none
 void ST7735_DrawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
-  uint8_t hi = color >> 8, lo = color;
 
   // Rudimentary clipping
   if((x >= _width) || (y >= _height)) return;
   if((x+w-1) >= _width)  w = _width-x;
   setAddrWindow(x, y, x+w-1, y);
 
+  startPixels();
   while (w--) {
-    writedata(hi);
-    writedata(lo);
+    writepixel(color);
   }
 }
 
@@ -916,7 +991,6 @@ void ST7735_FillScreen(uint16_t color) {
 //        color 16-bit color, which can be produced by ST7735_Color565()
 // Output: none
 void ST7735_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-  uint8_t hi = color >> 8, lo = color;
 
   // rudimentary clipping (drawChar w/big text requires this)
   if((x >= _width) || (y >= _height)) return;
@@ -925,15 +999,55 @@ void ST7735_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
 
   setAddrWindow(x, y, x+w-1, y+h-1);
 
+  startPixels();
   for(y=h; y>0; y--) {
     for(x=w; x>0; x--) {
-      writedata(hi);
-      writedata(lo);
+      writepixel(color);
     }
   }
 }
 
 
+//------------ST7735_FillRectDMA------------
+// Same as ST7735_FillRect, but the pixels are sent by uDMA
+// from a single color word, so the function returns as soon
+// as the address window is set.  Any other ST7735 function
+// waits for the fill to finish before it sends a command.
+// Requires (11 + 2*w*h) bytes of transmission (assuming image fully on screen)
+// Input: x     horizontal position of the top left corner of the rectangle, columns from the left edge
+//        y     vertical position of the top left corner of the rectangle, rows from the top edge
+//        w     horizontal width of the rectangle
+//        h     vertical height of the rectangle
+//        color 16-bit color, which can be produced by ST7735_Color565()
+//        done  called from the SSI0 interrupt when the last pixel is queued, 0 for none
+// Output: none
+void ST7735_FillRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, void (*done)(void)) {
+
+  // rudimentary clipping, same as ST7735_FillRect
+  if((x >= _width) || (y >= _height) || (w <= 0) || (h <= 0)){
+    if(done) done();
+    return;
+  }
+  if((x + w - 1) >= _width)  w = _width  - x;
+  if((y + h - 1) >= _height) h = _height - y;
+
+  setAddrWindow(x, y, x+w-1, y+h-1);
+  DC = DC_DATA;                         // the rest of the transfer is pixel data
+  ST7735_DMA_fill(color, (uint32_t)w*h, done);
+}
+
+
+//------------ST7735_FillScreenDMA------------
+// Fill the screen with the given color using uDMA.
+// Requires 40,971 bytes of transmission
+// Input: color 16-bit color, which can be produced by ST7735_Color565()
+//        done  called from the SSI0 interrupt when the last pixel is queued, 0 for none
+// Output: none
+void ST7735_FillScreenDMA(uint16_t color, void (*done)(void)) {
+  ST7735_FillRectDMA(0, 0, _width, _height, color, done);
+}
+
+
 //------------ST7735_Color565------------
 // Pass 8-bit (each) R,G,B and get back 16-bit packed color.
 // Input: r red value
@@ -974,48 +1088,63 @@ uint16_t ST7735_SwapColor(uint16_t x) {
 //        h     number of pixels tall
 // Output: none
 // Must be less than or equal to 128 pixels wide by 160 pixels high
-void ST7735_DrawBitmap(int16_t x, int16_t y, const uint16_t *image, int16_t w, int16_t h){
-  int16_t skipC = 0;                      // non-zero if columns need to be skipped due to clipping
-  int16_t originalWidth = w;              // save this value; even if not all columns fit on the screen, the image is still this width in ROM
-  int i = w*(h - 1);
-
-  if((x >= _width) || ((y - h + 1) >= _height) || ((x + w) <= 0) || (y < 0)){
-    return;                             // image is totally off the screen, do nothing
+// Clip a bitmap anchored at its lower left corner (x,y) and
+// set the address window to the part left on the screen.
+// Input: x,y   lower left corner of the image
+//        w,h   size of the image, set to the size of the window
+//        skipC set to the number of columns cut off per row
+// Output: index in image[] of the first pixel sent (top left
+//         of the window), -1 if nothing is on the screen
+int static bitmapWindow(int16_t x, int16_t y, int16_t *w, int16_t *h, int16_t *skipC){
+  int16_t originalWidth = *w;             // save this value; even if not all columns fit on the screen, the image is still this width in ROM
+  int i = (*w)*(*h - 1);
+
+  *skipC = 0;                           // non-zero if columns need to be skipped due to clipping
+  if((x >= _width) || ((y - *h + 1) >= _height) || ((x + *w) <= 0) || (y < 0)){
+    return -1;                          // image is totally off the screen, do nothing
   }
-  if((w > _width) || (h > _height)){    // image is too wide for the screen, do nothing
+  if((*w > _width) || (*h > _height)){  // image is too wide for the screen, do nothing
     //***This isn't necessarily a fatal error, but it makes the
     //following logic much more complicated, since you can have
     //an image that exceeds multiple boundaries and needs to be
     //clipped on more than one side.
-    return;
+    return -1;
   }
-  if((x + w - 1) >= _width){            // image exceeds right of screen
-    skipC = (x + w) - _width;           // skip cut off columns
-    w = _width - x;
+  if((x + *w - 1) >= _width){           // image exceeds right of screen
+    *skipC = (x + *w) - _width;         // skip cut off columns
+    *w = _width - x;
   }
-  if((y - h + 1) < 0){                  // image exceeds top of screen
-    i = i - (h - y - 1)*originalWidth;  // skip the last cut off rows
-    h = y + 1;
+  if((y - *h + 1) < 0){                 // image exceeds top of screen
+    i = i - (*h - y - 1)*originalWidth; // skip the last cut off rows
+    *h = y + 1;
   }
   if(x < 0){                            // image exceeds left of screen
-    w = w + x;
-    skipC = -1*x;                       // skip cut off columns
+    *w = *w + x;
+    *skipC = -1*x;                      // skip cut off columns
     i = i - x;                          // skip the first cut off columns
     x = 0;
   }
   if(y >= _height){                     // image exceeds bottom of screen
-    h = h - (y - _height + 1);
+    *h = *h - (y - _height + 1);
     y = _height - 1;
   }
 
-  setAddrWindow(x, y-h+1, x+w-1, y);
+  setAddrWindow(x, y-*h+1, x+*w-1, y);
+  return i;
+}
+
 
+void ST7735_DrawBitmap(int16_t x, int16_t y, const uint16_t *image, int16_t w, int16_t h){
+  int16_t skipC;
+  int16_t originalWidth = w;
+  int i = bitmapWindow(x, y, &w, &h, &skipC);
+
+  if(i < 0) return;
+
+  startPixels();
   for(y=0; y<h; y=y+1){
     for(x=0; x<w; x=x+1){
-                                        // send the top 8 bits
-      writedata((uint8_t)(image[i] >> 8));
-                                        // send the bottom 8 bits
-      writedata((uint8_t)image[i]);
+      writepixel(image[i]);             // send the pixel, top 8 bits first
       i = i + 1;                        // go to the next pixel
     }
     i = i + skipC;
@@ -1024,14 +1153,102 @@ void ST7735_DrawBitmap(int16_t x, int16_t y, const uint16_t *image, int16_t w, i
 }
 
 
+//------------ST7735_DrawBitmapDMA------------
+// Same as ST7735_DrawBitmap, but the rows are sent by uDMA
+// straight from image[], so the function returns as soon as
+// the address window is set.  image[] must stay valid until
+// done is called (flash images always are).
+// Requires (11 + 2*w*h) bytes of transmission (assuming image fully on screen)
+// Input: x     horizontal position of the bottom left corner of the image, columns from the left edge
+//        y     vertical position of the bottom left corner of the image, rows from the top edge
+//        image pointer to a 16-bit color BMP image
+//        w     number of pixels wide
+//        h     number of pixels tall
+//        done  called from the SSI0 interrupt when the last pixel is queued, 0 for none
+// Output: none
+// Must be less than or equal to 128 pixels wide by 160 pixels high
+void ST7735_DrawBitmapDMA(int16_t x, int16_t y, const uint16_t *image, int16_t w, int16_t h, void (*done)(void)){
+  int16_t skipC;
+  int16_t originalWidth = w;
+  int i = bitmapWindow(x, y, &w, &h, &skipC);
+
+  if(i < 0){
+    if(done) done();
+    return;
+  }
+  DC = DC_DATA;                         // the rest of the transfer is pixel data
+                                        // rows are stored bottom up, one row back each time
+  ST7735_DMA_copy(&image[i], w, h, -originalWidth, done);
+}
+
+
+// Draw a run of n characters side by side, 6*size pixels apart,
+// top left corner at (x,y).  Opaque text (textColor != bgColor)
+// goes out in one address window, clipped to the screen: each of
+// the 8 font rows is built once in TextLine[] and sent size
+// times.  Transparent text sends one window per vertical run of
+// set font bits.
+static uint16_t TextLine[ST7735_TFTHEIGHT];  // one screen row in any rotation
+void static drawText(int16_t x, int16_t y, const char *pt, uint32_t n, uint16_t textColor, uint16_t bgColor, uint8_t size){
+  int32_t x0, x1, y0, y1;               // window on the screen
+  int32_t row, col, i, j, start;
+  uint8_t bits;
+
+  if(size == 0) return;
+  if(textColor == bgColor){             // transparent
+    for(i=0; i<(int32_t)n; i=i+1){
+      for(col=0; col<5; col=col+1){
+        bits = Font[((uint8_t)pt[i])*5 + col];
+        for(row=0; row<8; row=row+1){
+          if((bits>>row)&0x01){
+            start = row;
+            while((row < 7) && ((bits>>(row+1))&0x01)) row = row+1;
+            ST7735_FillRect(x+(i*6+col)*size, y+start*size, size, (row-start+1)*size, textColor);
+          }
+        }
+      }
+    }
+    return;
+  }
+
+  x0 = x; x1 = x + 6*size*n - 1;
+  y0 = y; y1 = y + 8*size - 1;
+  if(x0 < 0) x0 = 0;
+  if(y0 < 0) y0 = 0;
+  if(x1 >= _width)  x1 = _width - 1;
+  if(y1 >= _height) y1 = _height - 1;
+  if((x0 > x1) || (y0 > y1)) return;    // off the screen
+
+  setAddrWindow(x0, y0, x1, y1);
+  startPixels();
+  for(row=(y0-y)/size; row<8; row=row+1){
+                                        // build the font row across the visible columns
+    for(j=x0; j<=x1; j=j+1){
+      i = (j - x)/size;                 // font column from the left of the run
+      col = i%6;
+      bits = (col < 5) ? Font[((uint8_t)pt[i/6])*5 + col] : 0;
+      TextLine[j-x0] = ((bits>>row)&0x01) ? textColor : bgColor;
+    }
+                                        // send it once per screen row it covers
+    for(i=0; i<size; i=i+1){
+      if((y + row*size + i < y0) || (y + row*size + i > y1)) continue;
+      for(j=0; j<=x1-x0; j=j+1){
+        writepixel(TextLine[j]);
+      }
+    }
+  }
+}
+
+
 //------------ST7735_DrawCharS------------
-// Simple character draw function.  This is the same function from
-// Adafruit_GFX.c but adapted for this processor.  However, each call
-// to ST7735_DrawPixel() calls setAddrWindow(), which needs to send
-// many extra data and commands.  If the background color is the same
-// as the text color, no background will be printed, and text can be
-// drawn right over existing images without covering them with a box.
-// Requires (11 + 2*size*size)*6*8 (image fully on screen; textcolor != bgColor)
+// Simple character draw function.  The character cell is built a
+// font row at a time in a line buffer and sent in one address
+// window, clipped to the screen.  If the background color is the
+// same as the text color, no background will be printed, and text
+// can be drawn right over existing images without covering them
+// with a box; each vertical run of set font bits is then one
+// ST7735_FillRect().
+// Requires (11 + 2*size*size*6*8) bytes of transmission (image fully on screen; textcolor != bgColor)
 // Input: x         horizontal position of the top left corner of the character, columns from the left edge
 //        y         vertical position of the top left corner of the character, rows from the top edge
 //        c         character to be printed
@@ -1040,36 +1257,26 @@ void ST7735_DrawBitmap(int16_t x, int16_t y, const uint16_t *image, int16_t w, i
 //        size      number of pixels per character pixel (e.g. size==2 prints each pixel of font as 2x2 square)
 // Output: none
 void ST7735_DrawCharS(int16_t x, int16_t y, char c, int16_t textColor, int16_t bgColor, uint8_t size){
-  uint8_t line; // vertical column of pixels of character in font
-  int32_t i, j;
-  if((x >= _width)            || // Clip right
-     (y >= _height)           || // Clip bottom
-     ((x + 5 * size - 1) < 0) || // Clip left
-     ((y + 8 * size - 1) < 0))   // Clip top
-    return;
+  drawText(x, y, &c, 1, textColor, bgColor, size);
+}
 
-  for (i=0; i<6; i++ ) {
-    if (i == 5)
-      line = 0x0;
-    else
-      line = Font[(c*5)+i];
-    for (j = 0; j<8; j++) {
-      if (line & 0x1) {
-        if (size == 1) // default size
-          ST7735_DrawPixel(x+i, y+j, textColor);
-        else {  // big size
-          ST7735_FillRect(x+(i*size), y+(j*size), size, size, textColor);
-        }
-      } else if (bgColor != textColor) {
-        if (size == 1) // default size
-          ST7735_DrawPixel(x+i, y+j, bgColor);
-        else {  // big size
-          ST7735_FillRect(x+i*size, y+j*size, size, size, bgColor);
-        }
-      }
-      line >>= 1;
-    }
-  }
+
+//------------ST7735_DrawText------------
+// Draw n characters side by side, 6*size pixels apart, in one
+// address window clipped to the screen.  The characters do not
+// have to be null terminated.  Same colors and size as
+// ST7735_DrawCharS(), transparent if textColor == bgColor.
+// Requires (11 + 2*n*size*size*6*8) bytes of transmission (text fully on screen; textcolor != bgColor)
+// Input: x         horizontal position of the top left corner of the first character
+//        y         vertical position of the top left corner of the first character
+//        pt        pointer to the first character
+//        n         number of characters
+//        textColor 16-bit color of the characters
+//        bgColor   16-bit color of the background
+//        size      number of pixels per character pixel
+// Output: none
+void ST7735_DrawText(int16_t x, int16_t y, const char *pt, uint32_t n, uint16_t textColor, uint16_t bgColor, uint8_t size){
+  drawText(x, y, pt, n, textColor, bgColor, size);
 }
 
 
@@ -1098,6 +1305,7 @@ void ST7735_DrawChar(int16_t x, int16_t y, char c, int16_t textColor, int16_t bg
 
   setAddrWindow(x, y, x+6*size-1, y+8*size-1);
 
+  startPixels();
   line = 0x01;        // print the top row first
   // print the rows, starting at the top
   for(row=0; row<8; row=row+1){
@@ -1107,18 +1315,18 @@ void ST7735_DrawChar(int16_t x, int16_t y, char c, int16_t textColor, int16_t bg
         if(Font[(c*5)+col]&line){
           // bit is set in Font, print pixel(s) in text color
           for(j=0; j<size; j=j+1){
-            pushColor(textColor);
+            writepixel(textColor);
           }
         } else{
           // bit is cleared in Font, print pixel(s) in background color
           for(j=0; j<size; j=j+1){
-            pushColor(bgColor);
+            writepixel(bgColor);
           }
         }
       }
       // print blank column(s) to the right of character
       for(j=0; j<size; j=j+1){
-        pushColor(bgColor);
+        writepixel(bgColor);
       }
     }
     line = line<<1;   // move up to the next row
@@ -1133,18 +1341,16 @@ void ST7735_DrawChar(int16_t x, int16_t y, char c, int16_t textColor, int16_t bg
 //        pt        pointer to a null terminated string to be printed
 //        textColor 16-bit color of the characters
 // bgColor is Black and size is 1
+// The whole string goes out in one address window
 // Output: number of characters printed
 uint32_t ST7735_DrawString(uint16_t x, uint16_t y, char *pt, int16_t textColor){
-  uint32_t count = 0;
+  uint32_t n = 0;
   if(y>15) return 0;
-  while(*pt){
-    ST7735_DrawCharS(x*6, y*10, *pt, textColor, ST7735_BLACK, 1);
-    pt++;
-    x = x+1;
-    if(x>20) return count;  // number of characters printed
-    count++;
-  }
-  return count;  // number of characters printed
+  while(pt[n] && ((x + n) <= 20)) n++;  // characters that fit on the line
+  if((n == 0) && *pt) n = 1;            // x past the last column, as before
+  drawText(x*6, y*10, pt, n, textColor, ST7735_BLACK, 1);
+  if(pt[n] || ((x + n) > 20)) return (x < 20) ? 20 - x : 0;  // stopped at the edge
+  return n;  // number of characters printed
 }
 
 //-----------------------fillmessage-----------------------
@@ -1272,6 +1478,110 @@ void ST7735_InvertDisplay(int i) {
     writecommand(ST7735_INVOFF);
   }
 }
+
+
+// A scroll line is a screen row in rotations 0 and 2 and a
+// screen column in rotations 1 and 3: the memory lines the
+// panel scans.  MY reverses the memory line order in rotations
+// 0 and 1, so screen lines run against memory lines there.
+int static scrollMirrored(void){
+  return Rotation <= 1;
+}
+
+
+//------------ST7735_SetScrollArea------------
+// Define the lines moved by hardware vertical scrolling
+// (VSCRDEF) and set the scroll start back to 0.  Lines before
+// and after the area stay fixed, so text can frame a chart.
+// Requires 10 bytes of transmission
+// Input: first first line of the area, rows (rotations 0 and 2)
+//              or columns (rotations 1 and 3) from the edge
+//        count number of lines in the area
+// Output: pixels across a line, 0 if the area does not fit
+uint32_t ST7735_SetScrollArea(uint8_t first, uint8_t count){
+  uint16_t bottom;
+
+  if((count == 0) || (first + count > ST7735_TFTHEIGHT)) return 0;
+  if(scrollMirrored()){
+    first = ST7735_TFTHEIGHT - first - count;
+  }
+  ScrollTop = first + RowStart;         // memory holds ST7735_TFTHEIGHT + 2*RowStart lines
+  ScrollCount = count;
+  bottom = ST7735_TFTHEIGHT + 2*RowStart - ScrollTop - ScrollCount;
+
+  writecommand(ST7735_VSCRDEF);
+  writedata(0x00);
+  writedata(ScrollTop);                 // TFA, fixed lines above
+  writedata(0x00);
+  writedata(ScrollCount);               // VSA, scrolled lines
+  writedata(bottom >> 8);
+  writedata(bottom);                    // BFA, fixed lines below
+  ST7735_SetScrollStart(0);
+  return (Rotation & 1) ? _height : _width;
+}
+
+
+//------------ST7735_SetScrollStart------------
+// Scroll the area of ST7735_SetScrollArea (VSCSAD): the line
+// drawn at first+offset shows at first, lines wrap around the
+// end of the area.  Only the start address changes, the
+// memory is not touched.
+// Requires 3 bytes of transmission
+// Input: offset lines the picture moves towards first, 0 to count-1
+// Output: none
+void ST7735_SetScrollStart(uint8_t offset){
+  uint16_t start;
+
+  if(ScrollCount == 0) return;
+  offset = offset%ScrollCount;
+  if(scrollMirrored() && offset){
+    offset = ScrollCount - offset;      // memory lines run the other way
+  }
+  start = ScrollTop + offset;
+  writecommand(ST7735_VSCSAD);
+  writedata(start >> 8);
+  writedata(start);
+}
+
+
+//------------ST7735_DrawLineRuns------------
+// Draw one scroll line, a screen row in rotations 0 and 2 or a
+// screen column in rotations 1 and 3, from runs of one color.
+// The line goes out in one address window, each run as color
+// repeated length times; runs past the end are cut and pixels
+// after the last run take its color.
+// Requires (11 + 2*128) bytes of transmission (160 pixels in rotations 1 and 3)
+// Input: line   row or column from the edge
+//        color  16-bit color of each run
+//        length pixels in each run, from the top or left edge
+//        runs   number of runs
+// Output: none
+void ST7735_DrawLineRuns(uint8_t line, const uint16_t *color, const uint8_t *length, uint32_t runs){
+  int32_t left, n;
+  uint32_t i;
+
+  if(runs == 0) return;
+  if(Rotation & 1){                     // a column
+    if(line >= _width) return;
+    left = _height;
+    setAddrWindow(line, 0, line, _height-1);
+  } else{                               // a row
+    if(line >= _height) return;
+    left = _width;
+    setAddrWindow(0, line, _width-1, line);
+  }
+  startPixels();
+  for(i=0; (i<runs) && (left>0); i=i+1){
+    for(n=length[i]; (n>0) && (left>0); n=n-1){
+      writepixel(color[i]);
+      left = left-1;
+    }
+  }
+  while(left > 0){
+    writepixel(color[runs-1]);
+    left = left-1;
+  }
+}
 // graphics routines
 // y coordinates 0 to 31 used for labels and messages
 // y coordinates 32 to 159  128 pixels high
@@ -1546,12 +1856,27 @@ void ST7735_OutChar(char ch){
 // Position determined by ST7735_SetCursor command
 // Color set by ST7735_SetTextColor
 // The string will not automatically wrap.
+// Each run of characters up to a newline or the end of the
+// line goes out in one address window.
 // inputs: ptr  pointer to NULL-terminated ASCII string
 // outputs: none
 void ST7735_OutString(char *ptr){
+  uint32_t n;
   while(*ptr){
-    ST7735_OutChar(*ptr);
-    ptr = ptr + 1;
+    n = 0;
+    while(ptr[n] && (ptr[n] != 10) && (ptr[n] != 13) && (ptr[n] != 27) && ((StX + n) <= 20)) n++;
+    if(n == 0){                         // newline, or the cursor is in the last column
+      ST7735_OutChar(*ptr);
+      ptr = ptr + 1;
+      continue;
+    }
+    drawText(StX*6, StY*10, ptr, n, ST7735_YELLOW, ST7735_BLACK, 1);
+    StX = StX + n;
+    ptr = ptr + n;
+    if(StX>20){
+      StX = 20;
+      ST7735_DrawCharS(StX*6,StY*10,'*',ST7735_RED,ST7735_BLACK, 1);
+    }
   }
 }
 // ************** ST7735_SetTextColor ************************
@@ -1564,6 +1889,7 @@ void ST7735_SetTextColor(uint16_t color){
   StTextColor = color;
 }
 // Print a character to ST7735 LCD.
+#ifndef ST7735_HOST                        // host builds keep the C library stdio
 int fputc(int ch, FILE *f){
   ST7735_OutChar(ch);
   return 1;
@@ -1572,6 +1898,7 @@ int fputc(int ch, FILE *f){
 int fgetc (FILE *f){
   return 0;
 }
+#endif
 
 
 // Function called when file error occurs.
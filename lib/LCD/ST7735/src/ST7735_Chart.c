@@ -0,0 +1,149 @@
+/*!
+ * @file  ST7735_Chart.c
+ * @brief Scrolling strip chart on the ST7735, one line write per sample.
+ * ----------
+ * The lines of the chart are used as a ring: head is the oldest line, the
+ * next sample goes there and the scroll start moves past it, which puts it
+ * at the end of the chart on screen. A sample costs one ST7735_DrawLineRuns
+ * and one ST7735_SetScrollStart, whatever the number of traces.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include "ST7735.h"
+#include "ST7735_Chart.h"
+
+#define MAX_RUNS  (2 * ST7735_CHART_TRACES + 1)  // each trace splits at most one run in three
+
+static const uint16_t colors[ST7735_CHART_TRACES] = {
+    ST7735_YELLOW, ST7735_CYAN, ST7735_MAGENTA, ST7735_GREEN
+};
+
+static struct {
+    uint8_t  first;                     // first line on screen
+    uint8_t  count;                     // lines of history
+    uint8_t  head;                      // oldest line, drawn next
+    uint32_t length;                    // pixels across a line
+    int32_t  min, max;
+    uint16_t bgColor;
+    int16_t  last[ST7735_CHART_TRACES]; // position of the previous sample, -1 for none
+} chart;
+
+/**
+ * position
+ * ----------
+ * Description: pixel of a value across the line, clamped to the line.
+ */
+static int16_t position(int32_t value) {
+    int64_t pos = ((int64_t)value - chart.min) * (chart.length - 1) / ((int64_t)chart.max - chart.min);
+
+    if (pos < 0) return 0;
+    if (pos > chart.length - 1) return chart.length - 1;
+    return pos;
+}
+
+/**
+ * ST7735_Chart_Init
+ * ----------
+ * @param  first    first line of the chart, rows or columns from the edge.
+ * @param  count    lines of history.
+ * @param  min      value at the start (left or top) of a line.
+ * @param  max      value at the end of a line, below min to flip the axis.
+ * @param  bgColor  background of the chart.
+ * ----------
+ * @return 1 on success, 0 if the lines do not fit on the screen.
+ */
+int ST7735_Chart_Init(uint8_t first, uint8_t count, int32_t min, int32_t max, uint16_t bgColor) {
+    uint8_t length = 0xFF;
+
+    chart.length = ST7735_SetScrollArea(first, count);
+    if (chart.length == 0) return 0;
+
+    chart.first = first;
+    chart.count = count;
+    chart.head = 0;
+    chart.min = min;
+    chart.max = max == min ? min + 1 : max;
+    chart.bgColor = bgColor;
+    for (int i = 0; i < ST7735_CHART_TRACES; i++) chart.last[i] = -1;
+
+    for (uint8_t line = first; line < first + count; line++) ST7735_DrawLineRuns(line, &bgColor, &length, 1);
+
+    return 1;
+}
+
+/**
+ * ST7735_Chart_getColor
+ * ----------
+ * @param  trace  0 to ST7735_CHART_TRACES - 1.
+ * ----------
+ * @return color of the trace, for a legend.
+ */
+uint16_t ST7735_Chart_getColor(uint8_t trace) {
+    return colors[trace % ST7735_CHART_TRACES];
+}
+
+/**
+ * ST7735_Chart_plot
+ * ----------
+ * @param  values  one value per trace, ST7735_CHART_GAP for none.
+ * @param  traces  number of values, at most ST7735_CHART_TRACES.
+ * ----------
+ * @return runs of color the line took.
+ */
+uint32_t ST7735_Chart_plot(const int32_t* values, uint8_t traces) {
+    int16_t  start[ST7735_CHART_TRACES], end[ST7735_CHART_TRACES];
+    uint16_t runColor[MAX_RUNS];
+    uint8_t  runLength[MAX_RUNS];
+    uint32_t runs = 0;
+
+    if (chart.count == 0) return 0;
+    if (traces > ST7735_CHART_TRACES) traces = ST7735_CHART_TRACES;
+
+    /*-- span of each trace on this line, from its previous sample to this one --*/
+    for (int i = 0; i < traces; i++) {
+        int16_t pos;
+
+        if (values[i] == ST7735_CHART_GAP) {
+            start[i] = end[i] = -1;
+            chart.last[i] = -1;
+            continue;
+        }
+        pos = position(values[i]);
+        start[i] = chart.last[i] >= 0 && chart.last[i] < pos ? chart.last[i] : pos;
+        end[i] = chart.last[i] > pos ? chart.last[i] : pos;
+        end[i] += ST7735_CHART_THICKNESS - 1;
+        if (end[i] > (int32_t)chart.length - 1) end[i] = chart.length - 1;
+        chart.last[i] = pos;
+    }
+
+    /*-- run-length encode the line, later traces on top --*/
+    for (uint32_t p = 0; p < chart.length; p++) {
+        uint16_t color = chart.bgColor;
+
+        for (int i = 0; i < traces; i++) {
+            if (start[i] <= (int16_t)p && (int16_t)p <= end[i]) color = colors[i];
+        }
+        if (runs > 0 && runColor[runs - 1] == color) {
+            runLength[runs - 1]++;
+        } else {
+            runColor[runs] = color;
+            runLength[runs] = 1;
+            runs++;
+        }
+    }
+
+    ST7735_DrawLineRuns(chart.first + chart.head, runColor, runLength, runs);
+    chart.head = (chart.head + 1) % chart.count;
+    ST7735_SetScrollStart(chart.head);          // the line just drawn moves to the end
+
+    return runs;
+}
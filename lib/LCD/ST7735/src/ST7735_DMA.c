@@ -0,0 +1,252 @@
+/*!
+ * @file  ST7735_DMA.c
+ * @brief uDMA transfers from memory to SSI0 for the ST7735 pixel stream.
+ * ----------
+ * A job is a number of rows of pixels; each row goes out in basic mode
+ * transfers of at most ST7735_DMA_MAX_ITEMS, and SSI0_Handler starts the
+ * next one when uDMA reports the last done. SSI0 is switched to 16-bit frames
+ * for the job, so each 16-bit item is one pixel, high byte first, and back
+ * to 8-bit frames by ST7735_DMA_wait before the next command.
+ * ----------
+ * Host builds (ST7735_HOST) run against the register block of ST7735_sim.h.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include "ST7735_DMA.h"
+#ifdef ST7735_HOST
+#include "ST7735_sim.h"
+#else
+#include "tm4c123gh6pm.h"
+#endif
+
+#define CHANNEL_BIT   (1 << ST7735_DMA_CHANNEL)
+
+/* channel control table, must be 1024 byte aligned; only primary entries are used */
+#if defined(__GNUC__)
+static ST7735_DMA_Entry table[32] __attribute__((aligned(1024)));
+#else
+__align(1024) static ST7735_DMA_Entry table[32];
+#endif
+
+static struct {
+    const uint16_t*     rowStart;       // first pixel of the current row
+    const uint16_t*     src;            // next pixel to send
+    uint32_t            rowLeft;        // pixels of the current row not started yet
+    uint32_t            width;
+    uint32_t            rows;           // rows after the current one
+    int32_t             stride;
+    uint32_t            srcInc;         // UDMA_CHCTL_SRCINC_16, or _NONE for fills
+    ST7735_DMA_Callback done;
+} job;
+
+static volatile uint8_t busy = 0;
+static uint8_t          frames16 = 0;   // SSI0 in 16-bit frames
+static uint16_t         fillColor;      // source word of fills
+static uint32_t         chunks = 0;
+
+/**
+ * ST7735_DMA_setFrames16
+ * ----------
+ * @param  on  1 for 16-bit frames, 0 for 8-bit frames.
+ * ----------
+ * @brief  Switch SSI0 frame size once the last frame is out.
+ */
+void ST7735_DMA_setFrames16(uint8_t on) {
+    if (frames16 == on) return;
+    while ((SSI0_SR_R & SSI_SR_BSY) != 0) {};           // last frame out, data size can only change while idle
+    SSI0_CR1_R &= ~SSI_CR1_SSE;
+    SSI0_CR0_R = (SSI0_CR0_R & ~SSI_CR0_DSS_M) + (on ? SSI_CR0_DSS_16 : SSI_CR0_DSS_8);
+    SSI0_CR1_R |= SSI_CR1_SSE;
+    frames16 = on;
+}
+
+/**
+ * startChunk
+ * ----------
+ * Description: program the next transfer of the current row and enable the channel.
+ */
+static void startChunk(void) {
+    ST7735_DMA_Entry* entry = &table[ST7735_DMA_CHANNEL];
+    uint32_t          count = job.rowLeft > ST7735_DMA_MAX_ITEMS ? ST7735_DMA_MAX_ITEMS : job.rowLeft;
+
+    // uDMA takes end addresses: the last item read, the FIFO written every time
+    entry->srcEnd = (uintptr_t)(job.srcInc == UDMA_CHCTL_SRCINC_NONE ? job.src : job.src + count - 1);
+    entry->dstEnd = (uintptr_t)&SSI0_DR_R;
+    entry->control = UDMA_CHCTL_DSTINC_NONE | UDMA_CHCTL_DSTSIZE_16 |
+                     job.srcInc             | UDMA_CHCTL_SRCSIZE_16 |
+                     UDMA_CHCTL_ARBSIZE_4   |                           // half of the 8 deep TX FIFO
+                     ((count - 1) << UDMA_CHCTL_XFERSIZE_S) |
+                     UDMA_CHCTL_XFERMODE_BASIC;
+
+    if (job.srcInc != UDMA_CHCTL_SRCINC_NONE) job.src += count;
+    job.rowLeft -= count;
+    chunks++;
+
+    UDMA_ENASET_R = CHANNEL_BIT;
+}
+
+/**
+ * startJob
+ * ----------
+ * Description: send the first chunk of the job set up in job.
+ */
+static void startJob(void) {
+    if (job.rowLeft == 0) {                             // nothing to send
+        if (job.done) job.done();
+        return;
+    }
+    ST7735_DMA_setFrames16(1);
+    busy = 1;
+    startChunk();
+}
+
+/**
+ * waitJob
+ * ----------
+ * Description: wait until SSI0_Handler has ended the current job. The channel
+ *              enable is polled while waiting, on the host that read lets the
+ *              fake controller run the transfer.
+ */
+static void waitJob(void) {
+    while (busy) {
+        (void)UDMA_ENASET_R;
+    }
+}
+
+/**
+ * ST7735_DMA_Init
+ * ----------
+ * @brief  Turn on uDMA, map channel 11 to SSI0 TX and enable the SSI0
+ *         interrupt that signals the end of each transfer.
+ */
+void ST7735_DMA_Init(void) {
+    SYSCTL_RCGCDMA_R |= SYSCTL_RCGCDMA_R0;              // activate uDMA
+    while ((SYSCTL_PRDMA_R & SYSCTL_PRDMA_R0) == 0) {}; // allow time for clock to start
+
+    UDMA_CFG_R = UDMA_CFG_MASTEN;                       // enable uDMA
+    UDMA_CTLBASE_R = (uintptr_t)table;
+    UDMA_CHMAP1_R &= ~UDMA_CHMAP1_CH11SEL_M;            // channel 11 is SSI0 TX
+    UDMA_PRIOCLR_R = CHANNEL_BIT;                       // default priority
+    UDMA_ALTCLR_R = CHANNEL_BIT;                        // primary control entry
+    UDMA_USEBURSTCLR_R = CHANNEL_BIT;                   // single and burst requests
+    UDMA_REQMASKCLR_R = CHANNEL_BIT;                    // take requests from SSI0
+
+    SSI0_DMACTL_R |= SSI_DMACTL_TXDMAE;                 // SSI0 asks for data when the TX FIFO is half empty
+
+    NVIC_PRI1_R = (NVIC_PRI1_R & 0x00FFFFFF) | 0xE0000000; // SSI0 (IRQ 7) priority 7
+    NVIC_EN0_R = 1 << 7;                                // enable IRQ 7 in NVIC
+
+    busy = 0;
+    frames16 = 0;                                       // ST7735.c sets SSI0 up in 8-bit frames
+    chunks = 0;
+}
+
+/**
+ * ST7735_DMA_fill
+ * ----------
+ * @param  color  16-bit color sent for every pixel.
+ * @param  count  number of pixels.
+ * @param  done   called from the SSI0 interrupt once every pixel is queued, 0 for none.
+ * ----------
+ * @brief  Start sending one color count times. Waits for the previous job first.
+ */
+void ST7735_DMA_fill(uint16_t color, uint32_t count, ST7735_DMA_Callback done) {
+    waitJob();
+
+    fillColor = color;
+    job.rowStart = job.src = &fillColor;
+    job.rowLeft = job.width = count;
+    job.rows = 0;
+    job.stride = 0;
+    job.srcInc = UDMA_CHCTL_SRCINC_NONE;
+    job.done = done;
+
+    startJob();
+}
+
+/**
+ * ST7735_DMA_copy
+ * ----------
+ * @param  image   first pixel of the first row sent.
+ * @param  width   pixels per row.
+ * @param  rows    number of rows.
+ * @param  stride  pixels from the first pixel of one row to the first of the next, negative for bottom-up images.
+ * @param  done    called from the SSI0 interrupt once every pixel is queued, 0 for none.
+ * ----------
+ * @brief  Start sending an image, a row per transfer. Waits for the previous job first.
+ */
+void ST7735_DMA_copy(const uint16_t* image, uint16_t width, uint16_t rows, int32_t stride, ST7735_DMA_Callback done) {
+    waitJob();
+
+    job.rowStart = job.src = image;
+    job.rowLeft = job.width = rows ? width : 0;
+    job.rows = rows ? rows - 1 : 0;
+    job.stride = stride;
+    job.srcInc = UDMA_CHCTL_SRCINC_16;
+    job.done = done;
+
+    startJob();
+}
+
+/**
+ * ST7735_DMA_busy
+ * ----------
+ * @return 1 while a job still has pixels to hand to SSI0, 0 otherwise.
+ */
+int ST7735_DMA_busy(void) {
+    return busy;
+}
+
+/**
+ * ST7735_DMA_wait
+ * ----------
+ * @brief  Wait for the job and the SSI0 FIFO to finish and put SSI0 back in
+ *         8-bit frames, so commands can follow.
+ */
+void ST7735_DMA_wait(void) {
+    waitJob();
+    ST7735_DMA_setFrames16(0);
+}
+
+/**
+ * ST7735_DMA_getChunks
+ * ----------
+ * @return uDMA transfers started since ST7735_DMA_Init.
+ */
+uint32_t ST7735_DMA_getChunks(void) {
+    return chunks;
+}
+
+/**
+ * SSI0_Handler
+ * ----------
+ * @brief  uDMA completion on channel 11, starts the next chunk or ends the job.
+ */
+void SSI0_Handler(void) {
+    if ((UDMA_CHIS_R & CHANNEL_BIT) == 0) return;
+    UDMA_CHIS_R = CHANNEL_BIT;                          // acknowledge
+
+    if (job.rowLeft == 0 && job.rows != 0) {            // next row
+        job.rowStart += job.stride;
+        job.src = job.rowStart;
+        job.rowLeft = job.width;
+        job.rows--;
+    }
+
+    if (job.rowLeft != 0) {
+        startChunk();
+        return;
+    }
+
+    busy = 0;
+    if (job.done) job.done();
+}
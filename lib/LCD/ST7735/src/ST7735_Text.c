@@ -0,0 +1,213 @@
+/*!
+ * @file  ST7735_Text.c
+ * @brief Retained text cells for the ST7735, only changed cells go on the link.
+ * ----------
+ * Two grids of cells: cells is what the program printed, screen what the
+ * ST7735 shows. Only ST7735_Text_flush touches the link, so reprinting a
+ * line with the same text, or blanking a row and filling it again before
+ * the flush, costs nothing.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include "ST7735.h"
+#include "ST7735_Text.h"
+
+#define CELL_WIDTH   6
+#define CELL_HEIGHT  10
+
+typedef struct {
+    char     ch;
+    uint16_t textColor;
+    uint16_t bgColor;
+} Cell;
+
+static Cell     cells[ST7735_TEXT_ROWS][ST7735_TEXT_COLUMNS];   // printed, not flushed yet
+static Cell     screen[ST7735_TEXT_ROWS][ST7735_TEXT_COLUMNS];  // on the ST7735
+static uint32_t cursorX = 0, cursorY = 0;
+static uint16_t textColor = ST7735_YELLOW;
+static uint16_t bgColor = ST7735_BLACK;
+
+/**
+ * setCell
+ * ----------
+ * Description: write one cell of the back buffer, text in the background color is a blank.
+ */
+static void setCell(uint32_t x, uint32_t y, char ch, uint16_t text, uint16_t bg) {
+    Cell* cell = &cells[y][x];
+
+    cell->ch = text == bg ? ' ' : ch;
+    cell->textColor = text;
+    cell->bgColor = bg;
+}
+
+/**
+ * blankRow
+ * ----------
+ * Description: fill a row of the back buffer with spaces in the current background.
+ */
+static void blankRow(uint32_t y) {
+    for (uint32_t x = 0; x < ST7735_TEXT_COLUMNS; x++) setCell(x, y, ' ', textColor, bgColor);
+}
+
+/**
+ * sameCell
+ * ----------
+ * Description: 1 if two cells put the same pixels on screen.
+ */
+static int sameCell(const Cell* a, const Cell* b) {
+    if (a->bgColor != b->bgColor) return 0;
+    if (a->ch == ' ' && b->ch == ' ') return 1;         // blank whatever the text color
+    return a->ch == b->ch && a->textColor == b->textColor;
+}
+
+/**
+ * ST7735_Text_Init
+ * ----------
+ * @param  text  color of the characters printed from now on.
+ * @param  bg    color of the screen, which must already be cleared to it.
+ * ----------
+ * @brief  Start with every cell blank on screen and in the back buffer,
+ *         cursor at (0, 0).
+ */
+void ST7735_Text_Init(uint16_t text, uint16_t bg) {
+    textColor = text;
+    bgColor = bg;
+    ST7735_Text_clear();
+    for (uint32_t y = 0; y < ST7735_TEXT_ROWS; y++) {
+        for (uint32_t x = 0; x < ST7735_TEXT_COLUMNS; x++) screen[y][x] = cells[y][x];
+    }
+}
+
+/**
+ * ST7735_Text_clear
+ * ----------
+ * @brief  Blank every cell and home the cursor, sent at the next flush.
+ */
+void ST7735_Text_clear(void) {
+    for (uint32_t y = 0; y < ST7735_TEXT_ROWS; y++) blankRow(y);
+    cursorX = 0;
+    cursorY = 0;
+}
+
+/**
+ * ST7735_Text_setCursor
+ * ----------
+ * @param  x  column, 0 to 20.
+ * @param  y  row, 0 to 15.
+ */
+void ST7735_Text_setCursor(uint32_t x, uint32_t y) {
+    if (x >= ST7735_TEXT_COLUMNS || y >= ST7735_TEXT_ROWS) return;
+    cursorX = x;
+    cursorY = y;
+}
+
+/**
+ * ST7735_Text_setColor
+ * ----------
+ * @param  text  color of the characters printed from now on.
+ * @param  bg    color of their cells.
+ */
+void ST7735_Text_setColor(uint16_t text, uint16_t bg) {
+    textColor = text;
+    bgColor = bg;
+}
+
+/**
+ * ST7735_Text_putChar
+ * ----------
+ * @param  ch  character, newline (10, 13 or 27) goes to the start of the
+ *             next row and blanks it.
+ */
+void ST7735_Text_putChar(char ch) {
+    if (ch == 10 || ch == 13 || ch == 27) {
+        cursorX = 0;
+        if (++cursorY >= ST7735_TEXT_ROWS) cursorY = 0;
+        blankRow(cursorY);
+        return;
+    }
+
+    setCell(cursorX, cursorY, ch, textColor, bgColor);
+    cursorX++;
+    if (cursorX >= ST7735_TEXT_COLUMNS) {               // no wrap, mark the overflow like ST7735_OutChar
+        cursorX = ST7735_TEXT_COLUMNS - 1;
+        setCell(cursorX, cursorY, '*', ST7735_RED, bgColor);
+    }
+}
+
+/**
+ * ST7735_Text_putString
+ * ----------
+ * @param  pt  null terminated string.
+ */
+void ST7735_Text_putString(const char* pt) {
+    while (*pt) ST7735_Text_putChar(*pt++);
+}
+
+/**
+ * ST7735_Text_putUDec
+ * ----------
+ * @param  n  unsigned number printed in decimal, no padding.
+ */
+void ST7735_Text_putUDec(uint32_t n) {
+    char digits[10];
+    int  count = 0;
+
+    do {
+        digits[count++] = '0' + n % 10;
+        n /= 10;
+    } while (n);
+    while (count) ST7735_Text_putChar(digits[--count]);
+}
+
+/**
+ * ST7735_Text_flush
+ * ----------
+ * @return number of cells sent.
+ * ----------
+ * @brief  Send the cells that differ from the screen, one window per run of
+ *         adjacent changed cells of the same colors.
+ */
+uint32_t ST7735_Text_flush(void) {
+    char     run[ST7735_TEXT_COLUMNS];
+    uint32_t sent = 0;
+
+    for (uint32_t y = 0; y < ST7735_TEXT_ROWS; y++) {
+        uint32_t x = 0;
+
+        while (x < ST7735_TEXT_COLUMNS) {
+            Cell*    first = &cells[y][x];
+            uint32_t start = x, n = 0;
+
+            if (sameCell(first, &screen[y][x])) {
+                x++;
+                continue;
+            }
+
+            // extend over changed cells drawn with the same colors
+            while (x < ST7735_TEXT_COLUMNS && !sameCell(&cells[y][x], &screen[y][x]) &&
+                   cells[y][x].bgColor == first->bgColor &&
+                   (cells[y][x].textColor == first->textColor || cells[y][x].ch == ' ')) {
+                run[n++] = cells[y][x].ch;
+                screen[y][x] = cells[y][x];
+                x++;
+            }
+
+            // only blanks have the text color of the background, which would draw transparent
+            ST7735_DrawText(start * CELL_WIDTH, y * CELL_HEIGHT, run, n,
+                            first->textColor == first->bgColor ? (uint16_t)~first->bgColor : first->textColor,
+                            first->bgColor, 1);
+            sent += n;
+        }
+    }
+
+    return sent;
+}
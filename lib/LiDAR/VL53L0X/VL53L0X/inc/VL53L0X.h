@@ -19,6 +19,7 @@
 #define __VL53L0X_H__
 
 #include "vl53l0x_api.h"
+#include "Timebase.h"
 
 #define VERSION_REQUIRED_MAJOR  1   // Required sensor major version
 #define VERSION_REQUIRED_MINOR  0   // Required sensor minor version
@@ -29,12 +30,35 @@
 #define DISABLE           0
 #define ENABLE            1
 #define VL53L0X_I2C_ADDR  0x29          // Default sensor I2C address
+#define VL53L0X_I2C_SPEED 400           // Default I2C clock in kHz, fastest VL53L0X supports
+#define VL53L0X_MAX_SENSORS 10          // Size of deviceList
+#define VL53L0X_LATENCY_BINS 64         // 1 ms wide latency bins, the last one takes everything longer
+#define VL53L0X_RECORD_TICK_US 16       // unit of VL53L0X_Record.delta, 16 bits of it span about 1 s
+
+typedef struct {
+    uint32_t count;                     // measurements recorded
+    uint32_t minUs;                     // MeasurementTimeUsec extremes and sum
+    uint32_t maxUs;
+    uint64_t sumUs;
+    uint16_t bins[VL53L0X_LATENCY_BINS];    // histogram, saturates at 65535
+} VL53L0X_Latency;
+
+typedef struct {
+    uint16_t rangeMilliMeter;           // RangeMilliMeter
+    uint16_t signalRate;                // SignalRateRtnMegaCps in 8.8, saturates at 0xFFFF
+    uint8_t  status;                    // RangeStatus
+    uint8_t  sensor;                    // index to deviceList
+    uint16_t delta;                     // data ready time since the previous record, in VL53L0X_RECORD_TICK_US, saturates
+} VL53L0X_Record;                       // 8 bytes, packed form of VL53L0X_RangingMeasurementData_t for burst capture
 
 typedef struct {
     VL53L0X_Dev_t device;               // stores VL53L0X device data
     VL53L0X_DeviceInfo_t deviceInfo;    // stores VL53L0X device info
+    VL53L0X_Latency latency;            // start to data ready time of the measurements read
 } VL53L0X;
 
+extern VL53L0X deviceList[VL53L0X_MAX_SENSORS];
+
 /*
  *  I2C0 Conncection | I2C1 Conncection | I2C2 Conncection | I2C3 Conncection
  *  ---------------- | ---------------- | ---------------- | ----------------
@@ -49,7 +73,9 @@ typedef struct {
  * ----------
  * @return 0 for failed initialization, 1 for successful initialization.
  * ----------
- * @brief  Initialize VL53L0X.
+ * @brief  Initialize VL53L0X on the I2C module set by VL53L0X_setBus, I2C0 by
+ *         default. The I2C clock is taken from device.comms_speed_khz,
+ *         VL53L0X_I2C_SPEED is used if it is left 0.
  */
 int VL53L0X_Init(int index);
 
@@ -64,6 +90,17 @@ int VL53L0X_Init(int index);
  */
 int VL53L0X_SingleRanging_Init (int index);
 
+/**
+ * VL53L0X_ContinuousRanging_Init
+ * ----------
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return 0 for failed initialization, 1 for successful initialization.
+ * ----------
+ * @brief  Initialize VL53L0X for continuous ranging mode.
+ */
+int VL53L0X_ContinuousRanging_Init (int index);
+
 /**
  * VL53L0X_setAddress
  * ----------
@@ -75,6 +112,77 @@ int VL53L0X_SingleRanging_Init (int index);
  */
 int VL53L0X_setAddress(uint8_t newAddress, int index);
 
+/**
+ * VL53L0X_setBus
+ * ----------
+ * @param  bus    I2C module (0 to 3) the VL53L0X is wired to.
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return 0 for invalid module, 1 for success.
+ * ----------
+ * @brief  Select the I2C module of VL53L0X, call before VL53L0X_Init.
+ */
+int VL53L0X_setBus(uint8_t bus, int index);
+
+/**
+ * VL53L0X_setShadow
+ * ----------
+ * @param  enable  ENABLE to keep a shadow of page select and stable registers, DISABLE otherwise.
+ * @param  index   Index to the specified sensor.
+ * ----------
+ * @brief  Turn the register shadow of VL53L0X on or off. With the shadow on,
+ *         writes that would not change a register are dropped and
+ *         read-modify-write is served without a read.
+ */
+void VL53L0X_setShadow(uint8_t enable, int index);
+
+/**
+ * VL53L0X_getShadowCounters
+ * ----------
+ * @param  hits    where to store the number of reads served from the shadow.
+ * @param  elided  where to store the number of I2C transactions dropped.
+ * @param  index   Index to the specified sensor.
+ * ----------
+ * @brief  Read the register shadow counters of VL53L0X.
+ */
+void VL53L0X_getShadowCounters(uint32_t* hits, uint32_t* elided, int index);
+
+/**
+ * VL53L0X_getLatency
+ * ----------
+ * @param  minUs  where to store the shortest measurement time.
+ * @param  avgUs  where to store the average measurement time.
+ * @param  p99Us  where to store the 99th percentile, to the next 1 ms bin edge.
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return number of measurements recorded, the times are 0 if there are none.
+ * ----------
+ * @brief  Read the start to data ready time statistics of VL53L0X, taken from
+ *         MeasurementTimeUsec of every measurement read through this driver.
+ */
+uint32_t VL53L0X_getLatency(uint32_t* minUs, uint32_t* avgUs, uint32_t* p99Us, int index);
+
+/**
+ * VL53L0X_resetLatency
+ * ----------
+ * @param  index  Index to the specified sensor.
+ */
+void VL53L0X_resetLatency(int index);
+
+/**
+ * VL53L0X_setGpio1Interrupt
+ * ----------
+ * @param  readyFlag  flag set by the GPIO1 edge interrupt, see gpio1_getFlag. 0 to go back to polling.
+ * @param  index      Index to the specified sensor.
+ * ----------
+ * @return 0 for failed setup, 1 for successful setup.
+ * ----------
+ * @brief  Signal new samples on GPIO1 and take measurement completion from
+ *         readyFlag instead of polling VL53L0X over I2C. Call after the
+ *         ranging mode is initialized.
+ */
+int VL53L0X_setGpio1Interrupt(volatile uint8_t* readyFlag, int index);
+
 /**
  * VL53L0X_getSingleRangingMeasurement
  * ----------
@@ -86,6 +194,130 @@ int VL53L0X_setAddress(uint8_t newAddress, int index);
  */
 VL53L0X_Error VL53L0X_getSingleRangingMeasurement (VL53L0X_RangingMeasurementData_t *RangingMeasurementData, int index);
 
+/**
+ * VL53L0X_getSingleRangingMeasurementFast
+ * ----------
+ * @param  RangingMeasurementData  pointer for where to store the ranging data.
+ * ----------
+ * @return any error code.
+ * ----------
+ * @brief  Get a ranging measurement from VL53L0X with VL53L0X_PerformSingleRangingFast:
+ *         setup happens on the first call only, and the timing budget is
+ *         slept through instead of polled.
+ */
+VL53L0X_Error VL53L0X_getSingleRangingMeasurementFast (VL53L0X_RangingMeasurementData_t* RangingMeasurementData, int index);
+
+/**
+ * VL53L0X_setDecodeLevel
+ * ----------
+ * @param  level  VL53L0X_RANGEDECODELEVEL_RAW, _LITE or _FULL (default).
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return any error code.
+ * ----------
+ * @brief  Choose how much of the range status is decoded per sample. RAW and
+ *         LITE skip the page 1 signal ref read and the sigma estimate, so
+ *         they cost no I2C beyond the result registers. Call after VL53L0X_Init.
+ */
+VL53L0X_Error VL53L0X_setDecodeLevel (VL53L0X_RangeDecodeLevel level, int index);
+
+/**
+ * VL53L0X_startRanging
+ * ----------
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return any error code.
+ * ----------
+ * @brief  Start a single ranging measurement and return right away, so
+ *         several sensors can range at the same time.
+ */
+VL53L0X_Error VL53L0X_startRanging(int index);
+
+/**
+ * VL53L0X_isRangingReady
+ * ----------
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return 1 when the measurement started by VL53L0X_startRanging is done,
+ *         0 otherwise. A sensor that fails to answer counts as done, so
+ *         VL53L0X_fetchRanging can report the error.
+ */
+int VL53L0X_isRangingReady(int index);
+
+/**
+ * VL53L0X_fetchRanging
+ * ----------
+ * @param  index                   Index to the specified sensor.
+ * @param  RangingMeasurementData  pointer for where to store the ranging data.
+ * ----------
+ * @return any error code.
+ * ----------
+ * @brief  Read the finished measurement and get the sensor ready for the next one.
+ *         Works for single and continuous ranging.
+ */
+VL53L0X_Error VL53L0X_fetchRanging(int index, VL53L0X_RangingMeasurementData_t* RangingMeasurementData);
+
+/****************************************************
+ *                                                  *
+ *                   Record Ring                    *
+ *                                                  *
+ ****************************************************/
+
+/*
+ *  Single producer, single consumer: the ranging path (ISR or scheduler)
+ *  pushes, the main loop pops. Neither side needs to disable interrupts.
+ */
+
+/**
+ * VL53L0X_Ring_Init
+ * ----------
+ * @param  buffer  storage for the records, 1024 records take 8 KB.
+ * @param  size    number of records in buffer, a power of two.
+ * ----------
+ * @return 0 for invalid size, 1 for success.
+ * ----------
+ * @brief  Set up the record ring, empty. Call before the producer starts.
+ */
+int VL53L0X_Ring_Init(VL53L0X_Record* buffer, uint32_t size);
+
+/**
+ * VL53L0X_Ring_push
+ * ----------
+ * @param  RangingMeasurementData  measurement to pack into a record.
+ * @param  index                   Index to the specified sensor.
+ * ----------
+ * @return 1 if stored, 0 if the ring is full or not set up.
+ * ----------
+ * @brief  Producer side. A full ring drops the record and counts it, the
+ *         delta of the next record still covers the time of the dropped one.
+ */
+int VL53L0X_Ring_push(const VL53L0X_RangingMeasurementData_t* RangingMeasurementData, int index);
+
+/**
+ * VL53L0X_Ring_pop
+ * ----------
+ * @param  record  where to store the oldest record.
+ * ----------
+ * @return 1 if a record was taken, 0 if the ring is empty.
+ * ----------
+ * @brief  Consumer side.
+ */
+int VL53L0X_Ring_pop(VL53L0X_Record* record);
+
+/**
+ * VL53L0X_Ring_count
+ * ----------
+ * @return number of records waiting in the ring.
+ */
+uint32_t VL53L0X_Ring_count(void);
+
+/**
+ * VL53L0X_Ring_getDropped
+ * ----------
+ * @return number of records dropped on a full ring since VL53L0X_Ring_Init.
+ */
+uint32_t VL53L0X_Ring_getDropped(void);
+
 /****************************************************
  *                                                  *
  *                 Helper Functions                 *
@@ -95,11 +327,10 @@ VL53L0X_Error VL53L0X_getSingleRangingMeasurement (VL53L0X_RangingMeasurementDat
 /**
  * delay
  * ----------
- * Description: delay N time unit
+ * Description: sleep N milliseconds.
  */
-static void delay(uint32_t N) {
-    for(int n = 0; n < N; n++)                         // N time unitss
-        for(int msec = 10000; msec > 0; msec--);       // 1 time unit
+static inline void delay(uint32_t N) {
+    Timebase_sleepUs(N * 1000);
 }
 
 #endif
@@ -25,9 +25,21 @@
 /**
  * VL53L0X_I2C_Init
  * ----------
+ * @param  bus  I2C module (0 to 3) VL53L0X is wired to.
+ * ----------
  * @brief initialize I2C with corresponding setting parameters.
  */
-void VL53L0X_I2C_Init(void);
+void VL53L0X_I2C_Init(uint8_t bus);
+
+/**
+ * VL53L0X_I2C_setSpeed
+ * ----------
+ * @param  bus       I2C module (0 to 3) VL53L0X is wired to.
+ * @param  speedKHz  SCL clock in kHz, VL53L0X runs up to 400 kHz.
+ * ----------
+ * @brief change I2C clock used to talk to VL53L0X.
+ */
+void VL53L0X_I2C_setSpeed(uint8_t bus, uint16_t speedKHz);
 
 /****************************************************
  *                                                  *
@@ -38,6 +50,7 @@ void VL53L0X_I2C_Init(void);
 /**
  * VL53L0X_read_multi
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  pdata          data address to store read data.
@@ -45,11 +58,12 @@ void VL53L0X_I2C_Init(void);
  * ----------
  * @brief read 1 or more bytes from VL53L0X.
  */
-int VL53L0X_read_multi(uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uint32_t count);
+int VL53L0X_read_multi(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uint32_t count);
 
 /**
  * VL53L0X_write_byte
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  pdata          data address of data to be writen.
@@ -57,72 +71,90 @@ int VL53L0X_read_multi(uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uin
  * ----------
  * @brief write 1 or more bytes to VL53L0X.
  */
-int VL53L0X_write_multi(uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uint32_t count);
+int VL53L0X_write_multi(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uint32_t count);
 
 /**
  * VL53L0X_read_byte
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 1 byte from VL53L0X.
  */
-int VL53L0X_read_byte(uint8_t deviceAddress, uint8_t index, uint8_t *data);
+int VL53L0X_read_byte(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t *data);
 
 
 /**
  * VL53L0X_write_byte
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data to be writen.
  * ----------
  * @brief write 1 byte to VL53L0X.
  */
-int VL53L0X_write_byte(uint8_t deviceAddress, uint8_t index, uint8_t data);
+int VL53L0X_write_byte(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t data);
 
 /**
  * VL53L0X_read_word
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 2 bytes from VL53L0X.
  */
-int VL53L0X_read_word(uint8_t deviceAddress, uint8_t index, uint16_t *data);
+int VL53L0X_read_word(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint16_t *data);
 
 /**
  * VL53L0X_write_word
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data to be writen.
  * ----------
  * @brief write 2 bytes to VL53L0X.
  */
-int VL53L0X_write_word(uint8_t deviceAddress, uint8_t index, uint16_t data);
+int VL53L0X_write_word(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint16_t data);
 
 /**
  * VL53L0X_read_dword
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 4 bytes from VL53L0X.
  */
-int VL53L0X_read_dword(uint8_t deviceAddress, uint8_t index, uint32_t *data);
+int VL53L0X_read_dword(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint32_t *data);
 
 /**
  * VL53L0X_write_dword
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data to be writen.
  * ----------
  * @brief write 4 bytes to VL53L0X.
  */
-int VL53L0X_write_dword(uint8_t deviceAddress, uint8_t index, uint32_t data);
+int VL53L0X_write_dword(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint32_t data);
+
+/**
+ * VL53L0X_write_script
+ * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
+ * @param  deviceAddress  address of slave device.
+ * @param  script         (index, value) byte pairs, written in order.
+ * @param  count          number of pairs in script.
+ * ----------
+ * @brief write a sequence of single byte registers to VL53L0X as one queued burst.
+ */
+int VL53L0X_write_script(uint8_t bus, uint8_t deviceAddress, const uint8_t* script, uint32_t count);
 
@@ -0,0 +1,95 @@
+/*!
+ * @file  VL53L0X_calibration.h
+ * @brief Keep VL53L0X calibration across boots so warm starts skip the slow calibration.
+ * ----------
+ * ST VL53L0X datasheet: https://www.st.com/resource/en/datasheet/vl53l0x.pdf
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#ifndef __VL53L0X_CALIBRATION_H__
+#define __VL53L0X_CALIBRATION_H__
+
+#include <stdint.h>
+#include "vl53l0x_api.h"
+
+#define VL53L0X_CAL_MAGIC   0x564C3043  // "VL0C"
+#define VL53L0X_CAL_SLOTS   10          // records a store keeps, one per sensor
+
+typedef struct {
+    uint32_t magic;                     // VL53L0X_CAL_MAGIC for a written record
+    uint32_t uidUpper;                  // unique part ID of the sensor the record belongs to
+    uint32_t uidLower;
+    uint32_t refSpadCount;              // from VL53L0X_PerformRefSpadManagement
+    uint8_t  isApertureSpads;
+    uint8_t  vhvSettings;               // from VL53L0X_PerformRefCalibration
+    uint8_t  phaseCal;
+    uint8_t  reserved;
+    int32_t  offsetMicroMeter;
+    FixPoint1616_t xtalkRateMegaCps;
+    uint32_t checksum;                  // ~ sum of the words above
+} VL53L0X_CalRecord;
+
+#define VL53L0X_CAL_RECORD_WORDS (sizeof(VL53L0X_CalRecord) / 4)
+
+/*
+ *  Storage backend, a record is read and written whole by slot number.
+ *  Both return 1 for success, 0 otherwise.
+ */
+typedef struct {
+    int (*read)(uint32_t slot, VL53L0X_CalRecord* record);
+    int (*write)(uint32_t slot, const VL53L0X_CalRecord* record);
+} VL53L0X_CalStore;
+
+extern const VL53L0X_CalStore VL53L0X_CalStoreRAM;     // lost on reset, for testing
+extern const VL53L0X_CalStore VL53L0X_CalStoreEEPROM;  // TM4C123 EEPROM, see VL53L0X_calibration_EEPROM.c
+
+/**
+ * VL53L0X_Calibration_setStore
+ * ----------
+ * @param  store  where to keep calibration records, 0 to calibrate on every boot.
+ */
+void VL53L0X_Calibration_setStore(const VL53L0X_CalStore* store);
+
+/**
+ * VL53L0X_Calibration_Run
+ * ----------
+ * @param  device  VL53L0X after VL53L0X_StaticInit.
+ * ----------
+ * @return any error code.
+ * ----------
+ * @brief  Restore the stored record of the sensor. If there is none, or it
+ *         does not check out, run reference SPAD management and reference
+ *         calibration and store the result.
+ */
+VL53L0X_Error VL53L0X_Calibration_Run(VL53L0X_DEV device);
+
+/**
+ * VL53L0X_Calibration_Restore
+ * ----------
+ * @param  device  VL53L0X after VL53L0X_StaticInit.
+ * ----------
+ * @return VL53L0X_ERROR_CALIBRATION_WARNING if no valid record matches the
+ *         part ID, any other error code from the sensor.
+ */
+VL53L0X_Error VL53L0X_Calibration_Restore(VL53L0X_DEV device);
+
+/**
+ * VL53L0X_Calibration_Save
+ * ----------
+ * @param  device  calibrated VL53L0X.
+ * ----------
+ * @return any error code, VL53L0X_ERROR_CALIBRATION_WARNING if the store fails.
+ * ----------
+ * @brief  Read the calibration back from the sensor and store it under its part ID.
+ */
+VL53L0X_Error VL53L0X_Calibration_Save(VL53L0X_DEV device);
+
+#endif
@@ -0,0 +1,91 @@
+/*!
+ * @file  VL53L0X_scheduler.h
+ * @brief Round robin continuous ranging scheduler for multiple VL53L0X sensors.
+ * ----------
+ * ST VL53L0X datasheet: https://www.st.com/resource/en/datasheet/vl53l0x.pdf
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#ifndef __VL53L0X_SCHEDULER_H__
+#define __VL53L0X_SCHEDULER_H__
+
+#include <stdint.h>
+#include "VL53L0X.h"
+
+typedef struct {
+    VL53L0X_RangingMeasurementData_t data;  // latest measurement of the sensor
+    VL53L0X_Error status;                   // status of the latest fetch
+    uint32_t sequence;                      // bumped on every measurement fetched without error
+} VL53L0X_Slot;
+
+/**
+ * VL53L0X_Scheduler_Init
+ * ----------
+ * @param  count     number of sensors, deviceList[0] to deviceList[count - 1].
+ * @param  budgetUs  measurement timing budget of every sensor in microseconds.
+ * @param  periodMs  inter-measurement period of every sensor in milliseconds.
+ * ----------
+ * @return 0 for failed initialization, 1 for successful initialization.
+ * ----------
+ * @brief  Put every sensor in continuous timed ranging and start them
+ *         periodMs / count apart, so their samples land evenly spread.
+ *         Sensors must already be through VL53L0X_ContinuousRanging_Init.
+ */
+int VL53L0X_Scheduler_Init(int count, uint32_t budgetUs, uint32_t periodMs);
+
+/**
+ * VL53L0X_Scheduler_Run
+ * ----------
+ * @return number of measurements collected.
+ * ----------
+ * @brief  Visit every sensor once, starting after the last one served, and
+ *         move each ready measurement into the slot of its sensor, and into
+ *         the record ring once VL53L0X_Ring_Init is done. A failed fetch
+ *         only sets the status of the slot. Readiness comes from GPIO1 if
+ *         VL53L0X_setGpio1Interrupt is set, I2C otherwise. Call from the
+ *         main loop.
+ */
+int VL53L0X_Scheduler_Run(void);
+
+/**
+ * VL53L0X_Scheduler_getSlot
+ * ----------
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return output slot of the sensor.
+ */
+const VL53L0X_Slot* VL53L0X_Scheduler_getSlot(int index);
+
+/**
+ * VL53L0X_Scheduler_getSampleCount
+ * ----------
+ * @return measurements collected from all sensors since VL53L0X_Scheduler_Init.
+ */
+uint32_t VL53L0X_Scheduler_getSampleCount(void);
+
+/**
+ * VL53L0X_Scheduler_getRate
+ * ----------
+ * @return samples per second from all sensors since VL53L0X_Scheduler_Init.
+ * ----------
+ * @brief  Throughput counter, measured from the start of the first sensor
+ *         on the Timebase.h clock, which wraps after about 71 minutes.
+ */
+uint32_t VL53L0X_Scheduler_getRate(void);
+
+/**
+ * VL53L0X_Scheduler_Stop
+ * ----------
+ * @brief  Stop continuous ranging on every scheduled sensor.
+ */
+void VL53L0X_Scheduler_Stop(void);
+
+#endif
@@ -16,8 +16,28 @@
 #ifndef __XSHUT_H__
 #define __XSHUT_H__
 
+#include <stdint.h>
+
+#define XSHUT_SENSOR_COUNT 4   // sensors wired to XSHUT and GPIO1 lines
+
 void xshut_Init(void);
 
 void xshut_Switch(void);
 
+/**
+ * gpio1_Init
+ * ----------
+ * @brief set up the GPIO1 line of every sensor as a falling edge interrupt.
+ */
+void gpio1_Init(void);
+
+/**
+ * gpio1_getFlag
+ * ----------
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return data ready flag the GPIO1 interrupt of the sensor sets.
+ */
+volatile uint8_t* gpio1_getFlag(int index);
+
 #endif
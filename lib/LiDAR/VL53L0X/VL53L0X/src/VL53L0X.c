@@ -14,11 +14,48 @@
  * @date   Aug 4, 2018
  */
 
+#include <string.h>
 #include "VL53L0X.h"
 #include "VL53L0X_I2C.h"
+#include "I2C.h"
+#include "VL53L0X_calibration.h"
 #include "VL53L0X_DEBUG.h"
 
-VL53L0X deviceList[10];
+VL53L0X deviceList[VL53L0X_MAX_SENSORS];
+
+/*
+ *  head is written by the producer only and tail by the consumer only. Both
+ *  run free and wrap through mask; records are copied through a volatile
+ *  pointer so they are in place before head moves past them.
+ */
+static struct {
+    volatile VL53L0X_Record* buffer;
+    uint32_t                 mask;
+    volatile uint32_t        head;
+    volatile uint32_t        tail;
+    volatile uint32_t        dropped;
+    uint32_t                 lastStampUs;       // data ready time the last delta counts up to
+    uint8_t                  primed;            // 0 until the first record
+} ring;
+
+/**
+ * recordLatency
+ * ----------
+ * Description: add the measurement time of a result to the sensor histogram.
+ */
+static void recordLatency(int index, VL53L0X_RangingMeasurementData_t* RangingMeasurementData) {
+    VL53L0X_Latency* latency = &deviceList[index].latency;
+    uint32_t         us = RangingMeasurementData->MeasurementTimeUsec;
+    uint32_t         bin = us / 1000;
+    
+    if (bin >= VL53L0X_LATENCY_BINS) bin = VL53L0X_LATENCY_BINS - 1;
+    if (latency->bins[bin] != 0xFFFF) latency->bins[bin]++;
+    
+    if (latency->count == 0 || us < latency->minUs) latency->minUs = us;
+    if (us > latency->maxUs) latency->maxUs = us;
+    latency->sumUs += us;
+    latency->count++;
+}
 
 /**
  * VL53L0X_Init
@@ -27,17 +64,25 @@ VL53L0X deviceList[10];
  * ----------
  * @return 0 for failed initialization, 1 for successful initialization.
  * ----------
- * @brief  Initialize VL53L0X.
+ * @brief  Initialize VL53L0X on the I2C module set by VL53L0X_setBus, I2C0 by
+ *         default. The I2C clock is taken from device.comms_speed_khz,
+ *         VL53L0X_I2C_SPEED is used if it is left 0.
  */
 int VL53L0X_Init (int index) {
     
-    VL53L0X_I2C_Init();                                         // must initialize I2C before initialize VL53L0X
-    
     VL53L0X_Dev_t*        device = &deviceList[index].device;
     VL53L0X_DeviceInfo_t* deviceInfo = &deviceList[index].deviceInfo;
     VL53L0X_Error         status = VL53L0X_ERROR_NONE;
     VL53L0X_Version_t     version;
     
+    VL53L0X_ShadowReset(device);                                // sensor just woke up, registers are at reset values
+    VL53L0X_resetLatency(index);
+    VL53L0X_I2C_Init(device->bus);                              // must initialize I2C before initialize VL53L0X
+    
+    // run the bus as fast as the sensor allows unless told otherwise
+    if (device->comms_speed_khz == 0) device->comms_speed_khz = VL53L0X_I2C_SPEED;
+    VL53L0X_I2C_setSpeed(device->bus, device->comms_speed_khz);
+    
     // set device address to default
     device->I2cDevAddr = VL53L0X_I2C_ADDR;     // default
     
@@ -120,10 +165,6 @@ int VL53L0X_SingleRanging_Init (int index) {
     
     // variable needed for some function calls
     VL53L0X_Error status = VL53L0X_ERROR_NONE;
-    uint32_t  refSpadCount;
-    uint8_t   isApertureSpads;
-    uint8_t   VhvSettings;
-    uint8_t   PhaseCal;
     
     if( status == VL53L0X_ERROR_NONE ) {
         VL53L0X_DEBUG_MSG("- VL53L0X_StaticInit -");
@@ -133,16 +174,8 @@ int VL53L0X_SingleRanging_Init (int index) {
     }
     
     if( status == VL53L0X_ERROR_NONE ) {
-        VL53L0X_DEBUG_MSG("- VL53L0X_PerformRefSpadManagement -");
-        // performs reference spad Management
-        status = VL53L0X_PerformRefSpadManagement( &deviceList[index].device, &refSpadCount, &isApertureSpads );
-        VL53L0X_DEBUG_STATUS(status);
-    }
-    
-    if( status == VL53L0X_ERROR_NONE ) {
-        VL53L0X_DEBUG_MSG("- VL53L0X_PerformRefCalibration -");
-        // perform reference calibration
-        status = VL53L0X_PerformRefCalibration( &deviceList[index].device, &VhvSettings, &PhaseCal );
+        // restore stored calibration, or calibrate and store it
+        status = VL53L0X_Calibration_Run( &deviceList[index].device );
         VL53L0X_DEBUG_STATUS(status);
     }
     
@@ -205,10 +238,6 @@ int VL53L0X_SingleRanging_Init (int index) {
 int VL53L0X_ContinuousRanging_Init (int index) {
     // variable needed for some function calls
     VL53L0X_Error status = VL53L0X_ERROR_NONE;
-    uint32_t  refSpadCount;
-    uint8_t   isApertureSpads;
-    uint8_t   VhvSettings;
-    uint8_t   PhaseCal;
     
     if( status == VL53L0X_ERROR_NONE ) {
         VL53L0X_DEBUG_MSG("- VL53L0X_StaticInit -");
@@ -218,16 +247,8 @@ int VL53L0X_ContinuousRanging_Init (int index) {
     }
     
     if( status == VL53L0X_ERROR_NONE ) {
-        VL53L0X_DEBUG_MSG("- VL53L0X_PerformRefSpadManagement -");
-        // performs reference spad Management
-        status = VL53L0X_PerformRefSpadManagement( &deviceList[index].device, &refSpadCount, &isApertureSpads );
-        VL53L0X_DEBUG_STATUS(status);
-    }
-    
-    if( status == VL53L0X_ERROR_NONE ) {
-        VL53L0X_DEBUG_MSG("- VL53L0X_PerformRefCalibration -");
-        // perform reference calibration
-        status = VL53L0X_PerformRefCalibration( &deviceList[index].device, &VhvSettings, &PhaseCal );
+        // restore stored calibration, or calibrate and store it
+        status = VL53L0X_Calibration_Run( &deviceList[index].device );
         VL53L0X_DEBUG_STATUS(status);
     }
     
@@ -270,6 +291,143 @@ int VL53L0X_setAddress(uint8_t newAddress, int index) {
     return FAIL;
 }
 
+/**
+ * VL53L0X_setBus
+ * ----------
+ * @param  bus    I2C module (0 to 3) the VL53L0X is wired to.
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return 0 for invalid module, 1 for success.
+ * ----------
+ * @brief  Select the I2C module of VL53L0X, call before VL53L0X_Init.
+ */
+int VL53L0X_setBus(uint8_t bus, int index) {
+    
+    if (bus >= I2C_BUS_COUNT) return FAIL;
+    
+    deviceList[index].device.bus = bus;
+    return SUCCESS;
+}
+
+/**
+ * VL53L0X_setShadow
+ * ----------
+ * @param  enable  ENABLE to keep a shadow of page select and stable registers, DISABLE otherwise.
+ * @param  index   Index to the specified sensor.
+ * ----------
+ * @brief  Turn the register shadow of VL53L0X on or off. With the shadow on,
+ *         writes that would not change a register are dropped and
+ *         read-modify-write is served without a read.
+ */
+void VL53L0X_setShadow(uint8_t enable, int index) {
+    VL53L0X_ShadowReset(&deviceList[index].device);       // start from a clean shadow either way
+    deviceList[index].device.shadow_enable = enable;
+}
+
+/**
+ * VL53L0X_getShadowCounters
+ * ----------
+ * @param  hits    where to store the number of reads served from the shadow.
+ * @param  elided  where to store the number of I2C transactions dropped.
+ * @param  index   Index to the specified sensor.
+ * ----------
+ * @brief  Read the register shadow counters of VL53L0X.
+ */
+void VL53L0X_getShadowCounters(uint32_t* hits, uint32_t* elided, int index) {
+    *hits = deviceList[index].device.shadow_hits;
+    *elided = deviceList[index].device.shadow_elided;
+}
+
+/**
+ * VL53L0X_getLatency
+ * ----------
+ * @param  minUs  where to store the shortest measurement time.
+ * @param  avgUs  where to store the average measurement time.
+ * @param  p99Us  where to store the 99th percentile, to the next 1 ms bin edge.
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return number of measurements recorded, the times are 0 if there are none.
+ * ----------
+ * @brief  Read the start to data ready time statistics of VL53L0X, taken from
+ *         MeasurementTimeUsec of every measurement read through this driver.
+ */
+uint32_t VL53L0X_getLatency(uint32_t* minUs, uint32_t* avgUs, uint32_t* p99Us, int index) {
+    
+    VL53L0X_Latency* latency = &deviceList[index].latency;
+    uint32_t         total = 0;
+    uint32_t         rank;
+    int              bin;
+    
+    *minUs = *avgUs = *p99Us = 0;
+    if (latency->count == 0) return 0;
+    
+    for (bin = 0; bin < VL53L0X_LATENCY_BINS; bin++) total += latency->bins[bin];
+    rank = total - total / 100;                                 // samples at or below p99
+    
+    for (bin = 0, total = 0; bin < VL53L0X_LATENCY_BINS - 1; bin++) {
+        total += latency->bins[bin];
+        if (total >= rank) break;
+    }
+    
+    *minUs = latency->minUs;
+    *avgUs = latency->sumUs / latency->count;
+    *p99Us = (bin + 1) * 1000;                                  // upper edge of the bin
+    if (*p99Us > latency->maxUs || bin == VL53L0X_LATENCY_BINS - 1) *p99Us = latency->maxUs;
+    
+    return latency->count;
+}
+
+/**
+ * VL53L0X_resetLatency
+ * ----------
+ * @param  index  Index to the specified sensor.
+ */
+void VL53L0X_resetLatency(int index) {
+    memset(&deviceList[index].latency, 0, sizeof(VL53L0X_Latency));
+}
+
+/**
+ * VL53L0X_setGpio1Interrupt
+ * ----------
+ * @param  readyFlag  flag set by the GPIO1 edge interrupt, see gpio1_getFlag. 0 to go back to polling.
+ * @param  index      Index to the specified sensor.
+ * ----------
+ * @return 0 for failed setup, 1 for successful setup.
+ * ----------
+ * @brief  Signal new samples on GPIO1 and take measurement completion from
+ *         readyFlag instead of polling VL53L0X over I2C. Call after the
+ *         ranging mode is initialized.
+ */
+int VL53L0X_setGpio1Interrupt(volatile uint8_t* readyFlag, int index) {
+    
+    VL53L0X_Dev_t*      device = &deviceList[index].device;
+    VL53L0X_Error       status = VL53L0X_ERROR_NONE;
+    VL53L0X_DeviceModes deviceMode;
+    
+    device->gpio1_ready = 0;                                    // poll over I2C while reconfiguring
+    
+    status = VL53L0X_GetDeviceMode(device, &deviceMode);
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        // GPIO1 goes low when a new sample is ready
+        status = VL53L0X_SetGpioConfig(device, 0, deviceMode,
+                                       readyFlag ? VL53L0X_GPIOFUNCTIONALITY_NEW_MEASURE_READY : VL53L0X_GPIOFUNCTIONALITY_OFF,
+                                       VL53L0X_INTERRUPTPOLARITY_LOW);
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        if (readyFlag) *readyFlag = 0;
+        status = VL53L0X_ClearInterruptMask(device, 0);         // release GPIO1
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        device->gpio1_ready = readyFlag;
+        return SUCCESS;
+    }
+    
+    return FAIL;
+}
+
 /**
  * VL53L0X_getSingleRangingMeasurement
  * ----------
@@ -280,6 +438,248 @@ int VL53L0X_setAddress(uint8_t newAddress, int index) {
  * @brief  Get a ranging measurement from VL53L0X.
  */
 VL53L0X_Error VL53L0X_getSingleRangingMeasurement (VL53L0X_RangingMeasurementData_t* RangingMeasurementData, int index) {
-    return VL53L0X_PerformSingleRangingMeasurement( &deviceList[index].device, RangingMeasurementData );
+    
+    VL53L0X_Error status = VL53L0X_PerformSingleRangingMeasurement( &deviceList[index].device, RangingMeasurementData );
+    
+    if( status == VL53L0X_ERROR_NONE ) recordLatency(index, RangingMeasurementData);
+    
+    return status;
+}
+
+/**
+ * VL53L0X_getSingleRangingMeasurementFast
+ * ----------
+ * @param  RangingMeasurementData  pointer for where to store the ranging data.
+ * ----------
+ * @return any error code.
+ * ----------
+ * @brief  Get a ranging measurement from VL53L0X with VL53L0X_PerformSingleRangingFast:
+ *         setup happens on the first call only, and the timing budget is
+ *         slept through instead of polled.
+ */
+VL53L0X_Error VL53L0X_getSingleRangingMeasurementFast (VL53L0X_RangingMeasurementData_t* RangingMeasurementData, int index) {
+    
+    VL53L0X_Error status = VL53L0X_PerformSingleRangingFast( &deviceList[index].device, RangingMeasurementData );
+    
+    if( status == VL53L0X_ERROR_NONE ) recordLatency(index, RangingMeasurementData);
+    
+    return status;
+}
+
+/**
+ * VL53L0X_setDecodeLevel
+ * ----------
+ * @param  level  VL53L0X_RANGEDECODELEVEL_RAW, _LITE or _FULL (default).
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return any error code.
+ * ----------
+ * @brief  Choose how much of the range status is decoded per sample. RAW and
+ *         LITE skip the page 1 signal ref read and the sigma estimate, so
+ *         they cost no I2C beyond the result registers. Call after VL53L0X_Init.
+ */
+VL53L0X_Error VL53L0X_setDecodeLevel (VL53L0X_RangeDecodeLevel level, int index) {
+    return VL53L0X_SetRangeDecodeLevel( &deviceList[index].device, level );
+}
+
+/**
+ * VL53L0X_startRanging
+ * ----------
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return any error code.
+ * ----------
+ * @brief  Start a single ranging measurement and return right away, so
+ *         several sensors can range at the same time.
+ */
+VL53L0X_Error VL53L0X_startRanging(int index) {
+    
+    VL53L0X_Dev_t* device = &deviceList[index].device;
+    VL53L0X_Error  status = VL53L0X_ERROR_NONE;
+    
+    status = VL53L0X_SetDeviceMode(device, VL53L0X_DEVICEMODE_SINGLE_RANGING);
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        status = VL53L0X_StartMeasurement(device);              // only waits for the start bit
+    }
+    
+    return status;
+}
+
+/**
+ * VL53L0X_isRangingReady
+ * ----------
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return 1 when the measurement started by VL53L0X_startRanging is done,
+ *         0 otherwise. A sensor that fails to answer counts as done, so
+ *         VL53L0X_fetchRanging can report the error.
+ */
+int VL53L0X_isRangingReady(int index) {
+    
+    uint8_t ready = 0;
+    
+    if (VL53L0X_GetMeasurementDataReady(&deviceList[index].device, &ready) != VL53L0X_ERROR_NONE) {
+        return 1;                                               // let fetch report the error
+    }
+    
+    return ready;
+}
+
+/**
+ * VL53L0X_fetchRanging
+ * ----------
+ * @param  index                   Index to the specified sensor.
+ * @param  RangingMeasurementData  pointer for where to store the ranging data.
+ * ----------
+ * @return any error code.
+ * ----------
+ * @brief  Read the finished measurement and get the sensor ready for the next one.
+ *         Works for single and continuous ranging.
+ */
+VL53L0X_Error VL53L0X_fetchRanging(int index, VL53L0X_RangingMeasurementData_t* RangingMeasurementData) {
+    
+    VL53L0X_Dev_t*      device = &deviceList[index].device;
+    VL53L0X_Error       status = VL53L0X_ERROR_NONE;
+    VL53L0X_DeviceModes deviceMode;
+    
+    status = VL53L0X_GetRangingMeasurementData(device, RangingMeasurementData);
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        recordLatency(index, RangingMeasurementData);
+        status = VL53L0X_ClearInterruptMask(device, 0);
+    }
+    
+    VL53L0X_GetDeviceMode(device, &deviceMode);                 // kept in RAM, no I2C
+    if (deviceMode == VL53L0X_DEVICEMODE_SINGLE_RANGING) {
+        PALDevDataSet(device, PalState, VL53L0X_STATE_IDLE);    // single ranging is over either way
+    }
+    
+    return status;
 }
 
+/****************************************************
+ *                                                  *
+ *                   Record Ring                    *
+ *                                                  *
+ ****************************************************/
+
+/**
+ * VL53L0X_Ring_Init
+ * ----------
+ * @param  buffer  storage for the records, 1024 records take 8 KB.
+ * @param  size    number of records in buffer, a power of two.
+ * ----------
+ * @return 0 for invalid size, 1 for success.
+ * ----------
+ * @brief  Set up the record ring, empty. Call before the producer starts.
+ */
+int VL53L0X_Ring_Init(VL53L0X_Record* buffer, uint32_t size) {
+    
+    if (buffer == 0 || size < 2 || (size & (size - 1)) != 0) return FAIL;
+    
+    ring.buffer = buffer;
+    ring.mask = size - 1;
+    ring.head = 0;
+    ring.tail = 0;
+    ring.dropped = 0;
+    ring.primed = 0;
+    
+    return SUCCESS;
+}
+
+/**
+ * VL53L0X_Ring_push
+ * ----------
+ * @param  RangingMeasurementData  measurement to pack into a record.
+ * @param  index                   Index to the specified sensor.
+ * ----------
+ * @return 1 if stored, 0 if the ring is full or not set up.
+ * ----------
+ * @brief  Producer side. A full ring drops the record and counts it, the
+ *         delta of the next record still covers the time of the dropped one.
+ */
+int VL53L0X_Ring_push(const VL53L0X_RangingMeasurementData_t* RangingMeasurementData, int index) {
+    
+    uint32_t                 head = ring.head;
+    uint32_t                 ticks = 0;
+    uint32_t                 rate = RangingMeasurementData->SignalRateRtnMegaCps >> 8;   // 16.16 to 8.8
+    volatile VL53L0X_Record* record;
+    
+    if (ring.buffer == 0) return FAIL;
+    
+    if (head - ring.tail > ring.mask) {
+        ring.dropped++;
+        return FAIL;
+    }
+    
+    if (ring.primed) {
+        ticks = (RangingMeasurementData->TimeStamp - ring.lastStampUs) / VL53L0X_RECORD_TICK_US;
+    }
+    if (ticks > 0xFFFF) {
+        ticks = 0xFFFF;
+        ring.lastStampUs = RangingMeasurementData->TimeStamp;
+    } else if (ring.primed) {
+        ring.lastStampUs += ticks * VL53L0X_RECORD_TICK_US;     // keep the remainder for the next delta
+    } else {
+        ring.lastStampUs = RangingMeasurementData->TimeStamp;
+        ring.primed = 1;
+    }
+    
+    record = &ring.buffer[head & ring.mask];
+    record->rangeMilliMeter = RangingMeasurementData->RangeMilliMeter;
+    record->signalRate = rate > 0xFFFF ? 0xFFFF : rate;
+    record->status = RangingMeasurementData->RangeStatus;
+    record->sensor = index;
+    record->delta = ticks;
+    
+    ring.head = head + 1;                                       // publish
+    
+    return SUCCESS;
+}
+
+/**
+ * VL53L0X_Ring_pop
+ * ----------
+ * @param  record  where to store the oldest record.
+ * ----------
+ * @return 1 if a record was taken, 0 if the ring is empty.
+ * ----------
+ * @brief  Consumer side.
+ */
+int VL53L0X_Ring_pop(VL53L0X_Record* record) {
+    
+    uint32_t                 tail = ring.tail;
+    volatile VL53L0X_Record* slot;
+    
+    if (tail == ring.head) return FAIL;
+    
+    slot = &ring.buffer[tail & ring.mask];
+    record->rangeMilliMeter = slot->rangeMilliMeter;
+    record->signalRate = slot->signalRate;
+    record->status = slot->status;
+    record->sensor = slot->sensor;
+    record->delta = slot->delta;
+    
+    ring.tail = tail + 1;                                       // hand the slot back
+    
+    return SUCCESS;
+}
+
+/**
+ * VL53L0X_Ring_count
+ * ----------
+ * @return number of records waiting in the ring.
+ */
+uint32_t VL53L0X_Ring_count(void) {
+    return ring.head - ring.tail;
+}
+
+/**
+ * VL53L0X_Ring_getDropped
+ * ----------
+ * @return number of records dropped on a full ring since VL53L0X_Ring_Init.
+ */
+uint32_t VL53L0X_Ring_getDropped(void) {
+    return ring.dropped;
+}
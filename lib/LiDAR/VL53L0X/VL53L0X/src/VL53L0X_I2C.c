@@ -26,10 +26,24 @@
 /**
  * VL53L0X_I2C_Init
  * ----------
+ * @param  bus  I2C module (0 to 3) VL53L0X is wired to.
+ * ----------
  * @brief initialize I2C with corresponding setting parameters.
  */
-void VL53L0X_I2C_Init(void) {
-    I2C_Init();
+void VL53L0X_I2C_Init(uint8_t bus) {
+    I2C_Init(&I2C_Buses[bus]);
+}
+
+/**
+ * VL53L0X_I2C_setSpeed
+ * ----------
+ * @param  bus       I2C module (0 to 3) VL53L0X is wired to.
+ * @param  speedKHz  SCL clock in kHz, VL53L0X runs up to 400 kHz.
+ * ----------
+ * @brief change I2C clock used to talk to VL53L0X.
+ */
+void VL53L0X_I2C_setSpeed(uint8_t bus, uint16_t speedKHz) {
+    I2C_setSpeed(&I2C_Buses[bus], speedKHz);
 }
 
 /****************************************************
@@ -41,6 +55,7 @@ void VL53L0X_I2C_Init(void) {
 /**
  * VL53L0X_read_multi
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  pdata          data address to store read data.
@@ -48,13 +63,14 @@ void VL53L0X_I2C_Init(void) {
  * ----------
  * @brief read 1 or more bytes from VL53L0X.
  */
-int VL53L0X_read_multi(uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uint32_t count) {
-    return I2C_read(deviceAddress, index, pdata, count);
+int VL53L0X_read_multi(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uint32_t count) {
+    return I2C_read(&I2C_Buses[bus], deviceAddress, index, pdata, count);
 }
 
 /**
  * VL53L0X_write_byte
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  pdata          data address of data to be writen.
@@ -62,53 +78,56 @@ int VL53L0X_read_multi(uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uin
  * ----------
  * @brief write 1 or more bytes to VL53L0X.
  */
-int VL53L0X_write_multi(uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uint32_t count) {
-    return I2C_write(deviceAddress, index, pdata, count);
+int VL53L0X_write_multi(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uint32_t count) {
+    return I2C_write(&I2C_Buses[bus], deviceAddress, index, pdata, count);
 }
 
 /**
  * VL53L0X_read_byte
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 1 byte from VL53L0X.
  */
-int VL53L0X_read_byte(uint8_t deviceAddress, uint8_t index, uint8_t *data) {
+int VL53L0X_read_byte(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t *data) {
     // read 1 byte
-    return I2C_read_byte(deviceAddress, index, data);
+    return I2C_read_byte(&I2C_Buses[bus], deviceAddress, index, data);
 }
 
 
 /**
  * VL53L0X_write_byte
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data to be writen.
  * ----------
  * @brief write 1 byte to VL53L0X.
  */
-int VL53L0X_write_byte(uint8_t deviceAddress, uint8_t index, uint8_t data) {
+int VL53L0X_write_byte(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t data) {
     // write 1 byte
-    return I2C_write_byte(deviceAddress, index, data);
+    return I2C_write_byte(&I2C_Buses[bus], deviceAddress, index, data);
 }
 
 /**
  * VL53L0X_read_word
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 2 bytes from VL53L0X.
  */
-int VL53L0X_read_word(uint8_t deviceAddress, uint8_t index, uint16_t *data) {
+int VL53L0X_read_word(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint16_t *data) {
     // buffer to hold read data
     uint8_t buffer[2];
     // read 2 bytes
-    int result = I2C_read_2_bytes(deviceAddress, index, buffer);
+    int result = I2C_read_2_bytes(&I2C_Buses[bus], deviceAddress, index, buffer);
     // store read data
     *data = (buffer[0] << 8) + buffer[1];
     
@@ -118,36 +137,38 @@ int VL53L0X_read_word(uint8_t deviceAddress, uint8_t index, uint16_t *data) {
 /**
  * VL53L0X_write_word
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data to be writen.
  * ----------
  * @brief write 2 bytes to VL53L0X.
  */
-int VL53L0X_write_word(uint8_t deviceAddress, uint8_t index, uint16_t data) {
+int VL53L0X_write_word(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint16_t data) {
     // buffer to hold read data
     uint8_t buffer[2];
     // put data into buffer
     buffer[1] = data & 0xFF;
     buffer[0] = data >> 8;
     // write 2 bytes
-    return I2C_write_2_bytes(deviceAddress, index, buffer);
+    return I2C_write_2_bytes(&I2C_Buses[bus], deviceAddress, index, buffer);
 }
 
 /**
  * VL53L0X_read_dword
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 4 bytes from VL53L0X.
  */
-int VL53L0X_read_dword(uint8_t deviceAddress, uint8_t index, uint32_t *data) {
+int VL53L0X_read_dword(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint32_t *data) {
     // buffer to hold read data
     uint8_t buffer[4];
     // read 4 bytes
-    int result = I2C_read_4_bytes(deviceAddress, index, buffer);
+    int result = I2C_read_4_bytes(&I2C_Buses[bus], deviceAddress, index, buffer);
     // srore read data
     *data = (buffer[0] << 24) + (buffer[1] << 16) + (buffer[2] << 8) + buffer[3];
     
@@ -157,13 +178,14 @@ int VL53L0X_read_dword(uint8_t deviceAddress, uint8_t index, uint32_t *data) {
 /**
  * VL53L0X_write_dword
  * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  index          index of corresponding register in VL53L0X.
  * @param  data           data to be writen.
  * ----------
  * @brief write 4 bytes to VL53L0X.
  */
-int VL53L0X_write_dword(uint8_t deviceAddress, uint8_t index, uint32_t data) {
+int VL53L0X_write_dword(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint32_t data) {
     // buffer to hold read data
     uint8_t buffer[4];
     // put data into buffer
@@ -172,6 +194,19 @@ int VL53L0X_write_dword(uint8_t deviceAddress, uint8_t index, uint32_t data) {
     buffer[2] = data >> 8;
     buffer[3] = data & 0xFF;
     // write 4 bytes
-    return I2C_write_4_bytes(deviceAddress, index, buffer);
+    return I2C_write_4_bytes(&I2C_Buses[bus], deviceAddress, index, buffer);
 }
 
+/**
+ * VL53L0X_write_script
+ * ----------
+ * @param  bus            I2C module (0 to 3) VL53L0X is wired to.
+ * @param  deviceAddress  address of slave device.
+ * @param  script         (index, value) byte pairs, written in order.
+ * @param  count          number of pairs in script.
+ * ----------
+ * @brief write a sequence of single byte registers to VL53L0X as one queued burst.
+ */
+int VL53L0X_write_script(uint8_t bus, uint8_t deviceAddress, const uint8_t* script, uint32_t count) {
+    return I2C_write_script(&I2C_Buses[bus], deviceAddress, script, count);
+}
@@ -0,0 +1,261 @@
+/*!
+ * @file  VL53L0X_calibration.c
+ * @brief Keep VL53L0X calibration across boots so warm starts skip the slow calibration.
+ * ----------
+ * ST VL53L0X datasheet: https://www.st.com/resource/en/datasheet/vl53l0x.pdf
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include "vl53l0x_api.h"
+#include "vl53l0x_api_core.h"
+#include "VL53L0X_calibration.h"
+#include "VL53L0X_DEBUG.h"
+
+static const VL53L0X_CalStore* calStore = 0;
+
+/****************************************************
+ *                                                  *
+ *                    RAM Store                     *
+ *                                                  *
+ ****************************************************/
+
+static VL53L0X_CalRecord ramRecords[VL53L0X_CAL_SLOTS];
+
+static int ramRead(uint32_t slot, VL53L0X_CalRecord* record) {
+    if (slot >= VL53L0X_CAL_SLOTS) return 0;
+    *record = ramRecords[slot];
+    return 1;
+}
+
+static int ramWrite(uint32_t slot, const VL53L0X_CalRecord* record) {
+    if (slot >= VL53L0X_CAL_SLOTS) return 0;
+    ramRecords[slot] = *record;
+    return 1;
+}
+
+const VL53L0X_CalStore VL53L0X_CalStoreRAM = { ramRead, ramWrite };
+
+/****************************************************
+ *                                                  *
+ *                 Record Handling                  *
+ *                                                  *
+ ****************************************************/
+
+/**
+ * checksum
+ * ----------
+ * Description: ~ sum of every word of the record but the checksum.
+ */
+static uint32_t checksum(const VL53L0X_CalRecord* record) {
+    const uint32_t* words = (const uint32_t*)record;
+    uint32_t sum = 0;
+    
+    for (uint32_t i = 0; i < VL53L0X_CAL_RECORD_WORDS - 1; i++) sum += words[i];
+    
+    return ~sum;
+}
+
+/**
+ * isValid
+ * ----------
+ * Description: record is written and intact.
+ */
+static int isValid(const VL53L0X_CalRecord* record) {
+    return record->magic == VL53L0X_CAL_MAGIC && record->checksum == checksum(record);
+}
+
+/**
+ * readUID
+ * ----------
+ * Description: unique part ID from the sensor NVM, read once and cached by the ST API.
+ */
+static VL53L0X_Error readUID(VL53L0X_DEV device, uint32_t* upper, uint32_t* lower) {
+    VL53L0X_Error status = VL53L0X_get_info_from_device(device, 4);
+    
+    *upper = VL53L0X_GETDEVICESPECIFICPARAMETER(device, PartUIDUpper);
+    *lower = VL53L0X_GETDEVICESPECIFICPARAMETER(device, PartUIDLower);
+    
+    return status;
+}
+
+/**
+ * findSlot
+ * ----------
+ * Description: slot holding the part ID, -1 if none does. free gets the
+ *              first slot without a valid record, -1 if all are taken.
+ */
+static int findSlot(uint32_t upper, uint32_t lower, VL53L0X_CalRecord* record, int* free) {
+    *free = -1;
+    
+    for (int slot = 0; slot < VL53L0X_CAL_SLOTS; slot++) {
+        if (!calStore->read(slot, record) || !isValid(record)) {
+            if (*free < 0) *free = slot;
+            continue;
+        }
+        if (record->uidUpper == upper && record->uidLower == lower) return slot;
+    }
+    
+    return -1;
+}
+
+/****************************************************
+ *                                                  *
+ *                       APIs                       *
+ *                                                  *
+ ****************************************************/
+
+/**
+ * VL53L0X_Calibration_setStore
+ * ----------
+ * @param  store  where to keep calibration records, 0 to calibrate on every boot.
+ */
+void VL53L0X_Calibration_setStore(const VL53L0X_CalStore* store) {
+    calStore = store;
+}
+
+/**
+ * VL53L0X_Calibration_Restore
+ * ----------
+ * @param  device  VL53L0X after VL53L0X_StaticInit.
+ * ----------
+ * @return VL53L0X_ERROR_CALIBRATION_WARNING if no valid record matches the
+ *         part ID, any other error code from the sensor.
+ */
+VL53L0X_Error VL53L0X_Calibration_Restore(VL53L0X_DEV device) {
+    
+    VL53L0X_Error     status = VL53L0X_ERROR_NONE;
+    VL53L0X_CalRecord record;
+    uint32_t          upper, lower;
+    int               free;
+    
+    if (!calStore) return VL53L0X_ERROR_CALIBRATION_WARNING;
+    
+    status = readUID(device, &upper, &lower);
+    
+    if( status == VL53L0X_ERROR_NONE && findSlot(upper, lower, &record, &free) < 0 ) {
+        status = VL53L0X_ERROR_CALIBRATION_WARNING;
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        status = VL53L0X_SetReferenceSpads(device, record.refSpadCount, record.isApertureSpads);
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        status = VL53L0X_SetRefCalibration(device, record.vhvSettings, record.phaseCal);
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        status = VL53L0X_SetOffsetCalibrationDataMicroMeter(device, record.offsetMicroMeter);
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        status = VL53L0X_SetXTalkCompensationRateMegaCps(device, record.xtalkRateMegaCps);
+    }
+    
+    return status;
+}
+
+/**
+ * VL53L0X_Calibration_Save
+ * ----------
+ * @param  device  calibrated VL53L0X.
+ * ----------
+ * @return any error code, VL53L0X_ERROR_CALIBRATION_WARNING if the store fails.
+ * ----------
+ * @brief  Read the calibration back from the sensor and store it under its part ID.
+ */
+VL53L0X_Error VL53L0X_Calibration_Save(VL53L0X_DEV device) {
+    
+    VL53L0X_Error     status = VL53L0X_ERROR_NONE;
+    VL53L0X_CalRecord record;
+    uint32_t          upper, lower;
+    int               slot, free;
+    
+    if (!calStore) return VL53L0X_ERROR_NONE;
+    
+    status = readUID(device, &upper, &lower);
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        slot = findSlot(upper, lower, &record, &free);
+        if (slot < 0) slot = free >= 0 ? free : (int)(lower % VL53L0X_CAL_SLOTS);
+        
+        record.magic = VL53L0X_CAL_MAGIC;
+        record.uidUpper = upper;
+        record.uidLower = lower;
+        record.reserved = 0;
+        status = VL53L0X_GetReferenceSpads(device, &record.refSpadCount, &record.isApertureSpads);
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        status = VL53L0X_GetRefCalibration(device, &record.vhvSettings, &record.phaseCal);
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        status = VL53L0X_GetOffsetCalibrationDataMicroMeter(device, &record.offsetMicroMeter);
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        status = VL53L0X_GetXTalkCompensationRateMegaCps(device, &record.xtalkRateMegaCps);
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        record.checksum = checksum(&record);
+        if (!calStore->write(slot, &record)) status = VL53L0X_ERROR_CALIBRATION_WARNING;
+    }
+    
+    return status;
+}
+
+/**
+ * VL53L0X_Calibration_Run
+ * ----------
+ * @param  device  VL53L0X after VL53L0X_StaticInit.
+ * ----------
+ * @return any error code.
+ * ----------
+ * @brief  Restore the stored record of the sensor. If there is none, or it
+ *         does not check out, run reference SPAD management and reference
+ *         calibration and store the result.
+ */
+VL53L0X_Error VL53L0X_Calibration_Run(VL53L0X_DEV device) {
+    
+    VL53L0X_Error status = VL53L0X_ERROR_NONE;
+    uint32_t  refSpadCount;
+    uint8_t   isApertureSpads;
+    uint8_t   VhvSettings;
+    uint8_t   PhaseCal;
+    
+    VL53L0X_DEBUG_MSG("- VL53L0X_Calibration_Restore -");
+    if (VL53L0X_Calibration_Restore(device) == VL53L0X_ERROR_NONE) {
+        return VL53L0X_ERROR_NONE;
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        VL53L0X_DEBUG_MSG("- VL53L0X_PerformRefSpadManagement -");
+        // performs reference spad Management
+        status = VL53L0X_PerformRefSpadManagement( device, &refSpadCount, &isApertureSpads );
+        VL53L0X_DEBUG_STATUS(status);
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        VL53L0X_DEBUG_MSG("- VL53L0X_PerformRefCalibration -");
+        // perform reference calibration
+        status = VL53L0X_PerformRefCalibration( device, &VhvSettings, &PhaseCal );
+        VL53L0X_DEBUG_STATUS(status);
+    }
+    
+    if( status == VL53L0X_ERROR_NONE ) {
+        VL53L0X_Calibration_Save(device);               // next boot can skip the above
+    }
+    
+    return status;
+}
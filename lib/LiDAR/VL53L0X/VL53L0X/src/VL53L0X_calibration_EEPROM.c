@@ -0,0 +1,29 @@
+/*!
+ * @file  VL53L0X_calibration_EEPROM.c
+ * @brief VL53L0X calibration store on the TM4C123 EEPROM, call EEPROM_Init before use.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include "EEPROM.h"
+#include "VL53L0X_calibration.h"
+
+#define CAL_EEPROM_BASE 0       // first EEPROM word used for calibration records
+
+static int eepromRead(uint32_t slot, VL53L0X_CalRecord* record) {
+    if (slot >= VL53L0X_CAL_SLOTS) return 0;
+    return EEPROM_read(CAL_EEPROM_BASE + slot * VL53L0X_CAL_RECORD_WORDS,
+                       (uint32_t*)record, VL53L0X_CAL_RECORD_WORDS);
+}
+
+static int eepromWrite(uint32_t slot, const VL53L0X_CalRecord* record) {
+    if (slot >= VL53L0X_CAL_SLOTS) return 0;
+    return EEPROM_write(CAL_EEPROM_BASE + slot * VL53L0X_CAL_RECORD_WORDS,
+                        (const uint32_t*)record, VL53L0X_CAL_RECORD_WORDS);
+}
+
+const VL53L0X_CalStore VL53L0X_CalStoreEEPROM = { eepromRead, eepromWrite };
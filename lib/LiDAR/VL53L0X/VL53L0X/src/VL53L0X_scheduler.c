@@ -0,0 +1,158 @@
+/*!
+ * @file  VL53L0X_scheduler.c
+ * @brief Round robin continuous ranging scheduler for multiple VL53L0X sensors.
+ * ----------
+ * ST VL53L0X datasheet: https://www.st.com/resource/en/datasheet/vl53l0x.pdf
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include "Timebase.h"
+#include "VL53L0X.h"
+#include "VL53L0X_scheduler.h"
+#include "VL53L0X_DEBUG.h"
+
+static VL53L0X_Slot slots[VL53L0X_MAX_SENSORS];
+static int      sensorCount = 0;
+static int      nextSensor = 0;                                 // where the next round starts
+static uint32_t sampleCount = 0;
+static uint32_t startUs = 0;                                    // Timebase_now() when the first sensor started
+
+/**
+ * VL53L0X_Scheduler_Init
+ * ----------
+ * @param  count     number of sensors, deviceList[0] to deviceList[count - 1].
+ * @param  budgetUs  measurement timing budget of every sensor in microseconds.
+ * @param  periodMs  inter-measurement period of every sensor in milliseconds.
+ * ----------
+ * @return 0 for failed initialization, 1 for successful initialization.
+ * ----------
+ * @brief  Put every sensor in continuous timed ranging and start them
+ *         periodMs / count apart, so their samples land evenly spread.
+ *         Sensors must already be through VL53L0X_ContinuousRanging_Init.
+ */
+int VL53L0X_Scheduler_Init(int count, uint32_t budgetUs, uint32_t periodMs) {
+    
+    VL53L0X_Error status = VL53L0X_ERROR_NONE;
+    
+    if (count < 1 || count > VL53L0X_MAX_SENSORS) return FAIL;
+    
+    sensorCount = count;
+    nextSensor = 0;
+    sampleCount = 0;
+    
+    for (int i = 0; i < count && status == VL53L0X_ERROR_NONE; i++) {
+        VL53L0X_Dev_t* device = &deviceList[i].device;
+        
+        slots[i].sequence = 0;
+        slots[i].status = VL53L0X_ERROR_NONE;
+        
+        status = VL53L0X_SetDeviceMode(device, VL53L0X_DEVICEMODE_CONTINUOUS_TIMED_RANGING);
+        
+        if( status == VL53L0X_ERROR_NONE ) {
+            status = VL53L0X_SetMeasurementTimingBudgetMicroSeconds(device, budgetUs);
+        }
+        
+        if( status == VL53L0X_ERROR_NONE ) {
+            status = VL53L0X_SetInterMeasurementPeriodMilliSeconds(device, periodMs);
+        }
+        
+        VL53L0X_DEBUG_STATUS(status);
+    }
+    
+    // start one after another, spread over one period
+    startUs = Timebase_now();
+    for (int i = 0; i < count && status == VL53L0X_ERROR_NONE; i++) {
+        status = VL53L0X_StartMeasurement(&deviceList[i].device);
+        if (i < count - 1) Timebase_sleepUs(periodMs / count * 1000);
+    }
+    
+    return (status == VL53L0X_ERROR_NONE) ? SUCCESS : FAIL;
+}
+
+/**
+ * VL53L0X_Scheduler_Run
+ * ----------
+ * @return number of measurements collected.
+ * ----------
+ * @brief  Visit every sensor once, starting after the last one served, and
+ *         move each ready measurement into the slot of its sensor, and into
+ *         the record ring once VL53L0X_Ring_Init is done. A failed fetch only
+ *         sets the status of the slot.
+ */
+int VL53L0X_Scheduler_Run(void) {
+    
+    VL53L0X_RangingMeasurementData_t data;
+    int collected = 0;
+    int index = nextSensor;
+    
+    for (int n = 0; n < sensorCount; n++) {
+        if (VL53L0X_isRangingReady(index)) {
+            slots[index].status = VL53L0X_fetchRanging(index, &data);
+            if (slots[index].status == VL53L0X_ERROR_NONE) {    // a failed fetch keeps the last sample
+                slots[index].data = data;
+                VL53L0X_Ring_push(&slots[index].data, index);
+                slots[index].sequence++;
+                collected++;
+            }
+            nextSensor = index + 1 < sensorCount ? index + 1 : 0;
+        }
+        index = index + 1 < sensorCount ? index + 1 : 0;
+    }
+    
+    sampleCount += collected;
+    
+    return collected;
+}
+
+/**
+ * VL53L0X_Scheduler_getSlot
+ * ----------
+ * @param  index  Index to the specified sensor.
+ * ----------
+ * @return output slot of the sensor.
+ */
+const VL53L0X_Slot* VL53L0X_Scheduler_getSlot(int index) {
+    return &slots[index];
+}
+
+/**
+ * VL53L0X_Scheduler_getSampleCount
+ * ----------
+ * @return measurements collected from all sensors since VL53L0X_Scheduler_Init.
+ */
+uint32_t VL53L0X_Scheduler_getSampleCount(void) {
+    return sampleCount;
+}
+
+/**
+ * VL53L0X_Scheduler_getRate
+ * ----------
+ * @return samples per second from all sensors since VL53L0X_Scheduler_Init.
+ */
+uint32_t VL53L0X_Scheduler_getRate(void) {
+    uint32_t elapsedUs = Timebase_now() - startUs;
+    
+    if (elapsedUs == 0) return 0;
+    return (uint32_t)((uint64_t)sampleCount * 1000000 / elapsedUs);
+}
+
+/**
+ * VL53L0X_Scheduler_Stop
+ * ----------
+ * @brief  Stop continuous ranging on every scheduled sensor.
+ */
+void VL53L0X_Scheduler_Stop(void) {
+    for (int i = 0; i < sensorCount; i++) {
+        VL53L0X_StopMeasurement(&deviceList[i].device);
+    }
+    sensorCount = 0;
+}
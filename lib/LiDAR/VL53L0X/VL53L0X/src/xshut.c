@@ -16,8 +16,21 @@
 #include <stdint.h>
 #include "tm4c123gh6pm.h"
 #include "VL53L0X.h"
+#include "xshut.h"
+
+/*
+ *  Sensor | XSHUT | GPIO1
+ *  ------ | ----- | -----
+ *     0   |  PE0  |  PC4
+ *     1   |  PE1  |  PC5
+ *     2   |  PE2  |  PC6
+ *     3   |  PE3  |  PC7
+ */
+#define GPIO1_PINS  0xF0                                   // PC4-7
+#define GPIO1_SHIFT 4                                      // sensor 0 is on PC4
 
 uint8_t mask = 0x01;
+volatile uint8_t gpio1Ready[XSHUT_SENSOR_COUNT];           // set on GPIO1 falling edge
 
 void xshut_Init(void) {
     /* Port E Activation */
@@ -49,4 +62,43 @@ void xshut_Switch(void) {
     delay(50);
 }
 
+void gpio1_Init(void) {
+    /* Port C Activation */
+    SYSCTL_RCGCGPIO_R |= SYSCTL_RCGCGPIO_R2;               // enable GPIO Port C clock
+    while((SYSCTL_PRGPIO_R & SYSCTL_PRGPIO_R2) == 0){};    // allow time for activating
+    
+    /* Port C Set Up, leave PC0-3 alone, they are JTAG */
+    GPIO_PORTC_DIR_R &= ~GPIO1_PINS;                       // make PC4-7 input
+    GPIO_PORTC_AMSEL_R &= ~GPIO1_PINS;                     // disable analog on PC4-7
+    GPIO_PORTC_PCTL_R &= ((~GPIO_PCTL_PC4_M) &             // configure PC4 as GPIO
+                          (~GPIO_PCTL_PC5_M) &             // configure PC5 as GPIO
+                          (~GPIO_PCTL_PC6_M) &             // configure PC6 as GPIO
+                          (~GPIO_PCTL_PC7_M));             // configure PC7 as GPIO
+    GPIO_PORTC_AFSEL_R &= ~GPIO1_PINS;                     // disable alt functtion on PC4-7
+    GPIO_PORTC_PUR_R |= GPIO1_PINS;                        // GPIO1 is open drain, pull up
+    GPIO_PORTC_DEN_R |= GPIO1_PINS;                        // enable digital I/O on PC4-7
+    
+    /* Falling Edge Interrupt, VL53L0X pulls GPIO1 low on new sample */
+    GPIO_PORTC_IS_R &= ~GPIO1_PINS;                        // edge sensitive
+    GPIO_PORTC_IBE_R &= ~GPIO1_PINS;                       // not both edges
+    GPIO_PORTC_IEV_R &= ~GPIO1_PINS;                       // falling edge
+    GPIO_PORTC_ICR_R = GPIO1_PINS;                         // clear stale flags
+    GPIO_PORTC_IM_R |= GPIO1_PINS;                         // arm interrupt on PC4-7
+    NVIC_PRI0_R = (NVIC_PRI0_R & 0xFF00FFFF) | 0x00600000; // Port C (IRQ 2) priority 3
+    NVIC_EN0_R = 1 << 2;                                   // enable IRQ 2 in NVIC
+}
+
+volatile uint8_t* gpio1_getFlag(int index) {
+    return &gpio1Ready[index];
+}
+
+void GPIOPortC_Handler(void) {
+    uint32_t status = GPIO_PORTC_MIS_R & GPIO1_PINS;       // pins that fired
+    
+    GPIO_PORTC_ICR_R = status;                             // acknowledge them
+    for (int i = 0; i < XSHUT_SENSOR_COUNT; i++) {
+        if (status & (1 << (i + GPIO1_SHIFT))) gpio1Ready[i] = 1;
+    }
+}
+
 
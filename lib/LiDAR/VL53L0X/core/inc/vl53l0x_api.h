@@ -421,7 +421,7 @@ VL53L0X_API VL53L0X_Error VL53L0X_DataInit(VL53L0X_DEV Dev);
  * @return  "Other error code"    See ::VL53L0X_Error
  */
 VL53L0X_API VL53L0X_Error VL53L0X_SetTuningSettingBuffer(VL53L0X_DEV Dev,
-	uint8_t *pTuningSettingBuffer, uint8_t UseInternalTuningSettings);
+	const uint8_t *pTuningSettingBuffer, uint8_t UseInternalTuningSettings);
 
 /**
  * @brief Get the tuning settings pointer and the internal external switch
@@ -441,7 +441,7 @@ VL53L0X_API VL53L0X_Error VL53L0X_SetTuningSettingBuffer(VL53L0X_DEV Dev,
  * @return  "Other error code"         See ::VL53L0X_Error
  */
 VL53L0X_API VL53L0X_Error VL53L0X_GetTuningSettingBuffer(VL53L0X_DEV Dev,
-	uint8_t **ppTuningSettingBuffer, uint8_t *pUseInternalTuningSettings);
+	const uint8_t **ppTuningSettingBuffer, uint8_t *pUseInternalTuningSettings);
 
 /**
  * @brief Do basic device init (and eventually patch loading)
@@ -610,6 +610,47 @@ VL53L0X_API VL53L0X_Error VL53L0X_SetRangeFractionEnable(VL53L0X_DEV Dev,
 VL53L0X_API VL53L0X_Error VL53L0X_GetFractionEnable(VL53L0X_DEV Dev,
 	uint8_t *pEnable);
 
+/**
+ * @brief  Set how much of the range status is decoded per sample
+ *
+ * @par Function Description
+ * Selects the work @a VL53L0X_GetRangingMeasurementData does to build
+ * RangeStatus. The full level re-reads the signal ref rate from page 1 and
+ * runs the sigma estimate (with DMax) on every sample. The lite level only
+ * runs the limit checks computed from the result registers, the raw level
+ * maps the device range status alone. Below the full level no extra I2C
+ * access is done, the sigma and signal ref clip checks are not evaluated,
+ * LastSignalRefMcps keeps its last value and RangeDMaxMilliMeter is 0.
+ *
+ * @note This function doesn't Access to the device
+ *
+ * @param   Dev                   Device Handle
+ * @param   DecodeLevel           New decode level
+ *                                Valid values are:
+ *                                VL53L0X_RANGEDECODELEVEL_RAW
+ *                                VL53L0X_RANGEDECODELEVEL_LITE
+ *                                VL53L0X_RANGEDECODELEVEL_FULL (default)
+ *
+ * @return  VL53L0X_ERROR_NONE               Success
+ * @return  VL53L0X_ERROR_INVALID_PARAMS     This error occurs when
+ * DecodeLevel is not in the supported list
+ */
+VL53L0X_API VL53L0X_Error VL53L0X_SetRangeDecodeLevel(VL53L0X_DEV Dev,
+	VL53L0X_RangeDecodeLevel DecodeLevel);
+
+/**
+ * @brief  Get the current range status decode level
+ *
+ * @note This function doesn't Access to the device
+ *
+ * @param   Dev                   Device Handle
+ * @param   pDecodeLevel          Pointer to the current decode level
+ *
+ * @return  VL53L0X_ERROR_NONE               Success
+ */
+VL53L0X_API VL53L0X_Error VL53L0X_GetRangeDecodeLevel(VL53L0X_DEV Dev,
+	VL53L0X_RangeDecodeLevel *pDecodeLevel);
+
 /**
  * @brief  Set a new Histogram mode
  * @par Function Description
@@ -1545,6 +1586,29 @@ VL53L0X_API VL53L0X_Error VL53L0X_GetHistogramMeasurementData(VL53L0X_DEV Dev,
 VL53L0X_API VL53L0X_Error VL53L0X_PerformSingleRangingMeasurement(VL53L0X_DEV Dev,
 	VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
 
+/**
+ * @brief Performs a single ranging measurement with the least bus traffic
+ *
+ * @par Function Description
+ * Same result as @a VL53L0X_PerformSingleRangingMeasurement(). The device
+ * mode and the stop variable sequence are set on the first call only and
+ * kept until the device mode changes or a measurement is stopped. Each
+ * call then starts the measurement, sleeps through most of the timing
+ * budget, polls data ready, reads the result and clears the interrupt.
+ *
+ * @note This function Access to the device
+ *
+ * @note This function change the device mode to
+ * VL53L0X_DEVICEMODE_SINGLE_RANGING
+ *
+ * @param   Dev                       Device Handle
+ * @param   pRangingMeasurementData   Pointer to the data structure to fill up.
+ * @return  VL53L0X_ERROR_NONE         Success
+ * @return  "Other error code"        See ::VL53L0X_Error
+ */
+VL53L0X_API VL53L0X_Error VL53L0X_PerformSingleRangingFast(VL53L0X_DEV Dev,
+	VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
+
 /**
  * @brief Performs a single histogram measurement and retrieve the histogram
  * measurement data
@@ -37,6 +37,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 extern "C" {
 #endif
 
+/* register scripts that open and close the private register page */
+extern const uint8_t VL53L0X_PrivatePageEnter[6];
+extern const uint8_t VL53L0X_PrivatePageExit[6];
+
+/* write the stop variable to 0x91 inside the private page */
+VL53L0X_Error VL53L0X_WriteStopVariable(VL53L0X_DEV Dev);
 
 VL53L0X_Error VL53L0X_reverse_bytes(uint8_t *data, uint32_t size);
 
@@ -75,7 +81,7 @@ VL53L0X_Error VL53L0X_get_measurement_timing_budget_micro_seconds(VL53L0X_DEV De
 		uint32_t *pMeasurementTimingBudgetMicroSeconds);
 
 VL53L0X_Error VL53L0X_load_tuning_settings(VL53L0X_DEV Dev,
-		uint8_t *pTuningSettingBuffer);
+		const uint8_t *pTuningSettingBuffer);
 
 VL53L0X_Error VL53L0X_calc_sigma_estimate(VL53L0X_DEV Dev,
 		VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
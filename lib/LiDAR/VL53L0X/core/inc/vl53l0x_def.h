@@ -191,6 +191,23 @@ typedef uint8_t VL53L0X_DeviceModes;
 /** @} VL53L0X_define_DeviceModes_group */
 
 
+/** @defgroup VL53L0X_define_RangeDecodeLevel_group Defines the range
+ *	status decode level
+ *	Defines how much of the PAL range status is computed per sample
+ *	@{
+ */
+typedef uint8_t VL53L0X_RangeDecodeLevel;
+
+#define VL53L0X_RANGEDECODELEVEL_RAW		((VL53L0X_RangeDecodeLevel) 0)
+	/*!< Range and device range status only, no limit check evaluated */
+#define VL53L0X_RANGEDECODELEVEL_LITE		((VL53L0X_RangeDecodeLevel) 1)
+	/*!< Adds the limit checks computed from the result registers already
+	 * read (range ignore threshold), no I2C access and no sigma */
+#define VL53L0X_RANGEDECODELEVEL_FULL		((VL53L0X_RangeDecodeLevel) 2)
+	/*!< Full PAL range status: signal ref read, sigma and DMax */
+/** @} VL53L0X_define_RangeDecodeLevel_group */
+
+
 
 /** @defgroup VL53L0X_define_HistogramModes_group Defines Histogram modes
  *	Defines all possible Histogram modes for the device
@@ -465,6 +482,10 @@ typedef struct {
 	* e.g. 500 = 5.0ns */
 	uint8_t StopVariable;
 	/*!< StopVariable used during the stop sequence */
+	uint8_t FastRangingReady;
+	/*!< 1 while the setup of VL53L0X_PerformSingleRangingFast is on the device */
+	VL53L0X_RangeDecodeLevel RangeDecodeLevel;
+	/*!< How much of the PAL range status is computed per sample */
 	uint16_t targetRefRate;
 	/*!< Target Ambient Rate for Ref spad management */
 	FixPoint1616_t SigmaEstimate;
@@ -474,7 +495,7 @@ typedef struct {
 	/*!< Signal Estimate - based on ambient & VCSEL rates and cross talk */
 	FixPoint1616_t LastSignalRefMcps;
 	/*!< Latest Signal ref in Mcps */
-	uint8_t *pTuningSettingsPointer;
+	const uint8_t *pTuningSettingsPointer;
 	/*!< Pointer for Tuning Settings table */
 	uint8_t UseInternalTuningSettings;
 	/*!< Indicate if we use	 Tuning Settings table */
@@ -436,14 +436,14 @@ VL53L0X_Error VL53L0X_DataInit(VL53L0X_DEV Dev)
 	/* Use internal default settings */
 	PALDevDataSet(Dev, UseInternalTuningSettings, 1);
 
-	Status |= VL53L0X_WrByte(Dev, 0x80, 0x01);
-	Status |= VL53L0X_WrByte(Dev, 0xFF, 0x01);
-	Status |= VL53L0X_WrByte(Dev, 0x00, 0x00);
+	Status |= VL53L0X_WrScript(Dev, VL53L0X_PrivatePageEnter,
+		VL53L0X_SCRIPT_LENGTH(VL53L0X_PrivatePageEnter));
 	Status |= VL53L0X_RdByte(Dev, 0x91, &StopVariable);
 	PALDevDataSet(Dev, StopVariable, StopVariable);
-	Status |= VL53L0X_WrByte(Dev, 0x00, 0x01);
-	Status |= VL53L0X_WrByte(Dev, 0xFF, 0x00);
-	Status |= VL53L0X_WrByte(Dev, 0x80, 0x00);
+	PALDevDataSet(Dev, FastRangingReady, 0);
+	PALDevDataSet(Dev, RangeDecodeLevel, VL53L0X_RANGEDECODELEVEL_FULL);
+	Status |= VL53L0X_WrScript(Dev, VL53L0X_PrivatePageExit,
+		VL53L0X_SCRIPT_LENGTH(VL53L0X_PrivatePageExit));
 
 	/* Enable all check */
 	for (i = 0; i < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; i++) {
@@ -515,7 +515,7 @@ VL53L0X_Error VL53L0X_DataInit(VL53L0X_DEV Dev)
 }
 
 VL53L0X_Error VL53L0X_SetTuningSettingBuffer(VL53L0X_DEV Dev,
-	uint8_t *pTuningSettingBuffer, uint8_t UseInternalTuningSettings)
+	const uint8_t *pTuningSettingBuffer, uint8_t UseInternalTuningSettings)
 {
 	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
 
@@ -542,7 +542,7 @@ VL53L0X_Error VL53L0X_SetTuningSettingBuffer(VL53L0X_DEV Dev,
 }
 
 VL53L0X_Error VL53L0X_GetTuningSettingBuffer(VL53L0X_DEV Dev,
-	uint8_t **ppTuningSettingBuffer, uint8_t *pUseInternalTuningSettings)
+	const uint8_t **ppTuningSettingBuffer, uint8_t *pUseInternalTuningSettings)
 {
 	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
 
@@ -560,7 +560,7 @@ VL53L0X_Error VL53L0X_StaticInit(VL53L0X_DEV Dev)
 {
 	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
 	VL53L0X_DeviceParameters_t CurrentParameters = {0};
-	uint8_t *pTuningSettingBuffer;
+	const uint8_t *pTuningSettingBuffer;
 	uint16_t tempword = 0;
 	uint8_t tempbyte = 0;
 	uint8_t UseInternalTuningSettings = 0;
@@ -916,6 +916,7 @@ VL53L0X_Error VL53L0X_SetDeviceMode(VL53L0X_DEV Dev, VL53L0X_DeviceModes DeviceM
 	case VL53L0X_DEVICEMODE_GPIO_OSC:
 		/* Supported modes */
 		VL53L0X_SETPARAMETERFIELD(Dev, DeviceMode, DeviceMode);
+		PALDevDataSet(Dev, FastRangingReady, 0);
 		break;
 	default:
 		/* Unsupported mode */
@@ -967,6 +968,39 @@ VL53L0X_Error VL53L0X_GetFractionEnable(VL53L0X_DEV Dev, uint8_t *pEnabled)
 	return Status;
 }
 
+VL53L0X_Error VL53L0X_SetRangeDecodeLevel(VL53L0X_DEV Dev,
+	VL53L0X_RangeDecodeLevel DecodeLevel)
+{
+	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+
+	LOG_FUNCTION_START("%d", (int)DecodeLevel);
+
+	switch (DecodeLevel) {
+	case VL53L0X_RANGEDECODELEVEL_RAW:
+	case VL53L0X_RANGEDECODELEVEL_LITE:
+	case VL53L0X_RANGEDECODELEVEL_FULL:
+		PALDevDataSet(Dev, RangeDecodeLevel, DecodeLevel);
+		break;
+	default:
+		Status = VL53L0X_ERROR_INVALID_PARAMS;
+	}
+
+	LOG_FUNCTION_END(Status);
+	return Status;
+}
+
+VL53L0X_Error VL53L0X_GetRangeDecodeLevel(VL53L0X_DEV Dev,
+	VL53L0X_RangeDecodeLevel *pDecodeLevel)
+{
+	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+	LOG_FUNCTION_START("");
+
+	*pDecodeLevel = PALDevDataGet(Dev, RangeDecodeLevel);
+
+	LOG_FUNCTION_END(Status);
+	return Status;
+}
+
 VL53L0X_Error VL53L0X_SetHistogramMode(VL53L0X_DEV Dev,
 	VL53L0X_HistogramModes HistogramMode)
 {
@@ -2223,13 +2257,9 @@ VL53L0X_Error VL53L0X_StartMeasurement(VL53L0X_DEV Dev)
 	/* Get Current DeviceMode */
 	VL53L0X_GetDeviceMode(Dev, &DeviceMode);
 
-	Status = VL53L0X_WrByte(Dev, 0x80, 0x01);
-	Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
-	Status = VL53L0X_WrByte(Dev, 0x00, 0x00);
-	Status = VL53L0X_WrByte(Dev, 0x91, PALDevDataGet(Dev, StopVariable));
-	Status = VL53L0X_WrByte(Dev, 0x00, 0x01);
-	Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
-	Status = VL53L0X_WrByte(Dev, 0x80, 0x00);
+	Status = VL53L0X_WriteStopVariable(Dev);
+
+	VL53L0X_StampStart(Dev);
 
 	switch (DeviceMode) {
 	case VL53L0X_DEVICEMODE_SINGLE_RANGING:
@@ -2297,16 +2327,17 @@ VL53L0X_Error VL53L0X_StartMeasurement(VL53L0X_DEV Dev)
 VL53L0X_Error VL53L0X_StopMeasurement(VL53L0X_DEV Dev)
 {
 	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+	static const uint8_t StopScript[] = {
+		VL53L0X_REG_SYSRANGE_START,
+			VL53L0X_REG_SYSRANGE_MODE_SINGLESHOT,
+		0xFF, 0x01,  0x00, 0x00,  0x91, 0x00,
+		0x00, 0x01,  0xFF, 0x00
+	};
 	LOG_FUNCTION_START("");
 
-	Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START,
-	VL53L0X_REG_SYSRANGE_MODE_SINGLESHOT);
-
-	Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
-	Status = VL53L0X_WrByte(Dev, 0x00, 0x00);
-	Status = VL53L0X_WrByte(Dev, 0x91, 0x00);
-	Status = VL53L0X_WrByte(Dev, 0x00, 0x01);
-	Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
+	Status = VL53L0X_WrScript(Dev, StopScript,
+		VL53L0X_SCRIPT_LENGTH(StopScript));
+	PALDevDataSet(Dev, FastRangingReady, 0);
 
 	if (Status == VL53L0X_ERROR_NONE) {
 		/* Set PAL State to Idle */
@@ -2333,7 +2364,12 @@ VL53L0X_Error VL53L0X_GetMeasurementDataReady(VL53L0X_DEV Dev,
 	InterruptConfig = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev,
 		Pin0GpioFunctionality);
 
-	if (InterruptConfig ==
+	if ((InterruptConfig ==
+		VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY) &&
+		(VL53L0X_GetGpio1Ready(Dev, pMeasurementDataReady) ==
+		VL53L0X_ERROR_NONE)) {
+		/* GPIO1 interrupt already told us, no I2C access needed */
+	} else if (InterruptConfig ==
 		VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY) {
 		Status = VL53L0X_GetInterruptMaskStatus(Dev, &InterruptMask);
 		if (InterruptMask ==
@@ -2352,6 +2388,9 @@ VL53L0X_Error VL53L0X_GetMeasurementDataReady(VL53L0X_DEV Dev,
 		}
 	}
 
+	if ((Status == VL53L0X_ERROR_NONE) && (*pMeasurementDataReady == 1))
+		VL53L0X_StampReady(Dev);
+
 	LOG_FUNCTION_END(Status);
 	return Status;
 }
@@ -2400,15 +2439,15 @@ VL53L0X_Error VL53L0X_GetRangingMeasurementData(VL53L0X_DEV Dev,
 	if (Status == VL53L0X_ERROR_NONE) {
 
 		pRangingMeasurementData->ZoneId = 0; /* Only one zone */
-		pRangingMeasurementData->TimeStamp = 0; /* Not Implemented */
+		/* data ready time, MeasurementTimeUsec is the time since start */
+		VL53L0X_GetStamps(Dev, &pRangingMeasurementData->TimeStamp,
+			&pRangingMeasurementData->MeasurementTimeUsec);
 
 		tmpuint16 = VL53L0X_MAKEUINT16(localBuffer[11], localBuffer[10]);
 		/* cut1.1 if SYSTEM__RANGE_CONFIG if 1 range is 2bits fractional
 		 *(format 11.2) else no fractional
 		 */
 
-		pRangingMeasurementData->MeasurementTimeUsec = 0;
-
 		SignalRate = VL53L0X_FIXPOINT97TOFIXPOINT1616(
 			VL53L0X_MAKEUINT16(localBuffer[7], localBuffer[6]));
 		/* peak_signal_count_rate_rtn_mcps */
@@ -2574,6 +2613,56 @@ VL53L0X_Error VL53L0X_PerformSingleRangingMeasurement(VL53L0X_DEV Dev,
 	return Status;
 }
 
+/* wake up this fraction of the timing budget early and poll the rest */
+#define VL53L0X_FAST_WAKE_EARLY 8
+
+VL53L0X_Error VL53L0X_PerformSingleRangingFast(VL53L0X_DEV Dev,
+	VL53L0X_RangingMeasurementData_t *pRangingMeasurementData)
+{
+	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+	uint32_t BudgetUs;
+	LOG_FUNCTION_START("");
+
+	/* Mode and stop variable only need to be set once, until the mode
+	 * changes or a stop sequence clears 0x91 */
+	if (PALDevDataGet(Dev, FastRangingReady) == 0) {
+		Status = VL53L0X_SetDeviceMode(Dev,
+			VL53L0X_DEVICEMODE_SINGLE_RANGING);
+
+		if (Status == VL53L0X_ERROR_NONE) {
+			Status = VL53L0X_WriteStopVariable(Dev);
+		}
+
+		if (Status == VL53L0X_ERROR_NONE)
+			PALDevDataSet(Dev, FastRangingReady, 1);
+	}
+
+	/* Start, the start bit is not polled, data ready covers it */
+	if (Status == VL53L0X_ERROR_NONE) {
+		VL53L0X_StampStart(Dev);
+		Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START,
+			VL53L0X_REG_SYSRANGE_MODE_START_STOP);
+	}
+
+	/* Sleep through most of the timing budget instead of polling it */
+	if (Status == VL53L0X_ERROR_NONE) {
+		BudgetUs = PALDevDataGet(Dev, CurrentParameters)
+			.MeasurementTimingBudgetMicroSeconds;
+		VL53L0X_SleepUs(Dev, BudgetUs - BudgetUs / VL53L0X_FAST_WAKE_EARLY);
+		Status = VL53L0X_measurement_poll_for_completion(Dev);
+	}
+
+	if (Status == VL53L0X_ERROR_NONE)
+		Status = VL53L0X_GetRangingMeasurementData(Dev,
+			pRangingMeasurementData);
+
+	if (Status == VL53L0X_ERROR_NONE)
+		Status = VL53L0X_ClearInterruptMask(Dev, 0);
+
+	LOG_FUNCTION_END(Status);
+	return Status;
+}
+
 VL53L0X_Error VL53L0X_SetNumberOfROIZones(VL53L0X_DEV Dev,
 	uint8_t NumberOfROIZones)
 {
@@ -2623,6 +2712,14 @@ VL53L0X_Error VL53L0X_SetGpioConfig(VL53L0X_DEV Dev, uint8_t Pin,
 {
 	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
 	uint8_t data;
+	static const uint8_t GpioOscScript[] = {
+		0xff, 0x01,  0x00, 0x00,
+		0xff, 0x00,  0x80, 0x01,  0x85, 0x02,
+		0xff, 0x04,  0xcd, 0x00,  0xcc, 0x11,
+		0xff, 0x07,  0xbe, 0x00,
+		0xff, 0x06,  0xcc, 0x09,
+		0xff, 0x00,  0xff, 0x01,  0x00, 0x00
+	};
 
 	LOG_FUNCTION_START("");
 
@@ -2639,26 +2736,8 @@ VL53L0X_Error VL53L0X_SetGpioConfig(VL53L0X_DEV Dev, uint8_t Pin,
 
 	} else if (DeviceMode == VL53L0X_DEVICEMODE_GPIO_OSC) {
 
-		Status |= VL53L0X_WrByte(Dev, 0xff, 0x01);
-		Status |= VL53L0X_WrByte(Dev, 0x00, 0x00);
-
-		Status |= VL53L0X_WrByte(Dev, 0xff, 0x00);
-		Status |= VL53L0X_WrByte(Dev, 0x80, 0x01);
-		Status |= VL53L0X_WrByte(Dev, 0x85, 0x02);
-
-		Status |= VL53L0X_WrByte(Dev, 0xff, 0x04);
-		Status |= VL53L0X_WrByte(Dev, 0xcd, 0x00);
-		Status |= VL53L0X_WrByte(Dev, 0xcc, 0x11);
-
-		Status |= VL53L0X_WrByte(Dev, 0xff, 0x07);
-		Status |= VL53L0X_WrByte(Dev, 0xbe, 0x00);
-
-		Status |= VL53L0X_WrByte(Dev, 0xff, 0x06);
-		Status |= VL53L0X_WrByte(Dev, 0xcc, 0x09);
-
-		Status |= VL53L0X_WrByte(Dev, 0xff, 0x00);
-		Status |= VL53L0X_WrByte(Dev, 0xff, 0x01);
-		Status |= VL53L0X_WrByte(Dev, 0x00, 0x00);
+		Status |= VL53L0X_WrScript(Dev, GpioOscScript,
+			VL53L0X_SCRIPT_LENGTH(GpioOscScript));
 
 	} else {
 
@@ -2851,14 +2930,7 @@ VL53L0X_Error VL53L0X_GetStopCompletedStatus(VL53L0X_DEV Dev,
 	*pStopStatus = Byte;
 	
 	if (Byte == 0) {
-		Status = VL53L0X_WrByte(Dev, 0x80, 0x01);
-		Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
-		Status = VL53L0X_WrByte(Dev, 0x00, 0x00);
-		Status = VL53L0X_WrByte(Dev, 0x91,
-			PALDevDataGet(Dev, StopVariable));
-		Status = VL53L0X_WrByte(Dev, 0x00, 0x01);
-		Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
-		Status = VL53L0X_WrByte(Dev, 0x80, 0x00);
+		Status = VL53L0X_WriteStopVariable(Dev);
 	}
 
 	LOG_FUNCTION_END(Status);
@@ -2873,6 +2945,9 @@ VL53L0X_Error VL53L0X_ClearInterruptMask(VL53L0X_DEV Dev, uint32_t InterruptMask
 	uint8_t Byte;
 	LOG_FUNCTION_START("");
 
+	/* drop the GPIO1 flag first, the next sample may fire right after */
+	VL53L0X_ClearGpio1Ready(Dev);
+
 	/* clear bit 0 range interrupt, bit 1 error interrupt */
 	LoopCount = 0;
 	do {
@@ -41,6 +41,28 @@
 #define LOG_FUNCTION_END_FMT(status, fmt, ...) \
 	_LOG_FUNCTION_END_FMT(TRACE_MODULE_API, status, fmt, ##__VA_ARGS__)
 
+#define VL53L0X_TUNING_SCRIPT_SIZE 16
+#define VL53L0X_TUNING_BURST_SIZE 16
+
+const uint8_t VL53L0X_PrivatePageEnter[6] = {
+	0x80, 0x01,  0xFF, 0x01,  0x00, 0x00
+};
+
+const uint8_t VL53L0X_PrivatePageExit[6] = {
+	0x00, 0x01,  0xFF, 0x00,  0x80, 0x00
+};
+
+VL53L0X_Error VL53L0X_WriteStopVariable(VL53L0X_DEV Dev)
+{
+	uint8_t Script[] = {
+		0x80, 0x01,  0xFF, 0x01,  0x00, 0x00,  0x91, 0x00,
+		0x00, 0x01,  0xFF, 0x00,  0x80, 0x00
+	};
+
+	Script[7] = PALDevDataGet(Dev, StopVariable);
+	return VL53L0X_WrScript(Dev, Script, VL53L0X_SCRIPT_LENGTH(Script));
+}
+
 VL53L0X_Error VL53L0X_reverse_bytes(uint8_t *data, uint32_t size)
 {
 	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
@@ -230,6 +252,10 @@ VL53L0X_Error VL53L0X_get_info_from_device(VL53L0X_DEV Dev, uint8_t option)
 	uint8_t ReadDataFromDeviceDone;
 	FixPoint1616_t SignalRateMeasFixed400mmFix = 0;
 	uint8_t NvmRefGoodSpadMap[VL53L0X_REF_SPAD_BUFFER_SIZE];
+	uint8_t CloseScript[] = {
+		0x83, 0x00,  0xFF, 0x01,  0x00, 0x01,
+		0xFF, 0x00,  0x80, 0x00
+	};
 	int i;
 
 
@@ -242,9 +268,8 @@ VL53L0X_Error VL53L0X_get_info_from_device(VL53L0X_DEV Dev, uint8_t option)
 	 * datainit is done*/
 	if (ReadDataFromDeviceDone != 7) {
 
-		Status |= VL53L0X_WrByte(Dev, 0x80, 0x01);
-		Status |= VL53L0X_WrByte(Dev, 0xFF, 0x01);
-		Status |= VL53L0X_WrByte(Dev, 0x00, 0x00);
+		Status |= VL53L0X_WrScript(Dev, VL53L0X_PrivatePageEnter,
+			VL53L0X_SCRIPT_LENGTH(VL53L0X_PrivatePageEnter));
 
 		Status |= VL53L0X_WrByte(Dev, 0xFF, 0x06);
 		Status |= VL53L0X_RdByte(Dev, 0x83, &byte);
@@ -396,12 +421,9 @@ VL53L0X_Error VL53L0X_get_info_from_device(VL53L0X_DEV Dev, uint8_t option)
 		Status |= VL53L0X_WrByte(Dev, 0x81, 0x00);
 		Status |= VL53L0X_WrByte(Dev, 0xFF, 0x06);
 		Status |= VL53L0X_RdByte(Dev, 0x83, &byte);
-		Status |= VL53L0X_WrByte(Dev, 0x83, byte&0xfb);
-		Status |= VL53L0X_WrByte(Dev, 0xFF, 0x01);
-		Status |= VL53L0X_WrByte(Dev, 0x00, 0x01);
-
-		Status |= VL53L0X_WrByte(Dev, 0xFF, 0x00);
-		Status |= VL53L0X_WrByte(Dev, 0x80, 0x00);
+		CloseScript[1] = byte&0xfb;
+		Status |= VL53L0X_WrScript(Dev, CloseScript,
+			VL53L0X_SCRIPT_LENGTH(CloseScript));
 	}
 
 	if ((Status == VL53L0X_ERROR_NONE) &&
@@ -1350,7 +1372,7 @@ VL53L0X_Error VL53L0X_get_measurement_timing_budget_micro_seconds(VL53L0X_DEV De
 
 
 VL53L0X_Error VL53L0X_load_tuning_settings(VL53L0X_DEV Dev,
-		uint8_t *pTuningSettingBuffer)
+		const uint8_t *pTuningSettingBuffer)
 {
 	VL53L0X_Error Status = VL53L0X_ERROR_NONE;
 	int i;
@@ -1360,8 +1382,11 @@ VL53L0X_Error VL53L0X_load_tuning_settings(VL53L0X_DEV Dev,
 	uint8_t SelectParam;
 	uint8_t NumberOfWrites;
 	uint8_t Address;
-	uint8_t localBuffer[4]; /* max */
+	uint8_t localBuffer[VL53L0X_TUNING_BURST_SIZE]; /* max */
 	uint16_t Temp16;
+	/* single byte writes are batched into one register script */
+	uint8_t Script[VL53L0X_TUNING_SCRIPT_SIZE * 2];
+	uint32_t ScriptLength = 0;
 
 	LOG_FUNCTION_START("");
 
@@ -1413,7 +1438,19 @@ VL53L0X_Error VL53L0X_load_tuning_settings(VL53L0X_DEV Dev,
 				Status = VL53L0X_ERROR_INVALID_PARAMS;
 			}
 
-		} else if (NumberOfWrites <= 4) {
+		} else if (NumberOfWrites == 1) {
+			Script[ScriptLength * 2] = *(pTuningSettingBuffer + Index);
+			Index++;
+			Script[ScriptLength * 2 + 1] = *(pTuningSettingBuffer + Index);
+			Index++;
+			ScriptLength++;
+
+			if (ScriptLength == VL53L0X_TUNING_SCRIPT_SIZE) {
+				Status = VL53L0X_WrScript(Dev, Script, ScriptLength);
+				ScriptLength = 0;
+			}
+
+		} else if (NumberOfWrites <= VL53L0X_TUNING_BURST_SIZE) {
 			Address = *(pTuningSettingBuffer + Index);
 			Index++;
 
@@ -1423,14 +1460,24 @@ VL53L0X_Error VL53L0X_load_tuning_settings(VL53L0X_DEV Dev,
 				Index++;
 			}
 
-			Status = VL53L0X_WriteMulti(Dev, Address, localBuffer,
-					NumberOfWrites);
+			/* keep register order, flush pending script first */
+			if (ScriptLength > 0) {
+				Status = VL53L0X_WrScript(Dev, Script, ScriptLength);
+				ScriptLength = 0;
+			}
+
+			if (Status == VL53L0X_ERROR_NONE)
+				Status = VL53L0X_WriteMulti(Dev, Address,
+					localBuffer, NumberOfWrites);
 
 		} else {
 			Status = VL53L0X_ERROR_INVALID_PARAMS;
 		}
 	}
 
+	if ((Status == VL53L0X_ERROR_NONE) && (ScriptLength > 0))
+		Status = VL53L0X_WrScript(Dev, Script, ScriptLength);
+
 	LOG_FUNCTION_END(Status);
 	return Status;
 }
@@ -2048,9 +2095,12 @@ VL53L0X_Error VL53L0X_get_pal_range_status(VL53L0X_DEV Dev,
 	uint8_t Temp8;
 	uint32_t Dmax_mm = 0;
 	FixPoint1616_t LastSignalRefMcps;
+	VL53L0X_RangeDecodeLevel DecodeLevel;
 
 	LOG_FUNCTION_START("");
 
+	DecodeLevel = PALDevDataGet(Dev, RangeDecodeLevel);
+
 
 	/*
 	 * VL53L0X has a good ranging when the value of the
@@ -2075,27 +2125,38 @@ VL53L0X_Error VL53L0X_get_pal_range_status(VL53L0X_DEV Dev,
 		NoneFlag = 0;
 	}
 
-	/* LastSignalRefMcps */
-	if (Status == VL53L0X_ERROR_NONE)
-		Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
+	/*
+	 * Below the full decode level the page 1 signal ref read, the sigma
+	 * estimate and DMax are skipped, the checks that need them are left
+	 * disabled for this sample.
+	 */
+	if (DecodeLevel == VL53L0X_RANGEDECODELEVEL_FULL) {
+		/* LastSignalRefMcps */
+		if (Status == VL53L0X_ERROR_NONE)
+			Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
 
-	if (Status == VL53L0X_ERROR_NONE)
-		Status = VL53L0X_RdWord(Dev,
-			VL53L0X_REG_RESULT_PEAK_SIGNAL_RATE_REF,
-			&tmpWord);
+		if (Status == VL53L0X_ERROR_NONE)
+			Status = VL53L0X_RdWord(Dev,
+				VL53L0X_REG_RESULT_PEAK_SIGNAL_RATE_REF,
+				&tmpWord);
 
-	LastSignalRefMcps = VL53L0X_FIXPOINT97TOFIXPOINT1616(tmpWord);
+		LastSignalRefMcps = VL53L0X_FIXPOINT97TOFIXPOINT1616(tmpWord);
 
-	if (Status == VL53L0X_ERROR_NONE)
-		Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
+		if (Status == VL53L0X_ERROR_NONE)
+			Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
 
-	PALDevDataSet(Dev, LastSignalRefMcps, LastSignalRefMcps);
+		PALDevDataSet(Dev, LastSignalRefMcps, LastSignalRefMcps);
+	} else {
+		LastSignalRefMcps = PALDevDataGet(Dev, LastSignalRefMcps);
+		pRangingMeasurementData->RangeDMaxMilliMeter = 0;
+	}
 
 	/*
 	 * Check if Sigma limit is enabled, if yes then do comparison with limit
 	 * value and put the result back into pPalRangeStatus.
 	 */
-	if (Status == VL53L0X_ERROR_NONE)
+	if ((DecodeLevel == VL53L0X_RANGEDECODELEVEL_FULL) &&
+			(Status == VL53L0X_ERROR_NONE))
 		Status =  VL53L0X_GetLimitCheckEnable(Dev,
 			VL53L0X_CHECKENABLE_SIGMA_FINAL_RANGE,
 			&SigmaLimitCheckEnable);
@@ -2128,7 +2189,8 @@ VL53L0X_Error VL53L0X_get_pal_range_status(VL53L0X_DEV Dev,
 	 * Check if Signal ref clip limit is enabled, if yes then do comparison
 	 * with limit value and put the result back into pPalRangeStatus.
 	 */
-	if (Status == VL53L0X_ERROR_NONE)
+	if ((DecodeLevel == VL53L0X_RANGEDECODELEVEL_FULL) &&
+			(Status == VL53L0X_ERROR_NONE))
 		Status =  VL53L0X_GetLimitCheckEnable(Dev,
 				VL53L0X_CHECKENABLE_SIGNAL_REF_CLIP,
 				&SignalRefClipLimitCheckEnable);
@@ -2153,7 +2215,8 @@ VL53L0X_Error VL53L0X_get_pal_range_status(VL53L0X_DEV Dev,
 	 * EffectiveSpadRtnCount has a format 8.8
 	 * If (Return signal rate < (1.5 x Xtalk x number of Spads)) : FAIL
 	 */
-	if (Status == VL53L0X_ERROR_NONE)
+	if ((DecodeLevel != VL53L0X_RANGEDECODELEVEL_RAW) &&
+			(Status == VL53L0X_ERROR_NONE))
 		Status =  VL53L0X_GetLimitCheckEnable(Dev,
 				VL53L0X_CHECKENABLE_RANGE_IGNORE_THRESHOLD,
 				&RangeIgnoreThresholdLimitCheckEnable);
@@ -2208,13 +2271,15 @@ VL53L0X_Error VL53L0X_get_pal_range_status(VL53L0X_DEV Dev,
 	if (*pPalRangeStatus == 0)
 		pRangingMeasurementData->RangeDMaxMilliMeter = 0;
 
-	/* fill the Limit Check Status */
+	/* fill the Limit Check Status, the raw decode level leaves it as is */
 
-	Status =  VL53L0X_GetLimitCheckEnable(Dev,
+	if (DecodeLevel != VL53L0X_RANGEDECODELEVEL_RAW)
+		Status =  VL53L0X_GetLimitCheckEnable(Dev,
 			VL53L0X_CHECKENABLE_SIGNAL_RATE_FINAL_RANGE,
 			&SignalRateFinalRangeLimitCheckEnable);
 
-	if (Status == VL53L0X_ERROR_NONE) {
+	if ((DecodeLevel != VL53L0X_RANGEDECODELEVEL_RAW) &&
+			(Status == VL53L0X_ERROR_NONE)) {
 		if ((SigmaLimitCheckEnable == 0) || (SigmaLimitflag == 1))
 			Temp8 = 1;
 		else
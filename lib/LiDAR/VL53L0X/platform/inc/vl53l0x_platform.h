@@ -50,6 +50,11 @@ extern "C" {
  *  @{
  */
 
+/** @def VL53L0X_SHADOW_SLOTS
+ * @brief Number of registers kept in the per device shadow, at most 8
+ */
+#define VL53L0X_SHADOW_SLOTS 8
+
 /**
  * @struct  VL53L0X_Dev_t
  * @brief    Generic PAL device type that does link between API and platform abstraction layer
@@ -62,6 +67,19 @@ typedef struct {
     uint8_t   I2cDevAddr;                /*!< i2c device address user specific field */
     uint8_t   comms_type;                /*!< Type of comms : VL53L0X_COMMS_I2C or VL53L0X_COMMS_SPI */
     uint16_t  comms_speed_khz;           /*!< Comms speed [kHz] : typically 400kHz for I2C           */
+    uint8_t   bus;                       /*!< I2C module (0 to 3) the device is wired to user specific field */
+
+    uint8_t   shadow_enable;             /*!< 1 to shadow page select and stable registers user specific field */
+    uint8_t   shadow_valid;              /*!< one bit per shadow slot, set when the slot is known */
+    uint8_t   shadow[VL53L0X_SHADOW_SLOTS]; /*!< last value written to or read from each shadowed register */
+    uint32_t  shadow_hits;               /*!< register reads served from the shadow */
+    uint32_t  shadow_elided;             /*!< I2C transactions dropped thanks to the shadow */
+
+    volatile uint8_t *gpio1_ready;       /*!< set by the GPIO1 edge interrupt, 0 to poll data ready over I2C */
+
+    uint32_t  start_us;                  /*!< Timebase time the current measurement started */
+    uint32_t  ready_us;                  /*!< Timebase time its data ready was seen */
+    uint8_t   ready_stamped;             /*!< 1 once ready_us is set for the current measurement */
 
 } VL53L0X_Dev_t;
 
@@ -212,8 +230,95 @@ VL53L0X_Error VL53L0X_RdDWord(VL53L0X_DEV Dev, uint8_t index, uint32_t *data);
  */
 VL53L0X_Error VL53L0X_UpdateByte(VL53L0X_DEV Dev, uint8_t index, uint8_t AndData, uint8_t OrData);
 
+/**
+ * Write a script of single byte registers as one queued burst
+ *
+ * The script is a byte array of (index, data) pairs written in order, it
+ * stops at the first failed write.
+ * @code
+ * uint8_t script[] = { 0xFF, 0x01,  0x00, 0x00 };
+ * Status = VL53L0X_WrScript(Dev, script, VL53L0X_SCRIPT_LENGTH(script));
+ * @endcode
+ * @param   Dev       Device Handle
+ * @param   pScript   (index, data) byte pairs
+ * @param   count     Number of pairs in the script
+ * @return  VL53L0X_ERROR_NONE        Success
+ * @return  "Other error code"    See ::VL53L0X_Error
+ */
+VL53L0X_Error VL53L0X_WrScript(VL53L0X_DEV Dev, const uint8_t *pScript, uint32_t count);
+
+/** @def VL53L0X_SCRIPT_LENGTH
+ * @brief Number of (index, data) pairs in a script array
+ */
+#define VL53L0X_SCRIPT_LENGTH(script) (sizeof(script) / 2)
+
+/**
+ * Forget every shadowed register value
+ *
+ * Must be called when the device is reset behind the driver's back, for
+ * example through XSHUT.
+ * @param   Dev       Device Handle
+ */
+void VL53L0X_ShadowReset(VL53L0X_DEV Dev);
+
 /** @} end of VL53L0X_registerAccess_group */
 
+
+/**
+ * Read the data ready flag raised by the GPIO1 interrupt
+ *
+ * @param   Dev       Device Handle
+ * @param   pReady    1 when GPIO1 signalled a new sample, 0 otherwise
+ * @return  VL53L0X_ERROR_NONE        Success
+ * @return  VL53L0X_ERROR_NOT_IMPLEMENTED  GPIO1 is not wired, use I2C
+ */
+VL53L0X_Error VL53L0X_GetGpio1Ready(VL53L0X_DEV Dev, uint8_t *pReady);
+
+/**
+ * Clear the data ready flag raised by the GPIO1 interrupt
+ *
+ * Called before the device interrupt is cleared, so the edge of the next
+ * sample is never lost.
+ * @param   Dev       Device Handle
+ */
+void VL53L0X_ClearGpio1Ready(VL53L0X_DEV Dev);
+
+/**
+ * Sleep a known time, ended early by the GPIO1 interrupt when it is used
+ *
+ * @param   Dev       Device Handle
+ * @param   us        microseconds to sleep
+ * @return  VL53L0X_ERROR_NONE        Success
+ */
+VL53L0X_Error VL53L0X_SleepUs(VL53L0X_DEV Dev, uint32_t us);
+
+/**
+ * Stamp the start of a measurement
+ *
+ * @param   Dev       Device Handle
+ */
+void VL53L0X_StampStart(VL53L0X_DEV Dev);
+
+/**
+ * Stamp the first time data ready is seen for the current measurement
+ *
+ * @param   Dev       Device Handle
+ */
+void VL53L0X_StampReady(VL53L0X_DEV Dev);
+
+/**
+ * Get the time stamps of the measurement being read and move on to the next
+ *
+ * In continuous modes the next measurement starts when this one is ready
+ * (back-to-back) or one inter-measurement period after this one started
+ * (timed), so no start stamp is taken for it.
+ * @param   Dev                    Device Handle
+ * @param   pTimeStamp             data ready time in microseconds
+ * @param   pMeasurementTimeUsec   microseconds from start to data ready
+ */
+void VL53L0X_GetStamps(VL53L0X_DEV Dev, uint32_t *pTimeStamp,
+    uint32_t *pMeasurementTimeUsec);
+
     
 /**
  * @brief execute delay in all polling API call
@@ -70,7 +70,34 @@ enum {
 };
 
 
-#ifdef VL53L0X_LOG_ENABLE
+#ifdef VL53L0X_PROFILE
+
+/*
+ * Profiling backend, build with VL53L0X_PROFILE defined. Every
+ * LOG_FUNCTION_START / LOG_FUNCTION_END pair adds the call count and the
+ * inclusive and exclusive cycles of its function to a fixed table, DWT
+ * CYCCNT on the TM4C123 and nanoseconds on a host. Nothing is printed on the
+ * hot path, VL53L0X_ProfDump reads the table out over Serial. Calls must all
+ * come from one context, main loop or interrupt, not both.
+ */
+
+#define VL53L0X_PROF_ENTRIES 128	/* functions tracked, a power of two */
+#define VL53L0X_PROF_DEPTH   16		/* deepest API call nesting tracked */
+
+void VL53L0X_ProfEnter(const char *function);
+void VL53L0X_ProfExit(const char *function);
+void VL53L0X_ProfReset(void);
+void VL53L0X_ProfDump(void);
+
+#define VL53L0X_ErrLog(...) (void)0
+#define _LOG_FUNCTION_START(module, fmt, ... ) \
+        VL53L0X_ProfEnter(__FUNCTION__)
+#define _LOG_FUNCTION_END(module, status, ... ) \
+        VL53L0X_ProfExit(__FUNCTION__)
+#define _LOG_FUNCTION_END_FMT(module, status, fmt, ... ) \
+        VL53L0X_ProfExit(__FUNCTION__)
+
+#elif defined(VL53L0X_LOG_ENABLE)
 
 #include <sys/time.h>
 
@@ -37,6 +37,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vl53l0x_platform.h"
 #include "vl53l0x_i2c_platform.h"
 #include "vl53l0x_api.h"
+#include "Timebase.h"
 
 #define LOG_FUNCTION_START(fmt, ... )           _LOG_FUNCTION_START(TRACE_MODULE_PLATFORM, fmt, ##__VA_ARGS__)
 #define LOG_FUNCTION_END(status, ... )          _LOG_FUNCTION_END(TRACE_MODULE_PLATFORM, status, ##__VA_ARGS__)
@@ -88,6 +89,83 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define VL53L0X_DoneI2CAcces(Dev)    /* todo mutex release */
 
 
+/*
+ * Register shadow
+ *
+ * Slot 0 follows the page select register 0xFF. The other slots hold page 0
+ * registers that only the host changes, they are used only while the page
+ * is known to be 0. A write to a shadowed index on another page drops that
+ * slot, as it may alias the page 0 register.
+ */
+#define VL53L0X_PAGE_SELECT          0xFF
+
+static const uint8_t ShadowIndex[VL53L0X_SHADOW_SLOTS] = {
+    VL53L0X_PAGE_SELECT,
+    0x80,                                            /* private register access */
+    VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG,
+    VL53L0X_REG_SYSTEM_INTERRUPT_CONFIG_GPIO,
+    VL53L0X_REG_MSRC_CONFIG_CONTROL,
+    VL53L0X_REG_GPIO_HV_MUX_ACTIVE_HIGH,
+    0x88,                                            /* I2C mode */
+    VL53L0X_REG_VHV_CONFIG_PAD_SCL_SDA__EXTSUP_HV
+};
+
+static int VL53L0X_ShadowSlot(VL53L0X_DEV Dev, uint8_t index){
+    int slot;
+
+    if (!Dev->shadow_enable)
+        return -1;
+
+    for (slot = 0; slot < VL53L0X_SHADOW_SLOTS; slot++) {
+        if (ShadowIndex[slot] == index)
+            return slot;
+    }
+    return -1;
+}
+
+/* slot value may be used or stored only when the page is known to be 0 */
+static int VL53L0X_ShadowOnPage0(VL53L0X_DEV Dev, int slot){
+    return (slot == 0) ||
+        (((Dev->shadow_valid & 1) != 0) && (Dev->shadow[0] == 0));
+}
+
+static int VL53L0X_ShadowGet(VL53L0X_DEV Dev, uint8_t index, uint8_t *data){
+    int slot = VL53L0X_ShadowSlot(Dev, index);
+
+    if ((slot < 0) || !VL53L0X_ShadowOnPage0(Dev, slot) ||
+        ((Dev->shadow_valid & (1 << slot)) == 0))
+        return 0;
+
+    *data = Dev->shadow[slot];
+    return 1;
+}
+
+static void VL53L0X_ShadowSet(VL53L0X_DEV Dev, uint8_t index, uint8_t data, VL53L0X_Error Status){
+    int slot = VL53L0X_ShadowSlot(Dev, index);
+
+    if (slot < 0)
+        return;
+
+    if ((Status == VL53L0X_ERROR_NONE) && VL53L0X_ShadowOnPage0(Dev, slot)) {
+        Dev->shadow[slot] = data;
+        Dev->shadow_valid |= (1 << slot);
+    } else {
+        Dev->shadow_valid &= ~(1 << slot);
+    }
+}
+
+static void VL53L0X_ShadowDrop(VL53L0X_DEV Dev, uint8_t index, uint32_t count){
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+        VL53L0X_ShadowSet(Dev, index + i, 0, VL53L0X_ERROR_CONTROL_INTERFACE);
+}
+
+void VL53L0X_ShadowReset(VL53L0X_DEV Dev){
+    Dev->shadow_valid = 0;
+}
+
+
 VL53L0X_Error VL53L0X_LockSequenceAccess(VL53L0X_DEV Dev){
     VL53L0X_Error Status = VL53L0X_ERROR_NONE;
 
@@ -113,11 +191,13 @@ VL53L0X_Error VL53L0X_WriteMulti(VL53L0X_DEV Dev, uint8_t index, uint8_t *pdata,
 
 	deviceAddress = Dev->I2cDevAddr;
 
-	status_int = VL53L0X_write_multi(deviceAddress, index, pdata, count);
+	status_int = VL53L0X_write_multi(Dev->bus, deviceAddress, index, pdata, count);
 
 	if (status_int != 0)
 		Status = VL53L0X_ERROR_CONTROL_INTERFACE;
 
+	VL53L0X_ShadowDrop(Dev, index, count);
+
     return Status;
 }
 
@@ -134,7 +214,7 @@ VL53L0X_Error VL53L0X_ReadMulti(VL53L0X_DEV Dev, uint8_t index, uint8_t *pdata,
 
     deviceAddress = Dev->I2cDevAddr;
 
-	status_int = VL53L0X_read_multi(deviceAddress, index, pdata, count);
+	status_int = VL53L0X_read_multi(Dev->bus, deviceAddress, index, pdata, count);
 
 	if (status_int != 0)
 		Status = VL53L0X_ERROR_CONTROL_INTERFACE;
@@ -147,14 +227,76 @@ VL53L0X_Error VL53L0X_WrByte(VL53L0X_DEV Dev, uint8_t index, uint8_t data){
     VL53L0X_Error Status = VL53L0X_ERROR_NONE;
     int32_t status_int;
 	uint8_t deviceAddress;
+	uint8_t shadow;
+
+	if (VL53L0X_ShadowGet(Dev, index, &shadow) && (shadow == data)) {
+		Dev->shadow_elided++;   /* register already holds data */
+		return Status;
+	}
 
     deviceAddress = Dev->I2cDevAddr;
 
-	status_int = VL53L0X_write_byte(deviceAddress, index, data);
+	status_int = VL53L0X_write_byte(Dev->bus, deviceAddress, index, data);
 
 	if (status_int != 0)
 		Status = VL53L0X_ERROR_CONTROL_INTERFACE;
 
+	VL53L0X_ShadowSet(Dev, index, data, Status);
+
+    return Status;
+}
+
+#define VL53L0X_SCRIPT_CHUNK  16
+VL53L0X_Error VL53L0X_WrScript(VL53L0X_DEV Dev, const uint8_t *pScript, uint32_t count){
+    VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+    int32_t status_int;
+	uint8_t deviceAddress;
+	uint8_t Chunk[VL53L0X_SCRIPT_CHUNK * 2];
+	uint32_t ChunkLength;
+	uint32_t i, j;
+	uint8_t shadow;
+
+    deviceAddress = Dev->I2cDevAddr;
+
+	if (!Dev->shadow_enable) {
+		status_int = VL53L0X_write_script(Dev->bus, deviceAddress, pScript, count);
+
+		if (status_int != 0)
+			Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+
+		return Status;
+	}
+
+	/* run the script through the shadow a chunk at a time, dropping
+	 * writes that would not change the register */
+	for (i = 0; (i < count) && (Status == VL53L0X_ERROR_NONE); ) {
+		ChunkLength = 0;
+		for (; (i < count) && (ChunkLength < VL53L0X_SCRIPT_CHUNK); i++) {
+			if (VL53L0X_ShadowGet(Dev, pScript[2 * i], &shadow) &&
+				(shadow == pScript[2 * i + 1])) {
+				Dev->shadow_elided++;
+				continue;
+			}
+			Chunk[2 * ChunkLength] = pScript[2 * i];
+			Chunk[2 * ChunkLength + 1] = pScript[2 * i + 1];
+			ChunkLength++;
+			VL53L0X_ShadowSet(Dev, pScript[2 * i], pScript[2 * i + 1],
+				VL53L0X_ERROR_NONE);
+		}
+
+		if (ChunkLength > 0) {
+			status_int = VL53L0X_write_script(Dev->bus, deviceAddress,
+				Chunk, ChunkLength);
+
+			if (status_int != 0) {
+				Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+				/* unknown how far the script got */
+				for (j = 0; j < ChunkLength; j++)
+					VL53L0X_ShadowDrop(Dev, Chunk[2 * j], 1);
+			}
+		}
+	}
+
     return Status;
 }
 
@@ -165,11 +307,13 @@ VL53L0X_Error VL53L0X_WrWord(VL53L0X_DEV Dev, uint8_t index, uint16_t data){
 
     deviceAddress = Dev->I2cDevAddr;
 
-	status_int = VL53L0X_write_word(deviceAddress, index, data);
+	status_int = VL53L0X_write_word(Dev->bus, deviceAddress, index, data);
 
 	if (status_int != 0)
 		Status = VL53L0X_ERROR_CONTROL_INTERFACE;
 
+	VL53L0X_ShadowDrop(Dev, index, 2);
+
     return Status;
 }
 
@@ -180,11 +324,13 @@ VL53L0X_Error VL53L0X_WrDWord(VL53L0X_DEV Dev, uint8_t index, uint32_t data){
 
     deviceAddress = Dev->I2cDevAddr;
 
-	status_int = VL53L0X_write_dword(deviceAddress, index, data);
+	status_int = VL53L0X_write_dword(Dev->bus, deviceAddress, index, data);
 
 	if (status_int != 0)
 		Status = VL53L0X_ERROR_CONTROL_INTERFACE;
 
+	VL53L0X_ShadowDrop(Dev, index, 4);
+
     return Status;
 }
 
@@ -196,17 +342,28 @@ VL53L0X_Error VL53L0X_UpdateByte(VL53L0X_DEV Dev, uint8_t index, uint8_t AndData
 
     deviceAddress = Dev->I2cDevAddr;
 
-    status_int = VL53L0X_read_byte(deviceAddress, index, &data);
+    if (VL53L0X_ShadowGet(Dev, index, &data)) {
+        Dev->shadow_hits++;                          /* read served from shadow */
+        Dev->shadow_elided++;
+        if (((data & AndData) | OrData) == data) {
+            Dev->shadow_elided++;                    /* write would not change it */
+            return Status;
+        }
+    } else {
+        status_int = VL53L0X_read_byte(Dev->bus, deviceAddress, index, &data);
 
-    if (status_int != 0)
-        Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+        if (status_int != 0)
+            Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+    }
 
     if (Status == VL53L0X_ERROR_NONE) {
         data = (data & AndData) | OrData;
-        status_int = VL53L0X_write_byte(deviceAddress, index, data);
+        status_int = VL53L0X_write_byte(Dev->bus, deviceAddress, index, data);
 
         if (status_int != 0)
             Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+
+        VL53L0X_ShadowSet(Dev, index, data, Status);
     }
 
     return Status;
@@ -217,13 +374,21 @@ VL53L0X_Error VL53L0X_RdByte(VL53L0X_DEV Dev, uint8_t index, uint8_t *data){
     int32_t status_int;
     uint8_t deviceAddress;
 
+    if (VL53L0X_ShadowGet(Dev, index, data)) {
+        Dev->shadow_hits++;
+        Dev->shadow_elided++;
+        return Status;
+    }
+
     deviceAddress = Dev->I2cDevAddr;
 
-    status_int = VL53L0X_read_byte(deviceAddress, index, data);
+    status_int = VL53L0X_read_byte(Dev->bus, deviceAddress, index, data);
 
     if (status_int != 0)
         Status = VL53L0X_ERROR_CONTROL_INTERFACE;
 
+    VL53L0X_ShadowSet(Dev, index, *data, Status);
+
     return Status;
 }
 
@@ -234,7 +399,7 @@ VL53L0X_Error VL53L0X_RdWord(VL53L0X_DEV Dev, uint8_t index, uint16_t *data){
 
     deviceAddress = Dev->I2cDevAddr;
 
-    status_int = VL53L0X_read_word(deviceAddress, index, data);
+    status_int = VL53L0X_read_word(Dev->bus, deviceAddress, index, data);
 
     if (status_int != 0)
         Status = VL53L0X_ERROR_CONTROL_INTERFACE;
@@ -249,7 +414,7 @@ VL53L0X_Error  VL53L0X_RdDWord(VL53L0X_DEV Dev, uint8_t index, uint32_t *data){
 
     deviceAddress = Dev->I2cDevAddr;
 
-    status_int = VL53L0X_read_dword(deviceAddress, index, data);
+    status_int = VL53L0X_read_dword(Dev->bus, deviceAddress, index, data);
 
     if (status_int != 0)
         Status = VL53L0X_ERROR_CONTROL_INTERFACE;
@@ -257,15 +422,70 @@ VL53L0X_Error  VL53L0X_RdDWord(VL53L0X_DEV Dev, uint8_t index, uint32_t *data){
     return Status;
 }
 
-#define VL53L0X_POLLINGDELAY_LOOPNB  250
+VL53L0X_Error VL53L0X_GetGpio1Ready(VL53L0X_DEV Dev, uint8_t *pReady){
+    if (Dev->gpio1_ready == 0)
+        return VL53L0X_ERROR_NOT_IMPLEMENTED;
+
+    *pReady = *Dev->gpio1_ready;
+    return VL53L0X_ERROR_NONE;
+}
+
+void VL53L0X_ClearGpio1Ready(VL53L0X_DEV Dev){
+    if (Dev->gpio1_ready != 0)
+        *Dev->gpio1_ready = 0;
+}
+
+VL53L0X_Error VL53L0X_SleepUs(VL53L0X_DEV Dev, uint32_t us){
+    Timebase_sleepUntil(Timebase_deadline(us), Dev->gpio1_ready);
+    return VL53L0X_ERROR_NONE;
+}
+
+void VL53L0X_StampStart(VL53L0X_DEV Dev){
+    Dev->start_us = Timebase_now();
+    Dev->ready_stamped = 0;
+}
+
+void VL53L0X_StampReady(VL53L0X_DEV Dev){
+    if (Dev->ready_stamped == 0) {
+        Dev->ready_us = Timebase_now();
+        Dev->ready_stamped = 1;
+    }
+}
+
+void VL53L0X_GetStamps(VL53L0X_DEV Dev, uint32_t *pTimeStamp,
+    uint32_t *pMeasurementTimeUsec){
+    VL53L0X_StampReady(Dev);            /* data ready may not have been polled */
+
+    *pTimeStamp = Dev->ready_us;
+    *pMeasurementTimeUsec = Dev->ready_us - Dev->start_us;
+
+    switch (PALDevDataGet(Dev, CurrentParameters).DeviceMode) {
+    case VL53L0X_DEVICEMODE_CONTINUOUS_RANGING:
+        Dev->start_us = Dev->ready_us;
+        break;
+    case VL53L0X_DEVICEMODE_CONTINUOUS_TIMED_RANGING:
+        Dev->start_us += PALDevDataGet(Dev, CurrentParameters).InterMeasurementPeriodMilliSeconds * 1000;
+        break;
+    default:
+        break;
+    }
+    Dev->ready_stamped = 0;
+}
+
+/* VL53L0X_DEFAULT_MAX_LOOP polls of about 500 us plus one I2C read each */
+#define VL53L0X_POLLINGDELAY_US      500
+/* without I2C traffic between polls the delay has to cover the timeout alone */
+#define VL53L0X_GPIO1_DELAY_FACTOR   64
 VL53L0X_Error VL53L0X_PollingDelay(VL53L0X_DEV Dev){
     VL53L0X_Error status = VL53L0X_ERROR_NONE;
-    volatile uint32_t i;
     LOG_FUNCTION_START("");
 
-    for(i=0;i<VL53L0X_POLLINGDELAY_LOOPNB;i++){
-        //Do nothing
-        __asm("nop");
+    if (Dev->gpio1_ready != 0) {
+        /* sleep until GPIO1 fires */
+        Timebase_sleepUntil(Timebase_deadline(VL53L0X_POLLINGDELAY_US*VL53L0X_GPIO1_DELAY_FACTOR),
+                            Dev->gpio1_ready);
+    } else {
+        Timebase_sleepUs(VL53L0X_POLLINGDELAY_US);
     }
 
     LOG_FUNCTION_END(status);
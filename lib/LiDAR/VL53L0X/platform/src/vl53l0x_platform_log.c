@@ -0,0 +1,180 @@
+/*!
+ * @file  vl53l0x_platform_log.c
+ * @brief Profiling backend of LOG_FUNCTION_START / LOG_FUNCTION_END.
+ * ----------
+ * Built only with VL53L0X_PROFILE defined, see vl53l0x_platform_log.h. Each
+ * function is keyed by the address of its __FUNCTION__ string, so entry and
+ * exit cost a hash probe and a few adds. A function that returns without
+ * LOG_FUNCTION_END is closed when its caller ends.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#ifdef VL53L0X_PROFILE
+
+#include <stdint.h>
+#include <string.h>
+#include "vl53l0x_platform_log.h"
+#include "Serial.h"
+#ifdef VL53L0X_HOST
+#include <time.h>
+#define PROF_UNIT "ns"
+#else
+#include "tm4c123gh6pm.h"
+#define PROF_UNIT "cycles"
+#define DWT_CTRL_R      (*((volatile uint32_t *)0xE0001000))
+#define DWT_CYCCNT_R    (*((volatile uint32_t *)0xE0001004))
+#define DEMCR_TRCENA    0x01000000      // NVIC_DBG_INT_R is the DEMCR register
+#define DWT_CYCCNTENA   0x00000001
+#endif
+
+typedef struct {
+    const char* function;               // __FUNCTION__ of the entry, 0 while free
+    uint32_t    calls;
+    uint64_t    inclusive;              // cycles from start to end, callees included
+    uint64_t    exclusive;              // cycles spent in the function itself
+} ProfEntry;
+
+typedef struct {
+    ProfEntry*  entry;
+    uint32_t    start;
+    uint32_t    children;               // inclusive cycles of the callees so far
+} ProfFrame;
+
+static ProfEntry table[VL53L0X_PROF_ENTRIES];
+static ProfFrame stack[VL53L0X_PROF_DEPTH];
+static int       depth = 0;
+static uint32_t  lost = 0;              // calls not recorded, table full or nesting too deep
+#ifndef VL53L0X_HOST
+static uint8_t   started = 0;
+#endif
+
+/**
+ * cycles
+ * ----------
+ * Description: read the cycle counter, start it on first use.
+ */
+static uint32_t cycles(void) {
+#ifdef VL53L0X_HOST
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(now.tv_sec * 1000000000ull + now.tv_nsec);
+#else
+    if (!started) {
+        NVIC_DBG_INT_R |= DEMCR_TRCENA;
+        DWT_CYCCNT_R = 0;
+        DWT_CTRL_R |= DWT_CYCCNTENA;
+        started = 1;
+    }
+    return DWT_CYCCNT_R;
+#endif
+}
+
+/**
+ * lookup
+ * ----------
+ * Description: find or claim the entry of a function, 0 if the table is full.
+ */
+static ProfEntry* lookup(const char* function) {
+    uint32_t slot = ((uintptr_t)function >> 2) & (VL53L0X_PROF_ENTRIES - 1);
+
+    for (int n = 0; n < VL53L0X_PROF_ENTRIES; n++) {
+        ProfEntry* entry = &table[slot];
+
+        if (entry->function == function) return entry;
+        if (entry->function == 0) {
+            entry->function = function;
+            return entry;
+        }
+        slot = (slot + 1) & (VL53L0X_PROF_ENTRIES - 1);
+    }
+
+    return 0;
+}
+
+/**
+ * VL53L0X_ProfEnter
+ * ----------
+ * @param  function  __FUNCTION__ of the function starting.
+ */
+void VL53L0X_ProfEnter(const char* function) {
+    ProfEntry* entry = lookup(function);
+
+    if (entry == 0 || depth == VL53L0X_PROF_DEPTH) {
+        lost++;
+        return;
+    }
+
+    stack[depth].entry = entry;
+    stack[depth].children = 0;
+    stack[depth].start = cycles();                  // last, so the bookkeeping above is not counted
+    depth++;
+}
+
+/**
+ * VL53L0X_ProfExit
+ * ----------
+ * @param  function  __FUNCTION__ of the function ending.
+ */
+void VL53L0X_ProfExit(const char* function) {
+    uint32_t now = cycles();
+    int      top = depth - 1;
+
+    while (top >= 0 && stack[top].entry->function != function) top--;
+    if (top < 0) return;                            // its start was not recorded
+
+    // close the frames above, functions that returned without LOG_FUNCTION_END
+    while (depth > top) {
+        ProfFrame* frame = &stack[--depth];
+        uint32_t   inclusive = now - frame->start;
+
+        frame->entry->calls++;
+        frame->entry->inclusive += inclusive;
+        frame->entry->exclusive += inclusive - frame->children;
+        if (depth > 0) stack[depth - 1].children += inclusive;
+    }
+}
+
+/**
+ * VL53L0X_ProfReset
+ * ----------
+ * @brief  Clear the table, call outside of any API call.
+ */
+void VL53L0X_ProfReset(void) {
+    memset(table, 0, sizeof(table));
+    depth = 0;
+    lost = 0;
+}
+
+/**
+ * VL53L0X_ProfDump
+ * ----------
+ * @brief  Print one line per function over Serial: calls, average inclusive
+ *         and exclusive time per call, and total exclusive time in thousands.
+ */
+void VL53L0X_ProfDump(void) {
+    Serial_println("function, calls, avg inclusive " PROF_UNIT ", avg exclusive " PROF_UNIT
+                   ", total exclusive k" PROF_UNIT);
+
+    for (int i = 0; i < VL53L0X_PROF_ENTRIES; i++) {
+        ProfEntry* entry = &table[i];
+
+        if (entry->function == 0 || entry->calls == 0) continue;
+        Serial_println("%s, %u, %u, %u, %u", (char*)entry->function, entry->calls,
+                       (uint32_t)(entry->inclusive / entry->calls),
+                       (uint32_t)(entry->exclusive / entry->calls),
+                       (uint32_t)(entry->exclusive / 1000));
+    }
+
+    Serial_println("lost, %u", lost);
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*!
+ * @file  VL53L0X_sim.h
+ * @brief Register level VL53L0X simulator for host builds of the driver.
+ * ----------
+ * Stands in for VL53L0X_I2C.c: every VL53L0X_read_multi / VL53L0X_write_multi
+ * lands in a simulated sensor instead of the TM4C123 I2C module. Time is
+ * simulated too, it moves with modelled bus time and with the sleeps of
+ * Timebase_sim.c, which reads this clock, so runs are deterministic.
+ * ----------
+ * ST VL53L0X datasheet: https://www.st.com/resource/en/datasheet/vl53l0x.pdf
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#ifndef __VL53L0X_SIM_H__
+#define __VL53L0X_SIM_H__
+
+#include <stdint.h>
+#include "VL53L0X_calibration.h"
+
+#define VL53L0X_SIM_SENSORS         4       // one simulated sensor per I2C module
+#define VL53L0X_SIM_RANGING_US      30000   // default conversion time of a ranging measurement
+#define VL53L0X_SIM_REF_US          1000    // default conversion time of a reference calibration
+
+#ifndef VL53L0X_CAL_FILE
+#define VL53L0X_CAL_FILE            "vl53l0x_cal.bin"   // file behind VL53L0X_CalStoreFile
+#endif
+
+extern const VL53L0X_CalStore VL53L0X_CalStoreFile;    // host file, see sim/src/VL53L0X_calibration_file.c
+
+/*
+ *  Bus traffic of one sensor, counted per VL53L0X_read_multi / VL53L0X_write_multi.
+ */
+typedef struct {
+    uint32_t transactions;              // reads + writes
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t bytes;                     // data bytes, register index and addresses excluded
+    uint32_t pageSwitches;              // bytes written to 0xFF
+    uint64_t bits;                      // SCL clocks including START, address, ACK and STOP
+} VL53L0X_Sim_Stats;
+
+/**
+ * VL53L0X_Sim_Init
+ * ----------
+ * @brief  Power cycle every simulated sensor and reset the clock to 0.
+ */
+void VL53L0X_Sim_Init(void);
+
+/**
+ * VL53L0X_Sim_setTarget
+ * ----------
+ * @param  bus              I2C module of the sensor.
+ * @param  rangeMilliMeter  distance every following measurement reports.
+ */
+void VL53L0X_Sim_setTarget(uint8_t bus, uint16_t rangeMilliMeter);
+
+/**
+ * VL53L0X_Sim_setLatency
+ * ----------
+ * @param  bus        I2C module of the sensor.
+ * @param  rangingUs  conversion time of a ranging measurement.
+ * @param  refUs      conversion time of a VHV or phase reference calibration.
+ */
+void VL53L0X_Sim_setLatency(uint8_t bus, uint32_t rangingUs, uint32_t refUs);
+
+/**
+ * VL53L0X_Sim_advance
+ * ----------
+ * @param  us  microseconds to move the simulated clock.
+ */
+void VL53L0X_Sim_advance(uint32_t us);
+
+/**
+ * VL53L0X_Sim_getTimeUs
+ * ----------
+ * @return simulated time since VL53L0X_Sim_Init in microseconds.
+ */
+uint64_t VL53L0X_Sim_getTimeUs(void);
+
+/**
+ * VL53L0X_Sim_getSampleCount
+ * ----------
+ * @param  bus  I2C module of the sensor.
+ * ----------
+ * @return ranging measurements the sensor finished since power up.
+ */
+uint32_t VL53L0X_Sim_getSampleCount(uint8_t bus);
+
+/**
+ * VL53L0X_Sim_getRegisters
+ * ----------
+ * @param  bus   I2C module of the sensor.
+ * @param  page  register page, the value written to 0xFF.
+ * ----------
+ * @return the 256 registers of the page, to compare device state between runs.
+ */
+const uint8_t* VL53L0X_Sim_getRegisters(uint8_t bus, uint8_t page);
+
+/**
+ * VL53L0X_Sim_getStats
+ * ----------
+ * @param  bus     I2C module of the sensor.
+ * @param  result  bus traffic since power up or the last VL53L0X_Sim_resetStats.
+ */
+void VL53L0X_Sim_getStats(uint8_t bus, VL53L0X_Sim_Stats* result);
+
+/**
+ * VL53L0X_Sim_resetStats
+ * ----------
+ * @param  bus  I2C module of the sensor.
+ */
+void VL53L0X_Sim_resetStats(uint8_t bus);
+
+/**
+ * VL53L0X_Sim_busTimeUs
+ * ----------
+ * @param  result    bus traffic from VL53L0X_Sim_getStats.
+ * @param  speedKHz  I2C clock to model.
+ * ----------
+ * @return time the traffic keeps the bus busy at speedKHz, clock stretching and gaps excluded.
+ */
+uint32_t VL53L0X_Sim_busTimeUs(const VL53L0X_Sim_Stats* result, uint16_t speedKHz);
+
+#endif
@@ -0,0 +1,47 @@
+/*!
+ * @file  Timebase_sim.c
+ * @brief Timebase.h for host builds against the simulator, over its clock.
+ * ----------
+ * Takes the place of Timebase_host.c. Time only moves with the modelled bus
+ * traffic and the sleeps below, which jump the clock to their deadline, so
+ * runs are deterministic and the driver needs no host branch for its waits.
+ * There are no interrupts here: a wake flag is only seen if it is already set.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include "Timebase.h"
+#include "VL53L0X_sim.h"
+
+void Timebase_Init(void) {}
+
+uint32_t Timebase_now(void) {
+    return (uint32_t)VL53L0X_Sim_getTimeUs();
+}
+
+uint32_t Timebase_deadline(uint32_t us) {
+    return Timebase_now() + us;
+}
+
+int Timebase_expired(uint32_t deadline) {
+    return (int32_t)(Timebase_now() - deadline) >= 0;
+}
+
+int Timebase_sleepUntil(uint32_t deadline, volatile uint8_t* wake) {
+    int32_t remaining;
+
+    if (wake && *wake) return 1;
+
+    remaining = deadline - Timebase_now();
+    if (remaining > 0) VL53L0X_Sim_advance(remaining);
+
+    return 0;
+}
+
+void Timebase_sleepUs(uint32_t us) {
+    Timebase_sleepUntil(Timebase_deadline(us), 0);
+}
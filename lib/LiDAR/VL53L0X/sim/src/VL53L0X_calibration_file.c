@@ -0,0 +1,48 @@
+/*!
+ * @file  VL53L0X_calibration_file.c
+ * @brief VL53L0X calibration store in a file, for host builds.
+ * ----------
+ * Records sit back to back in VL53L0X_CAL_FILE, slot n at byte n * sizeof(VL53L0X_CalRecord).
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "VL53L0X_calibration.h"
+#include "VL53L0X_sim.h"
+
+static int fileRead(uint32_t slot, VL53L0X_CalRecord* record) {
+    FILE* file;
+    int   result = 0;
+
+    if (slot >= VL53L0X_CAL_SLOTS) return 0;
+    if ((file = fopen(VL53L0X_CAL_FILE, "rb")) == NULL) return 0;
+
+    if (fseek(file, slot * sizeof(VL53L0X_CalRecord), SEEK_SET) == 0) {
+        result = fread(record, sizeof(VL53L0X_CalRecord), 1, file) == 1;
+    }
+
+    fclose(file);
+    return result;
+}
+
+static int fileWrite(uint32_t slot, const VL53L0X_CalRecord* record) {
+    FILE* file;
+    int   result = 0;
+
+    if (slot >= VL53L0X_CAL_SLOTS) return 0;
+    if ((file = fopen(VL53L0X_CAL_FILE, "r+b")) == NULL &&     // keep the other slots
+        (file = fopen(VL53L0X_CAL_FILE, "w+b")) == NULL) return 0;
+
+    if (fseek(file, slot * sizeof(VL53L0X_CalRecord), SEEK_SET) == 0) {
+        result = fwrite(record, sizeof(VL53L0X_CalRecord), 1, file) == 1;
+    }
+
+    return fclose(file) == 0 && result;
+}
+
+const VL53L0X_CalStore VL53L0X_CalStoreFile = { fileRead, fileWrite };
@@ -0,0 +1,66 @@
+/*!
+ * @file  VL53L0X_host.c
+ * @brief Host stand-ins for the TM4C123 pieces the VL53L0X driver calls: PLL and Serial.
+ * ----------
+ * Serial goes to stderr so a host program can keep stdout for its own results.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include "PLL.h"
+#include "Serial.h"
+
+static uint32_t busClock = 16000000;   // PIOSC until PLL_Init
+
+void PLL_Init(uint32_t freq) {
+    busClock = 400000000 / (freq + 1);
+}
+
+uint32_t PLL_GetBusClock(void) {
+    return busClock;
+}
+
+void Serial_Init(void) {}
+
+void Serial_setTxPolicy(uint8_t policy) {}
+
+uint32_t Serial_getTxDropped(void) {
+    return 0;
+}
+
+void Serial_flush(void) {
+    fflush(stderr);
+}
+
+void Serial_putChar(char data) {
+    fputc(data, stderr);
+}
+
+void Serial_putString(char *str) {
+    fputs(str, stderr);
+}
+
+void Serial_putNewLine(void) {
+    fputc('\n', stderr);
+}
+
+void Serial_print(char* format, ...) {
+    va_list arg_list;
+    va_start(arg_list, format);
+    vfprintf(stderr, format, arg_list);
+    va_end(arg_list);
+}
+
+void Serial_println(char* format, ...) {
+    va_list arg_list;
+    va_start(arg_list, format);
+    vfprintf(stderr, format, arg_list);
+    va_end(arg_list);
+    fputc('\n', stderr);
+}
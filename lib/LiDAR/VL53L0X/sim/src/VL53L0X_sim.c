@@ -0,0 +1,390 @@
+/*!
+ * @file  VL53L0X_sim.c
+ * @brief Register level VL53L0X simulator for host builds of the driver.
+ * ----------
+ * Models what the ST API relies on: paged register file, NVM read through
+ * the 0x94/0x83/0x90 strobe, single, back-to-back and timed ranging with
+ * interrupt status and result registers, reference SPAD signal rate that
+ * grows with the enabled reference SPADs, and address change. Registers
+ * it does not model simply hold what was written.
+ * ----------
+ * ST VL53L0X datasheet: https://www.st.com/resource/en/datasheet/vl53l0x.pdf
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "VL53L0X_I2C.h"
+#include "VL53L0X_sim.h"
+
+#define SIM_DEFAULT_ADDR    0x29
+#define SIM_DEFAULT_KHZ     100
+#define SIM_REF_SPAD_RATE   0x0100              // 2 MCPS per enabled reference SPAD, 9.7 format
+#define SIM_SIGNAL_RATE     0x0500              // 10 MCPS return signal, 9.7 format
+#define SIM_AMBIENT_RATE    0x001A              // 0.2 MCPS ambient, 9.7 format
+#define SIM_EFFECTIVE_SPADS 0x0800              // 8 SPADs, 8.8 format
+#define SIM_RANGE_VALID     ((11 << 3) | 0x01)  // device range status 11 (valid), sample ready
+
+typedef struct {
+    uint8_t  address;                   // 7 bit I2C address the sensor answers to
+    uint8_t  page;                      // last value written to 0xFF
+    uint8_t  regs[256][256];            // [page][register]
+    uint32_t nvm[128];                  // words read through 0x94 / 0x90
+    uint8_t  mode;                      // SYSRANGE_START mode of the running measurement
+    uint64_t doneAt;                    // ns the running measurement finishes, 0 if idle
+    uint32_t rangingUs;
+    uint32_t refUs;
+    uint16_t rangeMilliMeter;
+    uint32_t samples;
+} SimSensor;
+
+static SimSensor sensors[VL53L0X_SIM_SENSORS];
+static uint16_t  busKHz[VL53L0X_SIM_SENSORS];
+static uint64_t  nowNs = 0;
+static VL53L0X_Sim_Stats stats[VL53L0X_SIM_SENSORS];
+
+/****************************************************
+ *                                                  *
+ *                  Sensor Model                    *
+ *                                                  *
+ ****************************************************/
+
+/**
+ * packProductId
+ * ----------
+ * Description: product ID is a stream of 7 bit characters from bit 31 of NVM word 0x77 on.
+ */
+static void packProductId(SimSensor* sensor, const char* id) {
+    uint32_t bit = 0;
+
+    for (; *id; id++) {
+        for (int b = 6; b >= 0; b--, bit++) {
+            if ((*id >> b) & 1) sensor->nvm[0x77 + bit / 32] |= 0x80000000u >> (bit % 32);
+        }
+    }
+}
+
+/**
+ * powerUp
+ * ----------
+ * Description: reset values of what the ST API reads before writing.
+ */
+static void powerUp(SimSensor* sensor, uint8_t index) {
+    memset(sensor, 0, sizeof(*sensor));
+
+    sensor->address = SIM_DEFAULT_ADDR;
+    sensor->rangingUs = VL53L0X_SIM_RANGING_US;
+    sensor->refUs = VL53L0X_SIM_REF_US;
+    sensor->rangeMilliMeter = 500;
+
+    sensor->regs[0][0x01] = 0xFF;                           // SYSTEM_SEQUENCE_CONFIG
+    sensor->regs[0][0x50] = 0x06;                           // PRE_RANGE_CONFIG_VCSEL_PERIOD
+    sensor->regs[0][0x70] = 0x04;                           // FINAL_RANGE_CONFIG_VCSEL_PERIOD
+    sensor->regs[0][0x84] = 0x01;                           // GPIO_HV_MUX_ACTIVE_HIGH
+    sensor->regs[0][0x8A] = SIM_DEFAULT_ADDR;               // I2C_SLAVE_DEVICE_ADDRESS
+    sensor->regs[0][0xC0] = 0xEE;                           // IDENTIFICATION_MODEL_ID
+    sensor->regs[0][0xC1] = 0xAA;
+    sensor->regs[0][0xC2] = 0x10;                           // IDENTIFICATION_REVISION_ID, cut 1.1
+    sensor->regs[1][0x91] = 0x3C;                           // stop variable
+
+    sensor->nvm[0x02] = 0x01000000;                         // module ID
+    sensor->nvm[0x24] = 0xFFFFFFFF;                         // reference good SPAD map
+    sensor->nvm[0x25] = 0xFFFF0000;
+    sensor->nvm[0x6B] = (1u << 15) | (5u << 8);             // 5 aperture reference SPADs
+    sensor->nvm[0x73] = 0x0000000A;                         // signal rate at 400 mm, 0x0A00 in 11.4
+    sensor->nvm[0x74] = 0x00000000;
+    sensor->nvm[0x75] = 0x00000019;                         // distance at 400 mm, 0x1900 in 11.4
+    sensor->nvm[0x76] = 0x00000000;
+    packProductId(sensor, "VL53L0XSIM");
+    sensor->nvm[0x7B] = 0x2A000000 | index;                 // unique part ID, top byte is the revision
+    sensor->nvm[0x7C] = 0x5349D000 | index;
+}
+
+/**
+ * enabledRefSpads
+ * ----------
+ * Description: number of set bits in the reference SPAD enables.
+ */
+static uint32_t enabledRefSpads(SimSensor* sensor) {
+    uint32_t count = 0;
+
+    for (int i = 0xB0; i <= 0xB5; i++) {
+        for (uint8_t b = sensor->regs[0][i]; b; b &= b - 1) count++;
+    }
+
+    return count;
+}
+
+/**
+ * complete
+ * ----------
+ * Description: publish the result of the running measurement.
+ */
+static void complete(SimSensor* sensor) {
+    uint8_t*  regs = sensor->regs[0];
+    uint16_t  refRate = enabledRefSpads(sensor) * SIM_REF_SPAD_RATE;
+
+    if (regs[0x01] == 0x01) regs[0xCB] = 0x1E;              // VHV calibration
+    if (regs[0x01] == 0x02) regs[0xEE] = (regs[0xEE] & 0x80) | 0x0A;    // phase calibration
+
+    regs[0x13] = 0x04;                                      // new sample ready
+    regs[0x14] = SIM_RANGE_VALID;
+    regs[0x16] = SIM_EFFECTIVE_SPADS >> 8;
+    regs[0x17] = SIM_EFFECTIVE_SPADS & 0xFF;
+    regs[0x1A] = SIM_SIGNAL_RATE >> 8;
+    regs[0x1B] = SIM_SIGNAL_RATE & 0xFF;
+    regs[0x1C] = SIM_AMBIENT_RATE >> 8;
+    regs[0x1D] = SIM_AMBIENT_RATE & 0xFF;
+    regs[0x1E] = sensor->rangeMilliMeter >> 8;
+    regs[0x1F] = sensor->rangeMilliMeter & 0xFF;
+    sensor->regs[1][0xB6] = refRate >> 8;                   // RESULT_PEAK_SIGNAL_RATE_REF
+    sensor->regs[1][0xB7] = refRate & 0xFF;
+
+    sensor->samples++;
+}
+
+/**
+ * update
+ * ----------
+ * Description: finish measurements that are due by now, continuous modes start the next one.
+ */
+static void update(SimSensor* sensor) {
+    while (sensor->doneAt && nowNs >= sensor->doneAt) {
+        uint64_t start = sensor->doneAt;
+        uint64_t period;
+
+        complete(sensor);
+
+        if (sensor->mode & 0x02) {                          // back-to-back
+            sensor->doneAt = start + sensor->rangingUs * 1000ull;
+        } else if (sensor->mode & 0x04) {                   // timed, period in ms at 0x04
+            uint8_t* p = &sensor->regs[0][0x04];
+            period = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | (p[2] << 8) | p[3];
+            period *= 1000000ull;
+            if (period < sensor->rangingUs * 1000ull) period = sensor->rangingUs * 1000ull;
+            sensor->doneAt = start + period;
+        } else {
+            sensor->doneAt = 0;                             // single shot
+        }
+    }
+}
+
+/**
+ * writeRegister
+ * ----------
+ * Description: one register write with its side effects.
+ */
+static void writeRegister(SimSensor* sensor, uint8_t index, uint8_t value) {
+    if (index == 0xFF) {
+        sensor->page = value;
+        return;
+    }
+
+    if (sensor->page == 0) {
+        switch (index) {
+            case 0x00:                                      // SYSRANGE_START
+                if (value & 0x07) {                         // single shot start, back-to-back or timed
+                    uint8_t ref = (value & 0x40) || sensor->regs[0][0x01] == 0x01 || sensor->regs[0][0x01] == 0x02;
+                    sensor->mode = value & 0x06;
+                    sensor->doneAt = nowNs + (ref ? sensor->refUs : sensor->rangingUs) * 1000ull;
+                    value &= ~0x01;                         // start bit clears once running
+                } else if (value == 0x00 && (sensor->mode & 0x06)) {
+                    sensor->mode = 0;                       // stop continuous ranging
+                    sensor->doneAt = 0;
+                }
+                break;
+            case 0x0B:                                      // SYSTEM_INTERRUPT_CLEAR
+                if (value & 0x01) {
+                    sensor->regs[0][0x13] = 0;
+                    sensor->regs[0][0x14] &= ~0x01;
+                }
+                break;
+            case 0x8A:                                      // I2C_SLAVE_DEVICE_ADDRESS
+                sensor->address = value & 0x7F;
+                break;
+        }
+    }
+
+    if (index == 0x83 && value == 0x00) value = 0x10;       // NVM strobe completes at once
+
+    sensor->regs[sensor->page][index] = value;
+}
+
+/**
+ * readRegister
+ * ----------
+ * Description: one register read, NVM words show up at 0x90-0x93 of page 7.
+ */
+static uint8_t readRegister(SimSensor* sensor, uint8_t index) {
+    if (sensor->page == 7 && index >= 0x90 && index <= 0x93) {
+        uint32_t word = sensor->nvm[sensor->regs[7][0x94] & 0x7F];
+        return word >> (8 * (3 - (index - 0x90)));
+    }
+
+    return sensor->regs[sensor->page][index];
+}
+
+/****************************************************
+ *                                                  *
+ *                      Bus                         *
+ *                                                  *
+ ****************************************************/
+
+/**
+ * transfer
+ * ----------
+ * Description: charge the bus time of one transaction and find the sensor.
+ *              bits covers START, address, register, optional repeated
+ *              START with address, data bytes with ACK and STOP.
+ */
+static SimSensor* transfer(uint8_t bus, uint8_t deviceAddress, uint32_t bits, uint8_t read, uint32_t count) {
+    if (bus >= VL53L0X_SIM_SENSORS) return 0;
+
+    stats[bus].transactions++;
+    if (read) stats[bus].reads++;
+    else      stats[bus].writes++;
+    stats[bus].bytes += count;
+    stats[bus].bits += bits;
+
+    nowNs += (uint64_t)bits * 1000000ull / (busKHz[bus] ? busKHz[bus] : SIM_DEFAULT_KHZ);
+    update(&sensors[bus]);
+
+    return sensors[bus].address == deviceAddress ? &sensors[bus] : 0;   // NACK otherwise
+}
+
+void VL53L0X_I2C_Init(uint8_t bus) {
+    if (bus < VL53L0X_SIM_SENSORS && busKHz[bus] == 0) busKHz[bus] = SIM_DEFAULT_KHZ;
+}
+
+void VL53L0X_I2C_setSpeed(uint8_t bus, uint16_t speedKHz) {
+    if (bus < VL53L0X_SIM_SENSORS && speedKHz) busKHz[bus] = speedKHz;
+}
+
+int VL53L0X_read_multi(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uint32_t count) {
+    SimSensor* sensor = transfer(bus, deviceAddress, 1 + 9 * 2 + 1 + 9 * (1 + count) + 1, 1, count);
+
+    if (!sensor) return 1;
+    for (uint32_t i = 0; i < count; i++) pdata[i] = readRegister(sensor, index + i);
+
+    return 0;
+}
+
+int VL53L0X_write_multi(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t* pdata, uint32_t count) {
+    SimSensor* sensor = transfer(bus, deviceAddress, 1 + 9 * (2 + count) + 1, 0, count);
+
+    if (!sensor) return 1;
+    for (uint32_t i = 0; i < count; i++) {
+        if ((uint8_t)(index + i) == 0xFF) stats[bus].pageSwitches++;
+        writeRegister(sensor, index + i, pdata[i]);
+    }
+
+    return 0;
+}
+
+int VL53L0X_read_byte(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t* data) {
+    return VL53L0X_read_multi(bus, deviceAddress, index, data, 1);
+}
+
+int VL53L0X_write_byte(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint8_t data) {
+    return VL53L0X_write_multi(bus, deviceAddress, index, &data, 1);
+}
+
+int VL53L0X_read_word(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint16_t* data) {
+    uint8_t buffer[2];
+    int result = VL53L0X_read_multi(bus, deviceAddress, index, buffer, 2);
+
+    *data = (buffer[0] << 8) + buffer[1];
+
+    return result;
+}
+
+int VL53L0X_write_word(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint16_t data) {
+    uint8_t buffer[2] = { data >> 8, data & 0xFF };
+
+    return VL53L0X_write_multi(bus, deviceAddress, index, buffer, 2);
+}
+
+int VL53L0X_read_dword(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint32_t* data) {
+    uint8_t buffer[4];
+    int result = VL53L0X_read_multi(bus, deviceAddress, index, buffer, 4);
+
+    *data = ((uint32_t)buffer[0] << 24) + (buffer[1] << 16) + (buffer[2] << 8) + buffer[3];
+
+    return result;
+}
+
+int VL53L0X_write_dword(uint8_t bus, uint8_t deviceAddress, uint8_t index, uint32_t data) {
+    uint8_t buffer[4] = { data >> 24, data >> 16, data >> 8, data & 0xFF };
+
+    return VL53L0X_write_multi(bus, deviceAddress, index, buffer, 4);
+}
+
+int VL53L0X_write_script(uint8_t bus, uint8_t deviceAddress, const uint8_t* script, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (VL53L0X_write_byte(bus, deviceAddress, script[2 * i], script[2 * i + 1])) return 1;
+    }
+
+    return 0;
+}
+
+/****************************************************
+ *                                                  *
+ *                      APIs                        *
+ *                                                  *
+ ****************************************************/
+
+void VL53L0X_Sim_Init(void) {
+    nowNs = 0;
+
+    for (uint8_t i = 0; i < VL53L0X_SIM_SENSORS; i++) {
+        powerUp(&sensors[i], i);
+        busKHz[i] = 0;
+        VL53L0X_Sim_resetStats(i);
+    }
+}
+
+void VL53L0X_Sim_setTarget(uint8_t bus, uint16_t rangeMilliMeter) {
+    sensors[bus].rangeMilliMeter = rangeMilliMeter;
+}
+
+void VL53L0X_Sim_setLatency(uint8_t bus, uint32_t rangingUs, uint32_t refUs) {
+    sensors[bus].rangingUs = rangingUs;
+    sensors[bus].refUs = refUs;
+}
+
+void VL53L0X_Sim_advance(uint32_t us) {
+    nowNs += us * 1000ull;
+    for (uint8_t i = 0; i < VL53L0X_SIM_SENSORS; i++) update(&sensors[i]);
+}
+
+uint64_t VL53L0X_Sim_getTimeUs(void) {
+    return nowNs / 1000;
+}
+
+uint32_t VL53L0X_Sim_getSampleCount(uint8_t bus) {
+    return sensors[bus].samples;
+}
+
+const uint8_t* VL53L0X_Sim_getRegisters(uint8_t bus, uint8_t page) {
+    return sensors[bus].regs[page];
+}
+
+void VL53L0X_Sim_getStats(uint8_t bus, VL53L0X_Sim_Stats* result) {
+    *result = stats[bus];
+}
+
+void VL53L0X_Sim_resetStats(uint8_t bus) {
+    memset(&stats[bus], 0, sizeof(stats[bus]));
+}
+
+uint32_t VL53L0X_Sim_busTimeUs(const VL53L0X_Sim_Stats* result, uint16_t speedKHz) {
+    return (uint32_t)(result->bits * 1000 / speedKHz);
+}
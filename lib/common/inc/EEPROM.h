@@ -0,0 +1,53 @@
+/*!
+ * @file  EEPROM.h
+ * @brief Word access to the 2 KB on-chip EEPROM of TM4C123.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#ifndef __EEPROM_H__
+#define __EEPROM_H__
+
+#include <stdint.h>
+
+#define EEPROM_WORDS        512     // 2 KB
+#define EEPROM_BLOCK_WORDS  16      // words in one EEPROM block
+
+/**
+ * EEPROM_Init
+ * ----------
+ * @return 0 if the EEPROM reports a failed erase or program, 1 otherwise.
+ * ----------
+ * @brief  Power up the EEPROM module and wait for it to recover from any
+ *         interrupted write.
+ */
+int EEPROM_Init(void);
+
+/**
+ * EEPROM_read
+ * ----------
+ * @param  address  first word to read, 0 to EEPROM_WORDS - 1.
+ * @param  data     where to store the words.
+ * @param  count    number of words.
+ * ----------
+ * @return 0 for out of range, 1 for success.
+ */
+int EEPROM_read(uint32_t address, uint32_t* data, uint32_t count);
+
+/**
+ * EEPROM_write
+ * ----------
+ * @param  address  first word to write, 0 to EEPROM_WORDS - 1.
+ * @param  data     words to write.
+ * @param  count    number of words.
+ * ----------
+ * @return 0 for out of range or failed program, 1 for success.
+ * ----------
+ * @brief  Write words one at a time, each takes a few milliseconds worst case.
+ */
+int EEPROM_write(uint32_t address, const uint32_t* data, uint32_t count);
+
+#endif
@@ -12,6 +12,9 @@
  * @date   Aug 4, 2018
  */
 
+#ifndef __I2C_H__
+#define __I2C_H__
+
 #include <stdint.h>
 
 /*
@@ -20,15 +23,86 @@
  *  SCL -------- PB2 | SCL -------- PA6 | SCL -------- PE4 | SCL -------- PD0
  *  SDA -------- PB3 | SDA -------- PA7 | SDA -------- PE5 | SDA -------- PD1
  */
-#if 1           // set this to 1 to use I2C0
-#define I2C0
-#elif 0         // set this to 1 to use I2C1
-#define I2C1
-#elif 0         // set this to 1 to use I2C2
-#define I2C2
-#else           // use I2C3 if all 0 above
-#define I2C3
-#endif
+/*
+ *  Master register block of a I2C module, in datasheet order. The driver
+ *  only reaches a module through a pointer to this block, so a bus can be
+ *  pointed at a RAM model of the peripheral when running off target.
+ */
+typedef struct {
+    volatile uint32_t MSA;              // master slave address
+    volatile uint32_t MCS;              // master control (write) / status (read)
+    volatile uint32_t MDR;              // master data
+    volatile uint32_t MTPR;             // master timer period
+    volatile uint32_t MIMR;             // master interrupt mask
+    volatile uint32_t MRIS;             // master raw interrupt status
+    volatile uint32_t MMIS;             // master masked interrupt status
+    volatile uint32_t MICR;             // master interrupt clear
+    volatile uint32_t MCR;              // master configuration
+} I2C_Registers;
+
+#define I2C_SPEED_STANDARD     100      // kHz, standard mode, used by I2C_Init
+#define I2C_SPEED_FAST         400      // kHz, fast mode
+#define I2C_SPEED_FAST_PLUS    1000     // kHz, fast mode plus
+
+#define I2C_QUEUE_SIZE         16       // max number of queued transactions
+#define I2C_PENDING            (-1)     // status of a transaction not done yet
+#define I2C_DROPPED            (-2)     // status of a transaction dropped after its group failed
+#define I2C_TRANSACTION_WRITE  0
+#define I2C_TRANSACTION_READ   1
+
+/*
+ *  Transaction descriptor for the interrupt driven engine. The descriptor and
+ *  its data buffer must stay alive until status is no longer I2C_PENDING.
+ *  Transactions sharing a group depend on each other: once one of them
+ *  fails, its error bits go into *group and the others still queued or
+ *  submitted later end with I2C_DROPPED without reaching the bus.
+ */
+typedef struct I2C_Transaction {
+    uint8_t  deviceAddress;             // 7 bit address of slave device
+    uint8_t  targetRegister;            // target register of slave device
+    uint8_t  direction;                 // I2C_TRANSACTION_WRITE or I2C_TRANSACTION_READ
+    uint8_t* data;                      // data to be writen or buffer for read data
+    uint32_t count;                     // number of bytes to be transferred
+    void   (*callback)(struct I2C_Transaction* transaction); // called from ISR when done, may be 0
+    void*    context;                   // free for the owner of the transaction
+    volatile int status;                // I2C_PENDING, then error bits (0 on success) or I2C_DROPPED
+    volatile int* group;                // first error of the group, 0 if the transaction stands alone
+} I2C_Transaction;
+
+/*
+ *  One I2C module and the pins it is routed to, plus the state of its
+ *  interrupt engine. All modules can run at the same time, each API call
+ *  takes the bus it works on.
+ */
+typedef struct {
+    /* module and pin mapping */
+    I2C_Registers* registers;           // master register block
+    uint32_t irq;                       // NVIC interrupt number
+    uint32_t moduleClock;               // SYSCTL_RCGCI2C_R bit
+    uint32_t portClock;                 // SYSCTL_RCGCGPIO_R bit
+    uint32_t portBase;                  // GPIO port base address
+    uint32_t pins;                      // SCL and SDA pin mask
+    uint32_t sdaPin;                    // SDA pin mask, open drain
+    uint32_t pctlMask;                  // PCTL fields of SCL and SDA
+    uint32_t pctlValue;                 // PCTL setting for I2C function
+    
+    /* interrupt engine */
+    I2C_Transaction* queue[I2C_QUEUE_SIZE];     // transactions waiting for the bus
+    volatile uint32_t queueHead;                // next transaction to run
+    volatile uint32_t queueTail;                // next free slot
+    I2C_Transaction* volatile current;          // transaction on the bus
+    uint32_t phase;                             // phase of current transaction
+    uint32_t position;                          // next data byte of current transaction
+} I2C_Bus;
+
+#define I2C_BUS_COUNT          4
+
+extern I2C_Bus I2C_Buses[I2C_BUS_COUNT];
+
+#define I2C_BUS0               (&I2C_Buses[0])
+#define I2C_BUS1               (&I2C_Buses[1])
+#define I2C_BUS2               (&I2C_Buses[2])
+#define I2C_BUS3               (&I2C_Buses[3])
 
 /****************************************************
  *                                                  *
@@ -39,9 +113,34 @@
 /**
  * I2C_Init
  * ----------
+ * @param  bus  I2C module to be initialized, e.g. I2C_BUS0.
+ * ----------
  * @brief initialize a I2C module with corresponding setting parameters.
  */
-void I2C_Init(void);
+void I2C_Init(I2C_Bus* bus);
+
+/**
+ * I2C_setSpeed
+ * ----------
+ * @param  bus       I2C module.
+ * @param  speedKHz  SCL clock in kHz, e.g. I2C_SPEED_FAST.
+ * ----------
+ * @brief change SCL clock of the I2C module, computed from the bus clock
+ *        selected by PLL_Init. Waits for queued transactions to finish.
+ */
+void I2C_setSpeed(I2C_Bus* bus, uint32_t speedKHz);
+
+/**
+ * I2C_computeTPR
+ * ----------
+ * @param  busClock  system clock in Hz.
+ * @param  speedKHz  desired SCL clock in kHz.
+ * ----------
+ * @return timer period for MTPR, rounded so SCL never runs faster than asked.
+ * ----------
+ * @brief SCL period = 20 * (1 + TPR) / busClock.
+ */
+uint32_t I2C_computeTPR(uint32_t busClock, uint32_t speedKHz);
 
 
 /****************************************************
@@ -53,18 +152,21 @@ void I2C_Init(void);
 /**
  * I2C_read
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data address to store read data.
  * @param  count          number of bytes to be read.
  * ----------
- * @brief read 1 or more bytes from slave device.
+ * @brief read 1 or more bytes from slave device. The target register is sent
+ *        and the data read back in one transaction joined by a repeated start.
  */
-int I2C_read(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data, uint32_t count);
+int I2C_read(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data, uint32_t count);
 
 /**
  * I2C_write
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data          data address of data to be writen.
@@ -72,71 +174,147 @@ int I2C_read(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data, uint3
  * ----------
  * @brief write 1 or more bytes to slave device.
  */
-int I2C_write(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data, uint32_t count);
+int I2C_write(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data, uint32_t count);
 
 /**
  * I2C_read_byte
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 1 byte from slave device.
  */
-int I2C_read_byte(uint8_t deviceAddress, uint8_t targetRegister, uint8_t *data);
+int I2C_read_byte(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t *data);
 
 
 /**
  * I2C_write_byte
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data to be writen.
  * ----------
  * @brief write 1 byte to slave device.
  */
-int I2C_write_byte(uint8_t deviceAddress, uint8_t targetRegister, uint8_t data);
+int I2C_write_byte(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t data);
 
 /**
  * I2C_read_2_bytes
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 2 bytes from slave device.
  */
-int I2C_read_2_bytes(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data);
+int I2C_read_2_bytes(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data);
 
 /**
  * I2C_write_2_bytes
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data to be writen.
  * ----------
  * @brief write 2 bytes to slave device.
  */
-int I2C_write_2_bytes(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data);
+int I2C_write_2_bytes(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data);
 
 /**
  * I2C_read_4_bytes
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 4 bytes from slave device.
  */
-int I2C_read_4_bytes(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data);
+int I2C_read_4_bytes(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data);
 
 /**
  * I2C_write_4_bytes
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data to be writen.
  * ----------
  * @brief write 4 bytes to slave device.
  */
-int I2C_write_4_bytes(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data);
+int I2C_write_4_bytes(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data);
+
+
+/****************************************************
+ *                                                  *
+ *                  Async R/W API                   *
+ *                                                  *
+ ****************************************************/
+
+/**
+ * I2C_submit
+ * ----------
+ * @param  bus          I2C module to run the transaction on.
+ * @param  transaction  transaction to be queued.
+ * ----------
+ * @return 0 if queued, -1 if the queue is full (status is left as it was).
+ * ----------
+ * @brief queue a transaction for the interrupt driven engine and return
+ *        right away. The I2C interrupt moves the transaction along byte by
+ *        byte and calls its callback once it is done.
+ */
+int I2C_submit(I2C_Bus* bus, I2C_Transaction* transaction);
+
+/**
+ * I2C_wait
+ * ----------
+ * @param  transaction  a submitted transaction.
+ * ----------
+ * @return error bits of the transaction, 0 on success, I2C_DROPPED if its
+ *         group failed first.
+ * ----------
+ * @brief wait for a submitted transaction to finish. Must not be called from the callback.
+ */
+int I2C_wait(I2C_Transaction* transaction);
+
+/**
+ * I2C_isIdle
+ * ----------
+ * @param  bus  I2C module.
+ * ----------
+ * @return 1 if no transaction is on the bus or queued, 0 otherwise.
+ */
+int I2C_isIdle(I2C_Bus* bus);
+
+/**
+ * I2C_write_script
+ * ----------
+ * @param  bus            I2C module the slave device is wired to.
+ * @param  deviceAddress  address of slave device.
+ * @param  script         (register, value) byte pairs, written in order.
+ * @param  count          number of pairs in script.
+ * ----------
+ * @return error bits of the first failed write, 0 on success.
+ * ----------
+ * @brief write a sequence of single byte registers as one queued burst.
+ *        The writes form a group: after a failed one, the engine drops the
+ *        rest still queued and none are submitted anymore.
+ */
+int I2C_write_script(I2C_Bus* bus, uint8_t deviceAddress, const uint8_t* script, uint32_t count);
+
+/**
+ * I2C_service
+ * ----------
+ * @param  bus  I2C module that raised the interrupt.
+ * ----------
+ * @brief advance the transaction on the bus by one step, called by the I2C
+ *        master interrupt. Exposed so that a register model can drive it.
+ */
+void I2C_service(I2C_Bus* bus);
+
+#endif
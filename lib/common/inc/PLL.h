@@ -28,6 +28,10 @@
 
 // configure the system to get its clock from the PLL
 void PLL_Init(uint32_t freq);
+
+// bus clock in Hz selected by the last PLL_Init
+// 16 MHz (PIOSC) if PLL_Init has not been called
+uint32_t PLL_GetBusClock(void);
 #define Bus80MHz     4
 #define Bus80_000MHz 4
 #define Bus66_667MHz 5
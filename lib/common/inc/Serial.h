@@ -26,6 +26,12 @@
 #define SP   0x20
 #define DEL  0x7F
 
+/* TX ring, drained by the UART0 TX interrupt */
+#define SERIAL_TX_SIZE       256        // bytes, a power of two
+#define SERIAL_TX_BLOCK      0          // full ring: wait for room (default)
+#define SERIAL_TX_DROP       1          // full ring: drop the new byte
+#define SERIAL_TX_OVERWRITE  2          // full ring: drop the oldest byte
+
 /****************************************************
  *                                                  *
  *                   Initializer                    *
@@ -37,9 +43,35 @@
  * ----------
  * @brief Initialize the UART for 115,200 baud rate (assuming 80 MHz UART clock),
  *        8 bit word length, no parity bits, one stop bit, FIFOs enabled.
+ *        Output goes through a SERIAL_TX_SIZE byte ring that the UART0 TX
+ *        interrupt drains, so writes return as soon as they are queued.
  */
 void Serial_Init(void);
 
+/**
+ * Serial_setTxPolicy
+ * ----------
+ * @param  policy  SERIAL_TX_BLOCK, SERIAL_TX_DROP or SERIAL_TX_OVERWRITE.
+ * ----------
+ * @brief What a write does when the TX ring is full. Use DROP or OVERWRITE
+ *        in loops that must never wait on the serial link.
+ */
+void Serial_setTxPolicy(uint8_t policy);
+
+/**
+ * Serial_getTxDropped
+ * ----------
+ * @return bytes lost to a full TX ring since Serial_Init.
+ */
+uint32_t Serial_getTxDropped(void);
+
+/**
+ * Serial_flush
+ * ----------
+ * @brief Wait until every queued byte has left the UART.
+ */
+void Serial_flush(void);
+
 /****************************************************
  *                                                  *
  *                  Read Functions                  *
@@ -113,7 +145,7 @@ void Serial_getString(char *bufPt, uint16_t max);
  * ----------
  * @param  data  an 8-bit ASCII character to be transferred.
  * ----------
- * @brief Output 8-bit to serial port.
+ * @brief Queue 8-bit for the serial port, the full ring policy applies.
  */
 void Serial_putChar(char data);
 
@@ -0,0 +1,73 @@
+/*!
+ * @file  Timebase.h
+ * @brief Monotonic microsecond clock and sleeps on the TM4C123 wide timer 5.
+ * ----------
+ * Wide timer 5A free runs at 1 MHz and gives the clock, wide timer 5B is a
+ * one-shot that wakes the CPU from WFI at the end of a sleep. Times are 32
+ * bit microseconds that wrap every 71.6 minutes; compare them only through
+ * Timebase_expired so the wrap does not matter for waits under 35 minutes.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#ifndef __TIMEBASE_H__
+#define __TIMEBASE_H__
+
+#include <stdint.h>
+
+/**
+ * Timebase_Init
+ * ----------
+ * @brief  Start the clock at the bus clock set by PLL_Init. The other calls
+ *         start it on first use, call this again after changing the bus clock.
+ */
+void Timebase_Init(void);
+
+/**
+ * Timebase_now
+ * ----------
+ * @return microseconds since the clock started, wraps at 2^32.
+ */
+uint32_t Timebase_now(void);
+
+/**
+ * Timebase_deadline
+ * ----------
+ * @param  us  microseconds from now.
+ * ----------
+ * @return the time us microseconds from now, for Timebase_expired and Timebase_sleepUntil.
+ */
+uint32_t Timebase_deadline(uint32_t us);
+
+/**
+ * Timebase_expired
+ * ----------
+ * @param  deadline  time from Timebase_deadline.
+ * ----------
+ * @return 1 once the deadline has passed, 0 before.
+ */
+int Timebase_expired(uint32_t deadline);
+
+/**
+ * Timebase_sleepUntil
+ * ----------
+ * @param  deadline  time from Timebase_deadline.
+ * @param  wake      flag set by an interrupt handler that ends the sleep early, 0 for none.
+ * ----------
+ * @return 1 if the flag ended the sleep, 0 if the deadline did.
+ * ----------
+ * @brief  Sleep in WFI until the deadline or until the flag is set.
+ */
+int Timebase_sleepUntil(uint32_t deadline, volatile uint8_t* wake);
+
+/**
+ * Timebase_sleepUs
+ * ----------
+ * @param  us  microseconds to sleep.
+ */
+void Timebase_sleepUs(uint32_t us);
+
+#endif
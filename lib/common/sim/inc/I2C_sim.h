@@ -0,0 +1,128 @@
+/*!
+ * @file  I2C_sim.h
+ * @brief Fake I2C master registers and slave device for host builds of I2C.c.
+ * ----------
+ * I2C_Sim_Init points every I2C_Buses entry at a RAM copy of the master
+ * register block. The driver writes a command into MCS as on the chip;
+ * I2C_Sim_step plays the controller: it puts the byte of that command on a
+ * model bus with one slave device (256 registers, auto increment), leaves
+ * the status in MCS and calls I2C_service the way the master interrupt
+ * would. A status read back has IDLE or BUSBSY set, which no command has,
+ * so the model tells a new command from the status it left. Every command
+ * is logged, and an error can be injected into the next one to drive the
+ * NACK and arbitration lost paths.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#ifndef __I2C_SIM_H__
+#define __I2C_SIM_H__
+
+#include <stdint.h>
+#include "I2C.h"
+
+#define I2C_SIM_ADDRESS     0x29        // slave address after I2C_Sim_Init, the VL53L0X default
+#define I2C_SIM_LOG         256         // commands kept in the log
+
+/*
+ *  One command the driver wrote into MCS and the byte it moved.
+ */
+typedef struct {
+    uint32_t command;                   // MCS bits written: RUN, START, STOP, ACK
+    uint32_t address;                   // MSA at the time, address << 1 | R/S
+    uint8_t  data;                      // byte sent, or received
+    uint32_t status;                    // MCS status left for I2C_service
+} I2C_Sim_Event;
+
+/**
+ * I2C_Sim_Init
+ * ----------
+ * @brief  Point every bus at its fake register block, empty the engine
+ *         queues, clear the slave registers and the logs.
+ */
+void I2C_Sim_Init(void);
+
+/**
+ * I2C_Sim_setAddress
+ * ----------
+ * @param  bus      I2C module.
+ * @param  address  7 bit address the slave answers to, others are not acknowledged.
+ */
+void I2C_Sim_setAddress(I2C_Bus* bus, uint8_t address);
+
+/**
+ * I2C_Sim_fail
+ * ----------
+ * @param  bus     I2C module.
+ * @param  status  error bits the next command ends with, e.g.
+ *                 I2C_MCS_DATACK | I2C_MCS_ERROR. With I2C_MCS_ARBLST the
+ *                 controller lets go of the bus.
+ */
+void I2C_Sim_fail(I2C_Bus* bus, uint32_t status);
+
+/**
+ * I2C_Sim_step
+ * ----------
+ * @param  bus  I2C module.
+ * ----------
+ * @return 1 if a command was run, 0 if the driver left nothing to do.
+ * ----------
+ * @brief  Run the command in MCS and raise the master interrupt if unmasked.
+ */
+int I2C_Sim_step(I2C_Bus* bus);
+
+/**
+ * I2C_Sim_run
+ * ----------
+ * @param  bus  I2C module.
+ * ----------
+ * @return number of commands run.
+ * ----------
+ * @brief  Step until the driver leaves the bus alone.
+ */
+uint32_t I2C_Sim_run(I2C_Bus* bus);
+
+/**
+ * I2C_Sim_getRegisters
+ * ----------
+ * @param  bus  I2C module.
+ * ----------
+ * @return the 256 registers of the slave on the bus.
+ */
+uint8_t* I2C_Sim_getRegisters(I2C_Bus* bus);
+
+/**
+ * I2C_Sim_getLog
+ * ----------
+ * @param  bus    I2C module.
+ * @param  count  commands logged since I2C_Sim_Init or the last I2C_Sim_resetLog.
+ * ----------
+ * @return the logged commands, the first I2C_SIM_LOG of them.
+ */
+const I2C_Sim_Event* I2C_Sim_getLog(I2C_Bus* bus, uint32_t* count);
+
+/**
+ * I2C_Sim_resetLog
+ * ----------
+ * @param  bus  I2C module.
+ */
+void I2C_Sim_resetLog(I2C_Bus* bus);
+
+/**
+ * I2C_Sim_getErrors
+ * ----------
+ * @param  bus  I2C module.
+ * ----------
+ * @return commands that broke the protocol (data without a START, a STOP
+ *         with nothing on the bus) and interrupts the driver did not clear.
+ */
+uint32_t I2C_Sim_getErrors(I2C_Bus* bus);
+
+#endif
@@ -0,0 +1,248 @@
+/*!
+ * @file  I2C_sim.c
+ * @brief Fake I2C master registers and slave device for host builds of I2C.c.
+ * ----------
+ * Only what the driver relies on is modelled: single byte master commands
+ * (START, RUN, STOP, ACK) with the slave address in MSA and the byte in MDR,
+ * the error bits of MCS and the master interrupt behind MIMR and MICR. The
+ * first byte written after a START sets the register pointer of the slave,
+ * every other byte written or read moves it by one. As on the chip, the
+ * controller keeps the bus after a NACK until the driver sends a STOP.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "I2C.h"
+#include "I2C_sim.h"
+#include "tm4c123gh6pm.h"
+
+#define SIM_STATUS  (I2C_MCS_IDLE | I2C_MCS_BUSBSY)  // set in every status the model leaves, never in a command
+
+typedef struct {
+    I2C_Registers registers;
+    uint8_t       slave[256];
+    uint8_t       address;              // slave address
+    uint8_t       pointer;              // register pointer of the slave
+    uint8_t       held;                 // controller owns the bus, between START and STOP
+    uint8_t       first;                // next byte written is the register pointer
+    uint32_t      fail;                 // error bits for the next command
+    uint32_t      errors;
+    I2C_Sim_Event log[I2C_SIM_LOG];
+    uint32_t      logCount;
+} SimBus;
+
+static SimBus sim[I2C_BUS_COUNT];
+
+/**
+ * simBus
+ * ----------
+ * Description: model of a bus.
+ */
+static SimBus* simBus(I2C_Bus* bus) {
+    return &sim[bus - I2C_Buses];
+}
+
+/**
+ * setStatus
+ * ----------
+ * Description: leave a status in MCS for the driver to read.
+ */
+static void setStatus(SimBus* s, uint32_t status) {
+    s->registers.MCS = status | (s->held ? I2C_MCS_BUSBSY : I2C_MCS_IDLE);
+}
+
+/**
+ * interrupt
+ * ----------
+ * Description: raise the master interrupt, run the handler if unmasked.
+ */
+static void interrupt(I2C_Bus* bus, SimBus* s) {
+    s->registers.MRIS = I2C_MRIS_RIS;
+    if ((s->registers.MIMR & I2C_MIMR_IM) == 0) return;     // delivered once unmasked
+
+    s->registers.MMIS = I2C_MMIS_MIS;
+    s->registers.MICR = 0;
+    I2C_service(bus);
+    if (s->registers.MICR & I2C_MICR_IC) {
+        s->registers.MRIS = 0;
+        s->registers.MMIS = 0;
+    } else {
+        s->errors++;                                        // handler left it pending
+    }
+}
+
+/**
+ * I2C_Sim_Init
+ * ----------
+ * @brief  Point every bus at its fake register block, empty the engine
+ *         queues, clear the slave registers and the logs.
+ */
+void I2C_Sim_Init(void) {
+    for (int i = 0; i < I2C_BUS_COUNT; i++) {
+        I2C_Bus* bus = &I2C_Buses[i];
+        SimBus*  s = &sim[i];
+
+        memset(s, 0, sizeof(*s));
+        s->address = I2C_SIM_ADDRESS;
+        s->registers.MCR = I2C_MCR_MFE;
+        setStatus(s, 0);
+
+        bus->registers = &s->registers;
+        bus->queueHead = 0;
+        bus->queueTail = 0;
+        bus->current = 0;
+    }
+}
+
+/**
+ * I2C_Sim_setAddress
+ * ----------
+ * @param  bus      I2C module.
+ * @param  address  7 bit address the slave answers to.
+ */
+void I2C_Sim_setAddress(I2C_Bus* bus, uint8_t address) {
+    simBus(bus)->address = address;
+}
+
+/**
+ * I2C_Sim_fail
+ * ----------
+ * @param  bus     I2C module.
+ * @param  status  error bits the next command ends with.
+ */
+void I2C_Sim_fail(I2C_Bus* bus, uint32_t status) {
+    simBus(bus)->fail = status;
+}
+
+/**
+ * I2C_Sim_step
+ * ----------
+ * @param  bus  I2C module.
+ * ----------
+ * @return 1 if a command was run, 0 if the driver left nothing to do.
+ */
+int I2C_Sim_step(I2C_Bus* bus) {
+    SimBus*        s = simBus(bus);
+    I2C_Registers* i2c = &s->registers;
+    uint32_t       command = i2c->MCS;
+    uint32_t       status = 0;
+    I2C_Sim_Event  event;
+
+    if (i2c->MRIS && (i2c->MIMR & I2C_MIMR_IM)) {          // raised while masked
+        interrupt(bus, s);
+        return 1;
+    }
+    if (command & SIM_STATUS) return 0;                     // still the status we left
+
+    event.command = command;
+    event.address = i2c->MSA;
+    event.data = 0;
+
+    if ((command & I2C_MCS_RUN) == 0) {                     // STOP alone, after an error
+        if (!s->held || (command & I2C_MCS_STOP) == 0) s->errors++;
+        s->held = 0;
+    } else if ((command & I2C_MCS_START) == 0 && !s->held) {
+        s->errors++;                                        // data with nobody addressed
+        status = I2C_MCS_ERROR;
+    } else {
+        if (command & I2C_MCS_START) {                      // (repeated) start and address
+            s->held = 1;
+            s->first = (i2c->MSA & I2C_MSA_RS) == 0;
+            if ((i2c->MSA >> 1) != s->address) status = I2C_MCS_ADRACK | I2C_MCS_ERROR;
+        }
+        if (status == 0 && s->fail == 0) {
+            if (i2c->MSA & I2C_MSA_RS) {
+                i2c->MDR = s->slave[s->pointer++];
+            } else if (s->first) {
+                s->pointer = i2c->MDR;
+                s->first = 0;
+            } else {
+                s->slave[s->pointer++] = i2c->MDR;
+            }
+        }
+        if (status == 0) status = s->fail;
+        s->fail = 0;
+        event.data = i2c->MDR;
+
+        if (status & I2C_MCS_ARBLST) {
+            s->held = 0;                                    // another master has the bus
+        } else if ((command & I2C_MCS_STOP) && status == 0) {
+            s->held = 0;                                    // errors keep the bus until a STOP
+        }
+    }
+
+    event.status = status;
+    if (s->logCount < I2C_SIM_LOG) s->log[s->logCount] = event;
+    s->logCount++;
+
+    setStatus(s, status);
+    if (command & I2C_MCS_RUN) interrupt(bus, s);           // a STOP alone ends quietly
+    return 1;
+}
+
+/**
+ * I2C_Sim_run
+ * ----------
+ * @param  bus  I2C module.
+ * ----------
+ * @return number of commands run.
+ */
+uint32_t I2C_Sim_run(I2C_Bus* bus) {
+    uint32_t steps = 0;
+
+    while (I2C_Sim_step(bus)) steps++;
+    return steps;
+}
+
+/**
+ * I2C_Sim_getRegisters
+ * ----------
+ * @param  bus  I2C module.
+ * ----------
+ * @return the 256 registers of the slave on the bus.
+ */
+uint8_t* I2C_Sim_getRegisters(I2C_Bus* bus) {
+    return simBus(bus)->slave;
+}
+
+/**
+ * I2C_Sim_getLog
+ * ----------
+ * @param  bus    I2C module.
+ * @param  count  commands logged since I2C_Sim_Init or the last I2C_Sim_resetLog.
+ * ----------
+ * @return the logged commands.
+ */
+const I2C_Sim_Event* I2C_Sim_getLog(I2C_Bus* bus, uint32_t* count) {
+    *count = simBus(bus)->logCount;
+    return simBus(bus)->log;
+}
+
+/**
+ * I2C_Sim_resetLog
+ * ----------
+ * @param  bus  I2C module.
+ */
+void I2C_Sim_resetLog(I2C_Bus* bus) {
+    simBus(bus)->logCount = 0;
+}
+
+/**
+ * I2C_Sim_getErrors
+ * ----------
+ * @param  bus  I2C module.
+ * ----------
+ * @return protocol errors and interrupts left pending.
+ */
+uint32_t I2C_Sim_getErrors(I2C_Bus* bus) {
+    return simBus(bus)->errors;
+}
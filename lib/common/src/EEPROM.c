@@ -0,0 +1,95 @@
+/*!
+ * @file  EEPROM.c
+ * @brief Word access to the 2 KB on-chip EEPROM of TM4C123.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+#include "EEPROM.h"
+
+/**
+ * EEPROM_wait
+ * ----------
+ * Description: wait for the EEPROM to finish the current operation.
+ */
+static void EEPROM_wait(void) {
+    while (EEPROM_EEDONE_R & EEPROM_EEDONE_WORKING) {};
+}
+
+/**
+ * EEPROM_Init
+ * ----------
+ * @return 0 if the EEPROM reports a failed erase or program, 1 otherwise.
+ * ----------
+ * @brief  Power up the EEPROM module and wait for it to recover from any
+ *         interrupted write.
+ */
+int EEPROM_Init(void) {
+    SYSCTL_RCGCEEPROM_R |= SYSCTL_RCGCEEPROM_R0;                   // enable EEPROM clock
+    while ((SYSCTL_PREEPROM_R & SYSCTL_PREEPROM_R0) == 0) {};     // allow time for activating
+    EEPROM_wait();
+    if (EEPROM_EESUPP_R & (EEPROM_EESUPP_PRETRY | EEPROM_EESUPP_ERETRY)) return 0;
+    
+    SYSCTL_SREEPROM_R |= SYSCTL_SREEPROM_R0;                       // reset to load the copy buffer
+    SYSCTL_SREEPROM_R &= ~SYSCTL_SREEPROM_R0;
+    while ((SYSCTL_PREEPROM_R & SYSCTL_PREEPROM_R0) == 0) {};
+    EEPROM_wait();
+    if (EEPROM_EESUPP_R & (EEPROM_EESUPP_PRETRY | EEPROM_EESUPP_ERETRY)) return 0;
+    
+    return 1;
+}
+
+/**
+ * EEPROM_read
+ * ----------
+ * @param  address  first word to read, 0 to EEPROM_WORDS - 1.
+ * @param  data     where to store the words.
+ * @param  count    number of words.
+ * ----------
+ * @return 0 for out of range, 1 for success.
+ */
+int EEPROM_read(uint32_t address, uint32_t* data, uint32_t count) {
+    if (address + count > EEPROM_WORDS) return 0;
+    
+    for (uint32_t i = 0; i < count; i++, address++) {
+        if (i == 0 || address % EEPROM_BLOCK_WORDS == 0) {      // offset wraps inside a block
+            EEPROM_EEBLOCK_R = address / EEPROM_BLOCK_WORDS;
+            EEPROM_EEOFFSET_R = address % EEPROM_BLOCK_WORDS;
+        }
+        data[i] = EEPROM_EERDWRINC_R;
+    }
+    
+    return 1;
+}
+
+/**
+ * EEPROM_write
+ * ----------
+ * @param  address  first word to write, 0 to EEPROM_WORDS - 1.
+ * @param  data     words to write.
+ * @param  count    number of words.
+ * ----------
+ * @return 0 for out of range or failed program, 1 for success.
+ * ----------
+ * @brief  Write words one at a time, each takes a few milliseconds worst case.
+ */
+int EEPROM_write(uint32_t address, const uint32_t* data, uint32_t count) {
+    if (address + count > EEPROM_WORDS) return 0;
+    
+    for (uint32_t i = 0; i < count; i++, address++) {
+        if (i == 0 || address % EEPROM_BLOCK_WORDS == 0) {
+            EEPROM_EEBLOCK_R = address / EEPROM_BLOCK_WORDS;
+            EEPROM_EEOFFSET_R = address % EEPROM_BLOCK_WORDS;
+        }
+        EEPROM_EERDWRINC_R = data[i];
+        EEPROM_wait();
+        if (EEPROM_EEDONE_R) return 0;                           // any bit left is an error
+    }
+    
+    return 1;
+}
@@ -14,10 +14,65 @@
 
 #include <stdint.h>
 #include "I2C.h"
+#include "PLL.h"
 #include "tm4c123gh6pm.h"
 
 #define MAXRETRIES 5           // number of receive attempts before giving up
 
+#define I2C_ERROR_BITS   (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)
+
+/* GPIO port register offsets, the same for every port */
+#define GPIO_AFSEL      0x420
+#define GPIO_ODR        0x50C
+#define GPIO_DEN        0x51C
+#define GPIO_AMSEL      0x528
+#define GPIO_PCTL       0x52C
+#define GPIO_REG(base, offset)  (*((volatile uint32_t *)(uintptr_t)((base) + (offset))))
+
+/* NVIC enable and byte wide priority registers */
+#define NVIC_EN(irq)    (*((volatile uint32_t *)(uintptr_t)(0xE000E100 + 4 * ((irq) / 32))))
+#define NVIC_PRI(irq)   (*((volatile uint8_t *)(uintptr_t)(0xE000E400 + (irq))))
+
+/*
+ *  I2C0 Conncection | I2C1 Conncection | I2C2 Conncection | I2C3 Conncection
+ *  ---------------- | ---------------- | ---------------- | ----------------
+ *  SCL -------- PB2 | SCL -------- PA6 | SCL -------- PE4 | SCL -------- PD0
+ *  SDA -------- PB3 | SDA -------- PA7 | SDA -------- PE5 | SDA -------- PD1
+ */
+I2C_Bus I2C_Buses[I2C_BUS_COUNT] = {
+    {   /* I2C0 on Port B */
+        (I2C_Registers *)0x40020000, 8,
+        SYSCTL_RCGCI2C_R0, SYSCTL_RCGCGPIO_R1, 0x40005000, 0x0C, 0x08,
+        (GPIO_PCTL_PB2_M | GPIO_PCTL_PB3_M),
+        (GPIO_PCTL_PB2_I2C0SCL | GPIO_PCTL_PB3_I2C0SDA)
+    },
+    {   /* I2C1 on Port A */
+        (I2C_Registers *)0x40021000, 37,
+        SYSCTL_RCGCI2C_R1, SYSCTL_RCGCGPIO_R0, 0x40004000, 0xC0, 0x80,
+        (GPIO_PCTL_PA6_M | GPIO_PCTL_PA7_M),
+        (GPIO_PCTL_PA6_I2C1SCL | GPIO_PCTL_PA7_I2C1SDA)
+    },
+    {   /* I2C2 on Port E */
+        (I2C_Registers *)0x40022000, 68,
+        SYSCTL_RCGCI2C_R2, SYSCTL_RCGCGPIO_R4, 0x40024000, 0x30, 0x20,
+        (GPIO_PCTL_PE4_M | GPIO_PCTL_PE5_M),
+        (GPIO_PCTL_PE4_I2C2SCL | GPIO_PCTL_PE5_I2C2SDA)
+    },
+    {   /* I2C3 on Port D */
+        (I2C_Registers *)0x40023000, 69,
+        SYSCTL_RCGCI2C_R3, SYSCTL_RCGCGPIO_R3, 0x40007000, 0x03, 0x02,
+        (GPIO_PCTL_PD0_M | GPIO_PCTL_PD1_M),
+        (GPIO_PCTL_PD0_I2C3SCL | GPIO_PCTL_PD1_I2C3SDA)
+    }
+};
+
+/* interrupt engine phases */
+enum {
+    I2C_PHASE_REGISTER,                                    // sending target register
+    I2C_PHASE_WRITE,                                       // sending data bytes
+    I2C_PHASE_READ                                         // receiving data bytes
+};
+
 /****************************************************
  *                                                  *
  *                   Initializer                    *
@@ -27,90 +82,65 @@
 /**
  * I2C_Init
  * ----------
+ * @param  bus  I2C module to be initialized, e.g. I2C_BUS0.
+ * ----------
  * @brief initialize a I2C module with corresponding setting parameters.
  */
-void I2C_Init() {
-#ifdef I2C0
-    /*-- I2C0 and Port B Activation --*/
-    SYSCTL_RCGCI2C_R |= SYSCTL_RCGCI2C_R0;                 // enable I2C Module 0 clock
-    SYSCTL_RCGCGPIO_R |= SYSCTL_RCGCGPIO_R1;               // enable GPIO Port B clock
-    while ((SYSCTL_PRGPIO_R & SYSCTL_PRGPIO_R1) == 0) {};  // allow time for activating
-    
-    /*-- Port B Set Up --*/
-    GPIO_PORTB_AFSEL_R |= 0x0C;                            // enable alt function on PB2, 3
-    GPIO_PORTB_ODR_R |= 0x08;                              // enable open drain on PB3
-    GPIO_PORTB_DEN_R |= 0x0C;                              // enable digital I/O on PB2,3
-    GPIO_PORTB_PCTL_R &= ((~GPIO_PCTL_PB2_M) &             // clear bit fields for PB2
-                          (~GPIO_PCTL_PB3_M));             // clear bit fields for PB3
-    GPIO_PORTB_PCTL_R |= (GPIO_PCTL_PB2_I2C0SCL |          // configure PB2 as I2C0SCL
-                          GPIO_PCTL_PB3_I2C0SDA);          // configure PB3 as I2C0SDA
-    GPIO_PORTB_AMSEL_R &= ~0x0C;                           // disable analog functionality on PB2, 3
-    
-    /*-- I2C0 Set Up --*/
-    I2C0_MCR_R = I2C_MCR_MFE;                              // master function enable
-    I2C0_MTPR_R = 39;                                      // configure for 100 kbps clock
-    // 20 * (TPR + 1) * 12.5ns = 10us, with TPR=24
-#elif defined I2C1
-    /*-- I2C1 and Port A Activation --*/
-    SYSCTL_RCGCI2C_R |= SYSCTL_RCGCI2C_R1;                 // enable I2C Module 1 clock
-    SYSCTL_RCGCGPIO_R |= SYSCTL_RCGCGPIO_R0;               // enable GPIO Port A clock
-    while ((SYSCTL_PRGPIO_R & SYSCTL_PRGPIO_R0) == 0) {};  // allow time for activating
-    
-    /*-- Port A Set Up --*/
-    GPIO_PORTA_AFSEL_R |= 0xC0;                            // enable alt function on PA6, 7
-    GPIO_PORTA_ODR_R |= 0x80;                              // enable open drain on PA7
-    GPIO_PORTA_DEN_R |= 0xC0;                              // enable digital I/O on PA6, 7
-    GPIO_PORTA_PCTL_R &= ((~GPIO_PCTL_PA6_M) &             // clear bit fields for PA6
-                          (~GPIO_PCTL_PA7_M));             // clear bit fields for PA7
-    GPIO_PORTA_PCTL_R |= (GPIO_PCTL_PA6_I2C1SCL |          // configure PA6 as I2C1SCL
-                          GPIO_PCTL_PA7_I2C1SDA);          // configure PA7 as I2C1SDA
-    GPIO_PORTA_AMSEL_R &= ~0xC0;                           // disable analog functionality on PA6, 7
+void I2C_Init(I2C_Bus* bus) {
+    /*-- I2C Module and GPIO Port Activation --*/
+    SYSCTL_RCGCI2C_R |= bus->moduleClock;                  // enable I2C Module clock
+    SYSCTL_RCGCGPIO_R |= bus->portClock;                   // enable GPIO Port clock
+    while ((SYSCTL_PRGPIO_R & bus->portClock) == 0) {};    // allow time for activating
     
-    /*-- I2C1 Set Up --*/
-    I2C1_MCR_R = I2C_MCR_MFE;                              // master function enable
-    I2C1_MTPR_R = 39;                                      // configure for 100 kbps clock
-    // 20 * (TPR + 1) * 12.5ns = 10us, with TPR=24
-#elif defined I2C2
-    /*-- I2C2 and Port E Activation --*/
-    SYSCTL_RCGCI2C_R |= SYSCTL_RCGCI2C_R2;                 // enable I2C Module 2 clock
-    SYSCTL_RCGCGPIO_R |= SYSCTL_RCGCGPIO_R4;               // enable GPIO Port E clock
-    while ((SYSCTL_PRGPIO_R & SYSCTL_PRGPIO_R4) == 0) {};  // allow time for activating
+    /*-- GPIO Port Set Up --*/
+    GPIO_REG(bus->portBase, GPIO_AFSEL) |= bus->pins;      // enable alt function on SCL, SDA
+    GPIO_REG(bus->portBase, GPIO_ODR) |= bus->sdaPin;      // enable open drain on SDA
+    GPIO_REG(bus->portBase, GPIO_DEN) |= bus->pins;        // enable digital I/O on SCL, SDA
+    GPIO_REG(bus->portBase, GPIO_PCTL) &= ~bus->pctlMask;  // clear bit fields for SCL, SDA
+    GPIO_REG(bus->portBase, GPIO_PCTL) |= bus->pctlValue;  // configure SCL, SDA as I2C
+    GPIO_REG(bus->portBase, GPIO_AMSEL) &= ~bus->pins;     // disable analog functionality on SCL, SDA
     
-    /*-- Port E Set Up --*/
-    GPIO_PORTE_AFSEL_R |= 0x30;                            // enable alt function on PE4, 5
-    GPIO_PORTE_ODR_R |= 0x20;                              // enable open drain on PE5
-    GPIO_PORTE_DEN_R |= 0x30;                              // enable digital I/O on PE4, 5
-    GPIO_PORTE_PCTL_R &= ((~GPIO_PCTL_PE4_M) &             // clear bit fields for PE4
-                          (~GPIO_PCTL_PE5_M));             // clear bit fields for PE5
-    GPIO_PORTE_PCTL_R |= (GPIO_PCTL_PE4_I2C2SCL |          // configure PE4 as I2C2SCL
-                          GPIO_PCTL_PE5_I2C2SDA);          // configure PE5 as I2C2SDA
-    GPIO_PORTE_AMSEL_R &= ~0x30;                           // disable analog functionality on PE4, 5
-    
-    /*-- I2C2 Set Up --*/
-    I2C2_MCR_R = I2C_MCR_MFE;                              // master function enable
-    I2C2_MTPR_R = 39;                                      // configure for 100 kbps clock
-    // 20 * (TPR + 1) * 12.5ns = 10us, with TPR=24
-#elif defined I2C3
-    /*-- I2C3 and Port D Activation --*/
-    SYSCTL_RCGCI2C_R |= SYSCTL_RCGCI2C_R3;                 // enable I2C Module 3 clock
-    SYSCTL_RCGCGPIO_R |= SYSCTL_RCGCGPIO_R3;               // enable GPIO Port D clock
-    while ((SYSCTL_PRGPIO_R & SYSCTL_PRGPIO_R3) == 0) {};  // allow time for activating
-    
-    /*-- Port D Set Up --*/
-    GPIO_PORTD_AFSEL_R |= 0x03;                            // enable alt function on PD0, 1
-    GPIO_PORTD_ODR_R |= 0x02;                              // enable open drain on PD1
-    GPIO_PORTD_DEN_R |= 0x03;                              // enable digital I/O on PD0, 1
-    GPIO_PORTD_PCTL_R &= ((~GPIO_PCTL_PD0_M) &             // clear bit fields for PD0
-                          (~GPIO_PCTL_PD1_M));             // clear bit fields for PD1
-    GPIO_PORTD_PCTL_R |= (GPIO_PCTL_PD0_I2C3SCL |          // configure PD0 as I2C3SCL
-                          GPIO_PCTL_PD1_I2C3SDA);          // configure PD1 as I2C3SDA
-    GPIO_PORTD_AMSEL_R &= ~0x03;                           // disable analog functionality on PD0, 1
+    /*-- I2C Set Up --*/
+    bus->registers->MCR = I2C_MCR_MFE;                     // master function enable
+    // configure for 100 kbps clock from whatever bus clock PLL_Init selected
+    bus->registers->MTPR = I2C_computeTPR(PLL_GetBusClock(), I2C_SPEED_STANDARD);
+    bus->registers->MIMR = 0;                              // engine unmasks while it has work
+    NVIC_PRI(bus->irq) = 2 << 5;                           // priority 2
+    NVIC_EN(bus->irq) = 1 << (bus->irq % 32);              // enable interrupt in NVIC
+}
+
+/**
+ * I2C_computeTPR
+ * ----------
+ * @param  busClock  system clock in Hz.
+ * @param  speedKHz  desired SCL clock in kHz.
+ * ----------
+ * @return timer period for MTPR, rounded so SCL never runs faster than asked.
+ * ----------
+ * @brief SCL period = 20 * (1 + TPR) / busClock.
+ */
+uint32_t I2C_computeTPR(uint32_t busClock, uint32_t speedKHz) {
+    uint32_t divider = 20 * 1000 * speedKHz;                         // bus clocks per SCL period / (1 + TPR)
+    uint32_t tpr = (busClock + divider - 1) / divider;               // round up, 1 + TPR
     
-    /*-- I2C3 Set Up --*/
-    I2C3_MCR_R = I2C_MCR_MFE;                              // master function enable
-    I2C3_MTPR_R = 39 ;                                     // configure for 100 kbps clock
-    // 20 * (TPR + 1) * 12.5ns = 10us, with TPR=24
-#endif
+    if (tpr > 1) tpr--;                                              // TPR = 0 is reserved
+    if (tpr > I2C_MTPR_TPR_M) tpr = I2C_MTPR_TPR_M;                  // 7 bit field, slowest possible
+    return tpr;
+}
+
+/**
+ * I2C_setSpeed
+ * ----------
+ * @param  bus       I2C module.
+ * @param  speedKHz  SCL clock in kHz, e.g. I2C_SPEED_FAST.
+ * ----------
+ * @brief change SCL clock of the I2C module, computed from the bus clock
+ *        selected by PLL_Init. Waits for queued transactions to finish.
+ */
+void I2C_setSpeed(I2C_Bus* bus, uint32_t speedKHz) {
+    while (!I2C_isIdle(bus)) {};                                     // let queued transactions finish
+    while (bus->registers->MCS & I2C_MCS_BUSY) {};                   // wait for I2C ready
+    bus->registers->MTPR = I2C_computeTPR(PLL_GetBusClock(), speedKHz);
 }
 
 
@@ -123,636 +153,481 @@ void I2C_Init() {
 /**
  * I2C_read
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data address to store read data.
  * @param  count          number of bytes to be read.
  * ----------
- * @brief read 1 or more bytes from slave device.
+ * @brief read 1 or more bytes from slave device. The target register is sent
+ *        and the data read back in one transaction joined by a repeated start.
  */
-int I2C_read(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data, uint32_t count) {
+int I2C_read(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data, uint32_t count) {
     
+    I2C_Registers* i2c = bus->registers;
     int retryCounter = 1;
     
-#ifdef I2C0
-    while (I2C0_MCS_R & I2C_MCS_BUSY) {};                            // wait for I2C ready
-    I2C0_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;                // MSA[7:1] is slave address
-    I2C0_MSA_R &= ~I2C_MSA_RS;                                       // MSA[0] is 0 for send
-    
-    I2C0_MDR_R = targetRegister & I2C_MDR_DATA_M;                    // prepare targetRegister
-    I2C0_MCS_R = (I2C_MCS_STOP  |                                    // generate stop
-                  I2C_MCS_START |                                    // generate start/restart
-                  I2C_MCS_RUN);                                      // master enable
-    while (I2C0_MCS_R & I2C_MCS_BUSY) {};                            // wait for transmission done
-    // check error bits
-    if((I2C0_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-        return (I2C0_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-    }
-    
-    switch (count) {
-        case 1:
-            do {
-                while (I2C0_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C0_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C0_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C0_MCS_R = (I2C_MCS_STOP  |                        // generate stop
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C0_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C0_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            data[0] = (I2C0_MDR_R & I2C_MDR_DATA_M);                 // usually 0xFF on error
-            
-            break;
-        case 2:
-            do {
-                while (I2C0_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C0_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C0_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C0_MCS_R = (I2C_MCS_ACK   |                        // positive data ack
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C0_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[0] = (I2C0_MDR_R & I2C_MDR_DATA_M);             // most significant byte
-                
-                I2C0_MCS_R = (I2C_MCS_STOP |                         // generate stop
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C0_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[1] = (I2C0_MDR_R & I2C_MDR_DATA_M);             // least significant byte
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C0_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            
-            break;
-            
-        default:
-            do {
-                while (I2C0_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C0_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C0_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C0_MCS_R = (I2C_MCS_ACK   |                        // positive data ack
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C0_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[0] = (I2C0_MDR_R & I2C_MDR_DATA_M);             // most significant byte
-                
-                
-                for (int i = 1; i < count - 1; i++) {
-                    I2C0_MCS_R = (I2C_MCS_ACK |                      // positive data ack
-                                  I2C_MCS_RUN);                      // master enable
-                    while (I2C0_MCS_R & I2C_MCS_BUSY) {};            // wait for transmission done
-                    data[i] = (I2C0_MDR_R & I2C_MDR_DATA_M);         // read byte
-                }
-                
-                I2C0_MCS_R = (I2C_MCS_STOP |                         // generate stop
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C0_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[count - 1] = (I2C0_MDR_R & I2C_MDR_DATA_M);     // least significant byte
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C0_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            
-            break;
-    }
-    
-    return (I2C0_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-#elif defined I2C1
-    while (I2C1_MCS_R & I2C_MCS_BUSY) {};                            // wait for I2C ready
-    I2C1_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;                // MSA[7:1] is slave address
-    I2C1_MSA_R &= ~I2C_MSA_RS;                                       // MSA[0] is 0 for send
-    
-    I2C1_MDR_R = targetRegister & I2C_MDR_DATA_M;                    // prepare targetRegister
-    I2C1_MCS_R = (I2C_MCS_STOP  |                                    // generate stop
-                  I2C_MCS_START |                                    // generate start/restart
-                  I2C_MCS_RUN);                                      // master enable
-    while (I2C1_MCS_R & I2C_MCS_BUSY) {};                            // wait for transmission done
-    // check error bits
-    if((I2C1_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-        return (I2C1_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-    }
-    
-    switch (count) {
-        case 1:
-            do {
-                while (I2C1_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C1_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C1_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C1_MCS_R = (I2C_MCS_STOP  |                        // generate stop
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C1_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C1_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            data[0] = (I2C1_MDR_R & I2C_MDR_DATA_M);                 // usually 0xFF on error
-            
-            break;
-        case 2:
-            do {
-                while (I2C1_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C1_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C1_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C1_MCS_R = (I2C_MCS_ACK   |                        // positive data ack
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C1_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[0] = (I2C1_MDR_R & I2C_MDR_DATA_M);             // most significant byte
-                
-                I2C1_MCS_R = (I2C_MCS_STOP |                         // generate stop
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C1_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[1] = (I2C1_MDR_R & I2C_MDR_DATA_M);             // least significant byte
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C1_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            
-            break;
-            
-        default:
-            do {
-                while (I2C1_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C1_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C1_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C1_MCS_R = (I2C_MCS_ACK   |                        // positive data ack
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C1_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[0] = (I2C1_MDR_R & I2C_MDR_DATA_M);             // most significant byte
-                
-                
-                for (int i = 1; i < count - 1; i++) {
-                    I2C1_MCS_R = (I2C_MCS_ACK |                      // positive data ack
-                                  I2C_MCS_RUN);                      // master enable
-                    while (I2C1_MCS_R & I2C_MCS_BUSY) {};            // wait for transmission done
-                    data[i] = (I2C1_MDR_R & I2C_MDR_DATA_M);         // read byte
-                }
-                
-                I2C1_MCS_R = (I2C_MCS_STOP |                         // generate stop
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C1_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[count - 1] = (I2C1_MDR_R & I2C_MDR_DATA_M);     // least significant byte
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C1_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            
-            break;
-    }
-    
-    return (I2C1_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-#elif defined I2C2
-    while (I2C2_MCS_R & I2C_MCS_BUSY) {};                            // wait for I2C ready
-    I2C2_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;                // MSA[7:1] is slave address
-    I2C2_MSA_R &= ~I2C_MSA_RS;                                       // MSA[0] is 0 for send
+    while (!I2C_isIdle(bus)) {};                                     // let queued transactions finish
     
-    I2C2_MDR_R = targetRegister & I2C_MDR_DATA_M;                    // prepare targetRegister
-    I2C2_MCS_R = (I2C_MCS_STOP  |                                    // generate stop
-                  I2C_MCS_START |                                    // generate start/restart
-                  I2C_MCS_RUN);                                      // master enable
-    while (I2C2_MCS_R & I2C_MCS_BUSY) {};                            // wait for transmission done
-    // check error bits
-    if((I2C2_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-        return (I2C2_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-    }
-    
-    switch (count) {
-        case 1:
-            do {
-                while (I2C2_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C2_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C2_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C2_MCS_R = (I2C_MCS_STOP  |                        // generate stop
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C2_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C2_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            data[0] = (I2C2_MDR_R & I2C_MDR_DATA_M);                 // usually 0xFF on error
-            
-            break;
-        case 2:
-            do {
-                while (I2C2_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C2_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C2_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C2_MCS_R = (I2C_MCS_ACK   |                        // positive data ack
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C2_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[0] = (I2C2_MDR_R & I2C_MDR_DATA_M);             // most significant byte
-                
-                I2C2_MCS_R = (I2C_MCS_STOP |                         // generate stop
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C2_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[1] = (I2C2_MDR_R & I2C_MDR_DATA_M);             // least significant byte
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C2_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            
-            break;
-            
-        default:
-            do {
-                while (I2C2_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C2_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C2_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C2_MCS_R = (I2C_MCS_ACK   |                        // positive data ack
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C2_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[0] = (I2C2_MDR_R & I2C_MDR_DATA_M);             // most significant byte
-                
-                
-                for (int i = 1; i < count - 1; i++) {
-                    I2C2_MCS_R = (I2C_MCS_ACK |                      // positive data ack
-                                  I2C_MCS_RUN);                      // master enable
-                    while (I2C2_MCS_R & I2C_MCS_BUSY) {};            // wait for transmission done
-                    data[i] = (I2C2_MDR_R & I2C_MDR_DATA_M);         // read byte
-                }
-                
-                I2C2_MCS_R = (I2C_MCS_STOP |                         // generate stop
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C2_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[count - 1] = (I2C2_MDR_R & I2C_MDR_DATA_M);     // least significant byte
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C2_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            
-            break;
-    }
-    
-    return (I2C2_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-#elif defined I2C3
-    while (I2C3_MCS_R & I2C_MCS_BUSY) {};                            // wait for I2C ready
-    I2C3_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;                // MSA[7:1] is slave address
-    I2C3_MSA_R &= ~I2C_MSA_RS;                                       // MSA[0] is 0 for send
-    
-    I2C3_MDR_R = targetRegister & I2C_MDR_DATA_M;                    // prepare targetRegister
-    I2C3_MCS_R = (I2C_MCS_STOP  |                                    // generate stop
-                  I2C_MCS_START |                                    // generate start/restart
-                  I2C_MCS_RUN);                                      // master enable
-    while (I2C3_MCS_R & I2C_MCS_BUSY) {};                            // wait for transmission done
-    // check error bits
-    if((I2C3_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-        return (I2C3_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-    }
-    
-    switch (count) {
-        case 1:
-            do {
-                while (I2C3_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C3_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C3_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C3_MCS_R = (I2C_MCS_STOP  |                        // generate stop
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C3_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C3_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            data[0] = (I2C3_MDR_R & I2C_MDR_DATA_M);                 // usually 0xFF on error
-            
-            break;
-        case 2:
-            do {
-                while (I2C3_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C3_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C3_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C3_MCS_R = (I2C_MCS_ACK   |                        // positive data ack
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C3_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[0] = (I2C3_MDR_R & I2C_MDR_DATA_M);             // most significant byte
-                
-                I2C3_MCS_R = (I2C_MCS_STOP |                         // generate stop
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C3_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[1] = (I2C3_MDR_R & I2C_MDR_DATA_M);             // least significant byte
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C3_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            
-            break;
-            
-        default:
-            do {
-                while (I2C3_MCS_R & I2C_MCS_BUSY) {};                // wait for I2C ready
-                I2C3_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;    // MSA[7:1] is slave address
-                I2C3_MSA_R |= I2C_MSA_RS;                            // MSA[0] is 1 for receive
-                
-                I2C3_MCS_R = (I2C_MCS_ACK   |                        // positive data ack
-                              I2C_MCS_START |                        // generate start/restart
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C3_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[0] = (I2C3_MDR_R & I2C_MDR_DATA_M);             // most significant byte
-                
-                
-                for (int i = 1; i < count - 1; i++) {
-                    I2C3_MCS_R = (I2C_MCS_ACK |                      // positive data ack
-                                  I2C_MCS_RUN);                      // master enable
-                    while (I2C3_MCS_R & I2C_MCS_BUSY) {};            // wait for transmission done
-                    data[i] = (I2C3_MDR_R & I2C_MDR_DATA_M);         // read byte
+    do {
+        while (i2c->MCS & I2C_MCS_BUSY) {};                          // wait for I2C ready
+        i2c->MSA = (deviceAddress << 1) & I2C_MSA_SA_M;              // MSA[7:1] is slave address
+        i2c->MSA &= ~I2C_MSA_RS;                                     // MSA[0] is 0 for send
+        
+        i2c->MDR = targetRegister & I2C_MDR_DATA_M;                  // prepare targetRegister
+        i2c->MCS = (I2C_MCS_START |                                  // generate start, no stop,
+                    I2C_MCS_RUN);                                    // the read follows with a restart
+        while (i2c->MCS & I2C_MCS_BUSY) {};                          // wait for transmission done
+        // check error bits
+        if((i2c->MCS & I2C_ERROR_BITS) != 0){
+            if ((i2c->MCS & I2C_MCS_ARBLST) == 0) {
+                i2c->MCS = I2C_MCS_STOP;                             // stop transmission
+            }
+            return (i2c->MCS & I2C_ERROR_BITS);
+        }
+        
+        i2c->MSA |= I2C_MSA_RS;                                      // MSA[0] is 1 for receive
+        for (int i = 0; i < count; i++) {
+            i2c->MCS = ((i == 0) ? I2C_MCS_START : 0) |              // repeated start on first byte
+                       ((i == count - 1) ? I2C_MCS_STOP :            // nack and stop on last byte
+                                           I2C_MCS_ACK)  |           // positive data ack otherwise
+                       I2C_MCS_RUN;                                  // master enable
+            while (i2c->MCS & I2C_MCS_BUSY) {};                      // wait for transmission done
+            if ((i2c->MCS & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) {
+                if ((i2c->MCS & I2C_MCS_ARBLST) == 0) {
+                    i2c->MCS = I2C_MCS_STOP;                         // stop transmission
                 }
-                
-                I2C3_MCS_R = (I2C_MCS_STOP |                         // generate stop
-                              I2C_MCS_RUN);                          // master enable
-                while (I2C3_MCS_R & I2C_MCS_BUSY) {};                // wait for transmission done
-                data[count - 1] = (I2C3_MDR_R & I2C_MDR_DATA_M);     // least significant byte
-                retryCounter++;                                      // increment retry counter
-            }                                                        // repeat if error
-            while (((I2C3_MCS_R & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
-            
-            break;
-    }
+                break;
+            }
+            data[i] = (i2c->MDR & I2C_MDR_DATA_M);                   // read byte, msb first
+        }
+        retryCounter++;                                              // increment retry counter
+    }                                                                // repeat if error
+    while (((i2c->MCS & (I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0) && (retryCounter <= MAXRETRIES));
     
-    return (I2C3_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-#endif
+    return (i2c->MCS & I2C_ERROR_BITS);
 }
 
 /**
  * I2C_write
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
- * @param  data          data address of data to be writen.
+ * @param  data           data address of data to be writen.
  * @param  count          number of bytes to be writen.
  * ----------
  * @brief write 1 or more bytes to slave device.
  */
-int I2C_write(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data, uint32_t count) {
-#ifdef I2C0
-    while (I2C0_MCS_R & I2C_MCS_BUSY) {};                            // wait for I2C ready
-    I2C0_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;                // MSA[7:1] is slave address
-    I2C0_MSA_R &= ~I2C_MSA_RS;                                       // MSA[0] is 0 for send
+int I2C_write(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data, uint32_t count) {
     
-    I2C0_MDR_R = targetRegister & I2C_MDR_DATA_M;                    // prepare targetRegister
-    I2C0_MCS_R = (I2C_MCS_START |                                    // generate start/restart
-                  I2C_MCS_RUN);                                      // master enable
-    while (I2C0_MCS_R & I2C_MCS_BUSY) {};                            // wait for transmission done
-    // check error bits
-    if((I2C0_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-        I2C0_MCS_R = I2C_MCS_STOP;                                   // stop transmission
-        // return error bits if nonzero
-        return (I2C0_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-    }
+    I2C_Registers* i2c = bus->registers;
     
-    if (count == 1) {
-        I2C0_MDR_R = data[0] & I2C_MDR_DATA_M;                       // prepare data byte
-        I2C0_MCS_R = (I2C_MCS_STOP |                                 // generate stop
-                      I2C_MCS_RUN);                                  // master enable
-        while (I2C0_MCS_R & I2C_MCS_BUSY) {};                        // wait for transmission done
-        // return error bits
-        return (I2C0_MCS_R&(I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-        
-    } else {
-        for (int i = 0; i < count - 1; i++) {
-            I2C0_MDR_R = data[i] & I2C_MDR_DATA_M;                   // prepare data byte
-            I2C0_MCS_R = I2C_MCS_RUN;                                // master enable
-            while (I2C0_MCS_R & I2C_MCS_BUSY) {};                    // wait for transmission done
-            // check error bits
-            if((I2C0_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-                I2C0_MCS_R = I2C_MCS_STOP;                           // stop transmission
-                // return error bits if nonzero
-                return (I2C0_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-            }
-        }
-        
-        I2C0_MDR_R = data[count - 1] & I2C_MDR_DATA_M;               // prepare last byte
-        I2C0_MCS_R = (I2C_MCS_STOP |                                 // generate stop
-                      I2C_MCS_RUN);                                  // master enable
-        while (I2C0_MCS_R & I2C_MCS_BUSY) {};                        // wait for transmission done
-        // return error bits
-        return (I2C0_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-    }
-#elif defined I2C1
-    while (I2C1_MCS_R & I2C_MCS_BUSY) {};                            // wait for I2C ready
-    I2C1_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;                // MSA[7:1] is slave address
-    I2C1_MSA_R &= ~I2C_MSA_RS;                                       // MSA[0] is 0 for send
+    while (!I2C_isIdle(bus)) {};                                     // let queued transactions finish
     
-    I2C1_MDR_R = targetRegister & I2C_MDR_DATA_M;                    // prepare targetRegister
-    I2C1_MCS_R = (I2C_MCS_START |                                    // generate start/restart
-                  I2C_MCS_RUN);                                      // master enable
-    while (I2C1_MCS_R & I2C_MCS_BUSY) {};                            // wait for transmission done
-    // check error bits
-    if((I2C1_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-        I2C1_MCS_R = I2C_MCS_STOP;                                   // stop transmission
-        // return error bits if nonzero
-        return (I2C1_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-    }
+    while (i2c->MCS & I2C_MCS_BUSY) {};                              // wait for I2C ready
+    i2c->MSA = (deviceAddress << 1) & I2C_MSA_SA_M;                  // MSA[7:1] is slave address
+    i2c->MSA &= ~I2C_MSA_RS;                                         // MSA[0] is 0 for send
     
-    if (count == 1) {
-        I2C1_MDR_R = data[0] & I2C_MDR_DATA_M;                       // prepare data byte
-        I2C1_MCS_R = (I2C_MCS_STOP |                                 // generate stop
-                      I2C_MCS_RUN);                                  // master enable
-        while (I2C1_MCS_R & I2C_MCS_BUSY) {};                        // wait for transmission done
-        // return error bits
-        return (I2C1_MCS_R&(I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-        
-    } else {
-        for (int i = 0; i < count - 1; i++) {
-            I2C1_MDR_R = data[i] & I2C_MDR_DATA_M;                   // prepare data byte
-            I2C1_MCS_R = I2C_MCS_RUN;                                // master enable
-            while (I2C1_MCS_R & I2C_MCS_BUSY) {};                    // wait for transmission done
-            // check error bits
-            if((I2C1_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-                I2C1_MCS_R = I2C_MCS_STOP;                           // stop transmission
-                // return error bits if nonzero
-                return (I2C1_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-            }
-        }
-        
-        I2C1_MDR_R = data[count - 1] & I2C_MDR_DATA_M;               // prepare last byte
-        I2C1_MCS_R = (I2C_MCS_STOP |                                 // generate stop
-                      I2C_MCS_RUN);                                  // master enable
-        while (I2C1_MCS_R & I2C_MCS_BUSY) {};                        // wait for transmission done
-        // return error bits
-        return (I2C1_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-    }
-#elif defined I2C2
-    while (I2C2_MCS_R & I2C_MCS_BUSY) {};                            // wait for I2C ready
-    I2C2_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;                // MSA[7:1] is slave address
-    I2C2_MSA_R &= ~I2C_MSA_RS;                                       // MSA[0] is 0 for send
-    
-    I2C2_MDR_R = targetRegister & I2C_MDR_DATA_M;                    // prepare targetRegister
-    I2C2_MCS_R = (I2C_MCS_START |                                    // generate start/restart
-                  I2C_MCS_RUN);                                      // master enable
-    while (I2C2_MCS_R & I2C_MCS_BUSY) {};                            // wait for transmission done
+    i2c->MDR = targetRegister & I2C_MDR_DATA_M;                      // prepare targetRegister
+    i2c->MCS = (I2C_MCS_START |                                      // generate start/restart
+                I2C_MCS_RUN);                                        // master enable
+    while (i2c->MCS & I2C_MCS_BUSY) {};                              // wait for transmission done
     // check error bits
-    if((I2C2_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-        I2C2_MCS_R = I2C_MCS_STOP;                                   // stop transmission
+    if((i2c->MCS & I2C_ERROR_BITS) != 0){
+        i2c->MCS = I2C_MCS_STOP;                                     // stop transmission
         // return error bits if nonzero
-        return (I2C2_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
+        return (i2c->MCS & I2C_ERROR_BITS);
     }
     
-    if (count == 1) {
-        I2C2_MDR_R = data[0] & I2C_MDR_DATA_M;                       // prepare data byte
-        I2C2_MCS_R = (I2C_MCS_STOP |                                 // generate stop
-                      I2C_MCS_RUN);                                  // master enable
-        while (I2C2_MCS_R & I2C_MCS_BUSY) {};                        // wait for transmission done
-        // return error bits
-        return (I2C2_MCS_R&(I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-        
-    } else {
-        for (int i = 0; i < count - 1; i++) {
-            I2C2_MDR_R = data[i] & I2C_MDR_DATA_M;                   // prepare data byte
-            I2C2_MCS_R = I2C_MCS_RUN;                                // master enable
-            while (I2C2_MCS_R & I2C_MCS_BUSY) {};                    // wait for transmission done
-            // check error bits
-            if((I2C2_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-                I2C2_MCS_R = I2C_MCS_STOP;                           // stop transmission
-                // return error bits if nonzero
-                return (I2C2_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-            }
+    for (int i = 0; i < count - 1; i++) {
+        i2c->MDR = data[i] & I2C_MDR_DATA_M;                         // prepare data byte
+        i2c->MCS = I2C_MCS_RUN;                                      // master enable
+        while (i2c->MCS & I2C_MCS_BUSY) {};                          // wait for transmission done
+        // check error bits
+        if((i2c->MCS & I2C_ERROR_BITS) != 0){
+            i2c->MCS = I2C_MCS_STOP;                                 // stop transmission
+            // return error bits if nonzero
+            return (i2c->MCS & I2C_ERROR_BITS);
         }
-        
-        I2C2_MDR_R = data[count - 1] & I2C_MDR_DATA_M;               // prepare last byte
-        I2C2_MCS_R = (I2C_MCS_STOP |                                 // generate stop
-                      I2C_MCS_RUN);                                  // master enable
-        while (I2C2_MCS_R & I2C_MCS_BUSY) {};                        // wait for transmission done
-        // return error bits
-        return (I2C2_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-    }
-#elif defined I2C3
-    while (I2C3_MCS_R & I2C_MCS_BUSY) {};                            // wait for I2C ready
-    I2C3_MSA_R = (deviceAddress << 1) & I2C_MSA_SA_M;                // MSA[7:1] is slave address
-    I2C3_MSA_R &= ~I2C_MSA_RS;                                       // MSA[0] is 0 for send
-    
-    I2C3_MDR_R = targetRegister & I2C_MDR_DATA_M;                    // prepare targetRegister
-    I2C3_MCS_R = (I2C_MCS_START |                                    // generate start/restart
-                  I2C_MCS_RUN);                                      // master enable
-    while (I2C3_MCS_R & I2C_MCS_BUSY) {};                            // wait for transmission done
-    // check error bits
-    if((I2C3_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-        I2C3_MCS_R = I2C_MCS_STOP;                                   // stop transmission
-        // return error bits if nonzero
-        return (I2C3_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
     }
     
-    if (count == 1) {
-        I2C3_MDR_R = data[0] & I2C_MDR_DATA_M;                       // prepare data byte
-        I2C3_MCS_R = (I2C_MCS_STOP |                                 // generate stop
-                      I2C_MCS_RUN);                                  // master enable
-        while (I2C3_MCS_R & I2C_MCS_BUSY) {};                        // wait for transmission done
-        // return error bits
-        return (I2C3_MCS_R&(I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-        
-    } else {
-        for (int i = 0; i < count - 1; i++) {
-            I2C3_MDR_R = data[i] & I2C_MDR_DATA_M;                   // prepare data byte
-            I2C3_MCS_R = I2C_MCS_RUN;                                // master enable
-            while (I2C3_MCS_R & I2C_MCS_BUSY) {};                    // wait for transmission done
-            // check error bits
-            if((I2C3_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR)) != 0){
-                I2C3_MCS_R = I2C_MCS_STOP;                           // stop transmission
-                // return error bits if nonzero
-                return (I2C3_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-            }
-        }
-        
-        I2C3_MDR_R = data[count - 1] & I2C_MDR_DATA_M;               // prepare last byte
-        I2C3_MCS_R = (I2C_MCS_STOP |                                 // generate stop
-                      I2C_MCS_RUN);                                  // master enable
-        while (I2C3_MCS_R & I2C_MCS_BUSY) {};                        // wait for transmission done
-        // return error bits
-        return (I2C3_MCS_R & (I2C_MCS_DATACK|I2C_MCS_ADRACK|I2C_MCS_ERROR));
-    }
-#endif
+    i2c->MDR = data[count - 1] & I2C_MDR_DATA_M;                     // prepare last byte
+    i2c->MCS = (I2C_MCS_STOP |                                       // generate stop
+                I2C_MCS_RUN);                                        // master enable
+    while (i2c->MCS & I2C_MCS_BUSY) {};                              // wait for transmission done
+    // return error bits
+    return (i2c->MCS & I2C_ERROR_BITS);
 }
 
 /**
  * I2C_read_byte
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 1 byte from slave device.
  */
-int I2C_read_byte(uint8_t deviceAddress, uint8_t targetRegister, uint8_t *data) {
+int I2C_read_byte(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t *data) {
     // read 1 byte
-    return I2C_read(deviceAddress, targetRegister, data, 1);
+    return I2C_read(bus, deviceAddress, targetRegister, data, 1);
 }
 
 
 /**
  * I2C_write_byte
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data to be writen.
  * ----------
  * @brief write 1 byte to slave device.
  */
-int I2C_write_byte(uint8_t deviceAddress, uint8_t targetRegister, uint8_t data) {
+int I2C_write_byte(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t data) {
     // write 1 byte
-    return I2C_write(deviceAddress, targetRegister, &data, 1);
+    return I2C_write(bus, deviceAddress, targetRegister, &data, 1);
 }
 
 /**
  * I2C_read_2_bytes
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 2 bytes from slave device.
  */
-int I2C_read_2_bytes(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data) {
+int I2C_read_2_bytes(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data) {
     // read 2 bytes
-    return I2C_read(deviceAddress, targetRegister, data, 2);
+    return I2C_read(bus, deviceAddress, targetRegister, data, 2);
 }
 
 /**
  * I2C_write_2_bytes
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data to be writen.
  * ----------
  * @brief write 2 bytes to slave device.
  */
-int I2C_write_2_bytes(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data) {
+int I2C_write_2_bytes(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data) {
     // write 2 bytes
-    return I2C_write(deviceAddress, targetRegister, data, 2);
+    return I2C_write(bus, deviceAddress, targetRegister, data, 2);
 }
 
 /**
  * I2C_read_4_bytes
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data address to store read data.
  * ----------
  * @brief read 4 bytes from slave device.
  */
-int I2C_read_4_bytes(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data) {
+int I2C_read_4_bytes(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data) {
     // read 4 bytes
-    return I2C_read(deviceAddress, targetRegister, data, 4);
+    return I2C_read(bus, deviceAddress, targetRegister, data, 4);
 }
 
 /**
  * I2C_write_4_bytes
  * ----------
+ * @param  bus            I2C module the slave device is wired to.
  * @param  deviceAddress  address of slave device.
  * @param  targetRegister target register of slave device.
  * @param  data           data to be writen.
  * ----------
  * @brief write 4 bytes to slave device.
  */
-int I2C_write_4_bytes(uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data) {
+int I2C_write_4_bytes(I2C_Bus* bus, uint8_t deviceAddress, uint8_t targetRegister, uint8_t* data) {
     // write 4 bytes
-    return I2C_write(deviceAddress, targetRegister, data, 4);
+    return I2C_write(bus, deviceAddress, targetRegister, data, 4);
+}
+
+
+/****************************************************
+ *                                                  *
+ *                  Async R/W API                   *
+ *                                                  *
+ ****************************************************/
+
+/**
+ * I2C_start
+ * ----------
+ * @param  bus          I2C module.
+ * @param  transaction  transaction to put on the bus.
+ * ----------
+ * @brief send the address and target register of a transaction,
+ *        the rest is done by I2C_service.
+ */
+static void I2C_start(I2C_Bus* bus, I2C_Transaction* transaction) {
+    I2C_Registers* i2c = bus->registers;
+    
+    bus->current = transaction;
+    bus->phase = I2C_PHASE_REGISTER;
+    bus->position = 0;
+    
+    i2c->MSA = (transaction->deviceAddress << 1) & I2C_MSA_SA_M;     // MSA[7:1] is slave address, MSA[0] is 0 for send
+    i2c->MDR = transaction->targetRegister & I2C_MDR_DATA_M;         // prepare targetRegister
+    
+    if (transaction->count == 0) {
+        i2c->MCS = (I2C_MCS_STOP  |                                  // generate stop
+                    I2C_MCS_START |                                  // generate start/restart
+                    I2C_MCS_RUN);                                    // master enable
+    } else {
+        i2c->MCS = (I2C_MCS_START |                                  // generate start/restart
+                    I2C_MCS_RUN);                                    // master enable
+    }
+}
+
+/**
+ * I2C_drop
+ * ----------
+ * @param  bus    I2C module.
+ * @param  group  group that failed.
+ * ----------
+ * @brief take the queued transactions of a failed group out of the queue,
+ *        keeping the order of the others, and complete them as dropped.
+ */
+static void I2C_drop(I2C_Bus* bus, volatile int* group) {
+    I2C_Transaction* dropped[I2C_QUEUE_SIZE];
+    uint32_t from, to = bus->queueHead, count = 0;
+    
+    for (from = bus->queueHead; from != bus->queueTail; from = (from + 1) % I2C_QUEUE_SIZE) {
+        if (bus->queue[from]->group == group) {
+            dropped[count++] = bus->queue[from];
+        } else {
+            bus->queue[to] = bus->queue[from];
+            to = (to + 1) % I2C_QUEUE_SIZE;
+        }
+    }
+    bus->queueTail = to;
+    
+    // callbacks last, the queue is consistent if they submit again
+    for (from = 0; from < count; from++) {
+        dropped[from]->status = I2C_DROPPED;
+        if (dropped[from]->callback) dropped[from]->callback(dropped[from]);
+    }
+}
+
+/**
+ * I2C_finish
+ * ----------
+ * @param  bus     I2C module.
+ * @param  status  error bits of the current transaction.
+ * ----------
+ * @brief complete the current transaction and put the next one on the bus.
+ */
+static void I2C_finish(I2C_Bus* bus, int status) {
+    I2C_Transaction* transaction = bus->current;
+    
+    bus->current = 0;
+    if (status != 0 && transaction->group != 0) {                    // the rest of its group must not run
+        if (*transaction->group == 0) *transaction->group = status;
+        I2C_drop(bus, transaction->group);
+    }
+    if (bus->queueHead != bus->queueTail) {                          // start next transaction first,
+        I2C_Transaction* next = bus->queue[bus->queueHead];          // so the bus keeps running
+        bus->queueHead = (bus->queueHead + 1) % I2C_QUEUE_SIZE;      // while the callback runs
+        I2C_start(bus, next);
+    } else {
+        bus->registers->MIMR = 0;                                               // nothing left, mask interrupt
+    }
+    
+    transaction->status = status;
+    if (transaction->callback) transaction->callback(transaction);
 }
 
+/**
+ * I2C_submit
+ * ----------
+ * @param  bus          I2C module the slave device is wired to.
+ * @param  transaction  transaction to be queued.
+ * ----------
+ * @return 0 if queued, -1 if the queue is full (status is left as it was).
+ * ----------
+ * @brief queue a transaction for the interrupt driven engine and return
+ *        right away. The I2C interrupt moves the transaction along byte by
+ *        byte and calls its callback once it is done. A transaction of a
+ *        group that already failed is completed as I2C_DROPPED at once.
+ */
+int I2C_submit(I2C_Bus* bus, I2C_Transaction* transaction) {
+    uint32_t next;
+    int result = 0;
+    
+    bus->registers->MIMR = 0;                                        // hold off the engine while queueing
+    
+    if (transaction->group != 0 && *transaction->group != 0) {
+        transaction->status = I2C_DROPPED;                           // its group failed, never goes out
+        if (bus->current != 0) bus->registers->MIMR = I2C_MIMR_IM;
+        if (transaction->callback) transaction->callback(transaction);
+        return 0;
+    }
+    
+    if (bus->current == 0) {
+        transaction->status = I2C_PENDING;
+        I2C_start(bus, transaction);                                 // bus is free, go now
+    } else {
+        next = (bus->queueTail + 1) % I2C_QUEUE_SIZE;
+        if (next == bus->queueHead) {
+            result = -1;                                             // queue is full, transaction untouched
+        } else {
+            transaction->status = I2C_PENDING;
+            bus->queue[bus->queueTail] = transaction;
+            bus->queueTail = next;
+        }
+    }
+    
+    bus->registers->MIMR = I2C_MIMR_IM;                                         // let the engine run
+    return result;
+}
+
+/**
+ * I2C_wait
+ * ----------
+ * @param  transaction  a submitted transaction.
+ * ----------
+ * @return error bits of the transaction, 0 on success, I2C_DROPPED if its
+ *         group failed first.
+ * ----------
+ * @brief wait for a submitted transaction to finish. Must not be called from the callback.
+ */
+int I2C_wait(I2C_Transaction* transaction) {
+    while (transaction->status == I2C_PENDING) {};
+    return transaction->status;
+}
+
+/**
+ * I2C_isIdle
+ * ----------
+ * @param  bus  I2C module.
+ * ----------
+ * @return 1 if no transaction is on the bus or queued, 0 otherwise.
+ */
+int I2C_isIdle(I2C_Bus* bus) {
+    return bus->current == 0;                                        // queue is only used while busy
+}
+
+/**
+ * I2C_write_script
+ * ----------
+ * @param  bus            I2C module the slave device is wired to.
+ * @param  deviceAddress  address of slave device.
+ * @param  script         (register, value) byte pairs, written in order.
+ * @param  count          number of pairs in script.
+ * ----------
+ * @return error bits of the first failed write, 0 on success.
+ * ----------
+ * @brief write a sequence of single byte registers as one queued burst.
+ *        The writes form a group: after a failed one, the engine drops the
+ *        rest still queued and none are submitted anymore.
+ */
+int I2C_write_script(I2C_Bus* bus, uint8_t deviceAddress, const uint8_t* script, uint32_t count) {
+    I2C_Transaction transactions[I2C_QUEUE_SIZE];                    // one slot per queue entry
+    I2C_Transaction* transaction;
+    volatile int failed = 0;                                         // first error, set by the engine
+    uint32_t i, first;
+    
+    for (i = 0; i < count && failed == 0; i++) {
+        transaction = &transactions[i % I2C_QUEUE_SIZE];
+        if (i >= I2C_QUEUE_SIZE) I2C_wait(transaction);              // slot is reused, wait for its last write
+        
+        transaction->deviceAddress = deviceAddress;
+        transaction->targetRegister = script[2 * i];
+        transaction->direction = I2C_TRANSACTION_WRITE;
+        transaction->data = (uint8_t *)&script[2 * i + 1];                // only read by the engine
+        transaction->count = 1;
+        transaction->callback = 0;
+        transaction->context = 0;
+        transaction->group = &failed;
+        while (I2C_submit(bus, transaction) != 0) {};                // queue shared with other users, retry when full
+    }
+    
+    // collect the writes still in flight, dropped ones are already done
+    first = (i > I2C_QUEUE_SIZE) ? i - I2C_QUEUE_SIZE : 0;
+    for (; first < i; first++) I2C_wait(&transactions[first % I2C_QUEUE_SIZE]);
+    
+    return failed;
+}
+
+/**
+ * I2C_service
+ * ----------
+ * @param  bus  I2C module that raised the interrupt.
+ * ----------
+ * @brief advance the transaction on the bus by one step, called by the I2C
+ *        master interrupt. Exposed so that a register model can drive it.
+ */
+void I2C_service(I2C_Bus* bus) {
+    I2C_Registers* i2c = bus->registers;
+    I2C_Transaction* transaction = bus->current;
+    uint32_t status;
+    
+    i2c->MICR = I2C_MICR_IC;                                         // acknowledge interrupt
+    if (transaction == 0) return;                                    // nothing on the bus
+    
+    status = i2c->MCS;
+    // check error bits
+    if ((status & I2C_ERROR_BITS) != 0) {
+        if ((status & I2C_MCS_ARBLST) == 0) {
+            i2c->MCS = I2C_MCS_STOP;                                 // stop transmission
+        }
+        I2C_finish(bus, status & I2C_ERROR_BITS);
+        return;
+    }
+    
+    switch (bus->phase) {
+        case I2C_PHASE_REGISTER:
+            if (transaction->count == 0) {
+                I2C_finish(bus, 0);
+            } else if (transaction->direction == I2C_TRANSACTION_WRITE) {
+                bus->phase = I2C_PHASE_WRITE;
+                i2c->MDR = transaction->data[bus->position++] & I2C_MDR_DATA_M;
+                i2c->MCS = (bus->position == transaction->count) ? (I2C_MCS_STOP | I2C_MCS_RUN) : I2C_MCS_RUN;
+            } else {
+                bus->phase = I2C_PHASE_READ;
+                i2c->MSA = ((transaction->deviceAddress << 1) & I2C_MSA_SA_M) | I2C_MSA_RS;
+                i2c->MCS = (transaction->count == 1) ?               // repeated start, no stop in between
+                           (I2C_MCS_STOP | I2C_MCS_START | I2C_MCS_RUN) :  // single byte, nack and stop
+                           (I2C_MCS_ACK  | I2C_MCS_START | I2C_MCS_RUN);   // more to come, ack
+            }
+            break;
+            
+        case I2C_PHASE_WRITE:
+            if (bus->position == transaction->count) {
+                I2C_finish(bus, 0);                                       // last byte and stop are out
+            } else {
+                i2c->MDR = transaction->data[bus->position++] & I2C_MDR_DATA_M;
+                i2c->MCS = (bus->position == transaction->count) ? (I2C_MCS_STOP | I2C_MCS_RUN) : I2C_MCS_RUN;
+            }
+            break;
+            
+        case I2C_PHASE_READ:
+            transaction->data[bus->position++] = i2c->MDR & I2C_MDR_DATA_M;
+            if (bus->position == transaction->count) {
+                I2C_finish(bus, 0);
+            } else {
+                i2c->MCS = (bus->position == transaction->count - 1) ?
+                           (I2C_MCS_STOP | I2C_MCS_RUN) :            // last byte, nack and stop
+                           (I2C_MCS_ACK  | I2C_MCS_RUN);             // positive data ack
+            }
+            break;
+    }
+}
+
+/**
+ * I2Cn_Handler
+ * ----------
+ * @brief I2C master interrupts, one per module.
+ */
+void I2C0_Handler(void) { I2C_service(I2C_BUS0); }
+void I2C1_Handler(void) { I2C_service(I2C_BUS1); }
+void I2C2_Handler(void) { I2C_service(I2C_BUS2); }
+void I2C3_Handler(void) { I2C_service(I2C_BUS3); }
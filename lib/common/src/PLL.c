@@ -46,6 +46,8 @@
 #define SYSCTL_RCC2_OSCSRC2_M   0x00000070  // Oscillator Source 2
 #define SYSCTL_RCC2_OSCSRC2_MO  0x00000000  // MOSC
 
+static uint32_t BusClock = 16000000;  // PIOSC runs the part out of reset
+
 // configure the system to get its clock from the PLL
 // SYSDIV = 400/freq -1
 // bus frequency is 400MHz/(SYSDIV+1)
@@ -70,6 +72,13 @@ void PLL_Init(uint32_t freq){
   while((SYSCTL_RIS_R&SYSCTL_RIS_PLLLRIS)==0){};
   // 6) enable use of PLL by clearing BYPASS
   SYSCTL_RCC2_R &= ~SYSCTL_RCC2_BYPASS2;
+  BusClock = 400000000/(freq+1);
+}
+
+// bus clock in Hz selected by the last PLL_Init
+// 16 MHz (PIOSC) if PLL_Init has not been called
+uint32_t PLL_GetBusClock(void){
+  return BusClock;
 }
 
 
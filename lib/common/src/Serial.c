@@ -18,6 +18,30 @@
 // U0Rx (VCP receive) connected to PA0
 // U0Tx (VCP transmit) connected to PA1
 
+#define TX_MASK (SERIAL_TX_SIZE - 1)
+
+/*
+ *  txHead moves in Serial_putChar, txTail wherever bytes go to the FIFO. The
+ *  main loop only touches txTail with the TX interrupt masked.
+ */
+static char              txBuffer[SERIAL_TX_SIZE];
+static volatile uint32_t txHead = 0;
+static volatile uint32_t txTail = 0;
+static volatile uint32_t txDropped = 0;
+static uint8_t           txPolicy = SERIAL_TX_BLOCK;
+
+/**
+ * copySoftwareToHardware
+ * ----------
+ * Description: move queued bytes to the TX FIFO until it is full.
+ */
+static void copySoftwareToHardware(void) {
+    while ((UART0_FR_R & UART_FR_TXFF) == 0 && txTail != txHead) {
+        UART0_DR_R = txBuffer[txTail & TX_MASK];
+        txTail++;
+    }
+}
+
 /****************************************************
  *                                                  *
  *                   Initializer                    *
@@ -50,9 +74,63 @@ void Serial_Init(void){
     UART0_IBRD_R = 43;
     UART0_FBRD_R = 26;
     UART0_LCRH_R = (UART_LCRH_WLEN_8 | UART_LCRH_FEN);     // 8 bit word length (no parity bits, one stop bit, FIFOs)
+    UART0_IFLS_R = (UART0_IFLS_R & ~UART_IFLS_TX_M) |
+                   UART_IFLS_TX1_8;                        // TX interrupt once the FIFO is down to 2 bytes
+    UART0_IM_R |= UART_IM_TXIM;                            // arm TX interrupt
     UART0_CTL_R |= (UART_CTL_UARTEN |                      // enable UART0
                     UART_CTL_RXE    |                      // enable UART0 RX
                     UART_CTL_TXE);                         // enable UART0 TX
+    
+    /*-- NVIC Set Up --*/
+    txHead = txTail = txDropped = 0;
+    NVIC_PRI1_R = (NVIC_PRI1_R & 0xFFFF00FF) | 0x0000E000; // UART0 (IRQ 5) priority 7
+    NVIC_EN0_R = 1 << 5;                                   // enable IRQ 5 in NVIC
+}
+
+/**
+ * Serial_setTxPolicy
+ * ----------
+ * @param  policy  SERIAL_TX_BLOCK, SERIAL_TX_DROP or SERIAL_TX_OVERWRITE.
+ * ----------
+ * @brief What a write does when the TX ring is full.
+ */
+void Serial_setTxPolicy(uint8_t policy) {
+    txPolicy = policy;
+}
+
+/**
+ * Serial_getTxDropped
+ * ----------
+ * @return bytes lost to a full TX ring since Serial_Init.
+ */
+uint32_t Serial_getTxDropped(void) {
+    return txDropped;
+}
+
+/**
+ * Serial_flush
+ * ----------
+ * @brief Wait until every queued byte has left the UART.
+ */
+void Serial_flush(void) {
+    while (txTail != txHead) {
+        UART0_IM_R &= ~UART_IM_TXIM;                       // drain by hand, interrupts may be off
+        copySoftwareToHardware();
+        UART0_IM_R |= UART_IM_TXIM;
+    }
+    while ((UART0_FR_R & UART_FR_BUSY) != 0);
+}
+
+/**
+ * UART0_Handler
+ * ----------
+ * @brief TX FIFO ran low, refill it from the ring.
+ */
+void UART0_Handler(void) {
+    if (UART0_RIS_R & UART_RIS_TXRIS) {
+        UART0_ICR_R = UART_ICR_TXIC;                       // acknowledge
+        copySoftwareToHardware();
+    }
 }
 
 
@@ -205,11 +283,33 @@ void Serial_getString(char *bufPt, uint16_t max) {
  * ----------
  * @param  data  an 8-bit ASCII character to be transferred.
  * ----------
- * @brief Output 8-bit to serial port.
+ * @brief Queue 8-bit for the serial port, the full ring policy applies.
  */
 void Serial_putChar(char data){
-    while((UART0_FR_R & UART_FR_TXFF) != 0);
-    UART0_DR_R = data;
+    if (txHead - txTail >= SERIAL_TX_SIZE) {
+        if (txPolicy == SERIAL_TX_DROP) {
+            txDropped++;
+            return;
+        }
+        UART0_IM_R &= ~UART_IM_TXIM;                       // keep the handler off txTail
+        if (txPolicy == SERIAL_TX_OVERWRITE) {
+            txTail++;                                      // forget the oldest byte
+            txDropped++;
+        } else {
+            while (txHead - txTail >= SERIAL_TX_SIZE) {
+                copySoftwareToHardware();                  // spin on the FIFO, works with interrupts off
+            }
+        }
+        UART0_IM_R |= UART_IM_TXIM;
+    }
+    
+    txBuffer[txHead & TX_MASK] = data;
+    txHead++;
+    
+    // the TX interrupt only fires when the FIFO drains past its level, start it by hand
+    UART0_IM_R &= ~UART_IM_TXIM;
+    copySoftwareToHardware();
+    UART0_IM_R |= UART_IM_TXIM;
 }
 
 /**
@@ -0,0 +1,91 @@
+/*!
+ * @file  Timebase.c
+ * @brief Monotonic microsecond clock and sleeps on the TM4C123 wide timer 5.
+ * ----------
+ * The prescaler divides the bus clock down to 1 MHz, a bus clock that is not
+ * a whole number of MHz (66.67 MHz) runs the clock slightly fast.
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+#include "PLL.h"
+#include "Timebase.h"
+
+long StartCritical(void);           // in startup.c
+void EndCritical(long sr);
+void WaitForInterrupt(void);
+
+static uint8_t started = 0;
+
+void Timebase_Init(void) {
+    uint32_t prescale = PLL_GetBusClock() / 1000000 - 1;                // 1 MHz ticks
+
+    SYSCTL_RCGCWTIMER_R |= SYSCTL_RCGCWTIMER_R5;                        // enable wide timer 5 clock
+    while ((SYSCTL_PRWTIMER_R & SYSCTL_PRWTIMER_R5) == 0) {};        // allow time for activating
+
+    WTIMER5_CTL_R &= ~(TIMER_CTL_TAEN | TIMER_CTL_TBEN);                // disable during setup
+    WTIMER5_CFG_R = TIMER_CFG_16_BIT;                                   // two 32 bit timers
+
+    /* A: free running clock, counts down from 0xFFFFFFFF */
+    WTIMER5_TAMR_R = TIMER_TAMR_TAMR_PERIOD;
+    WTIMER5_TAILR_R = 0xFFFFFFFF;
+    WTIMER5_TAPR_R = prescale;
+
+    /* B: one-shot wake up, armed by Timebase_sleepUntil */
+    WTIMER5_TBMR_R = TIMER_TBMR_TBMR_1_SHOT;
+    WTIMER5_TBPR_R = prescale;
+    WTIMER5_ICR_R = TIMER_ICR_TBTOCINT;
+    WTIMER5_IMR_R |= TIMER_IMR_TBTOIM;
+    NVIC_PRI26_R = (NVIC_PRI26_R & 0xFFFF00FF) | 0x0000E000;           // wide timer 5B (IRQ 105, vector 121) priority 7
+    NVIC_EN3_R = 1 << (105 - 96);                                       // enable IRQ 105 in NVIC
+
+    WTIMER5_CTL_R |= TIMER_CTL_TAEN;
+    started = 1;
+}
+
+uint32_t Timebase_now(void) {
+    if (!started) Timebase_Init();
+    return ~WTIMER5_TAR_R;                                              // ticks since start
+}
+
+uint32_t Timebase_deadline(uint32_t us) {
+    return Timebase_now() + us;
+}
+
+int Timebase_expired(uint32_t deadline) {
+    return (int32_t)(Timebase_now() - deadline) >= 0;
+}
+
+int Timebase_sleepUntil(uint32_t deadline, volatile uint8_t* wake) {
+    uint32_t remaining;
+    long     sr;
+
+    while (!(wake && *wake)) {
+        remaining = deadline - Timebase_now();
+        if ((int32_t)remaining <= 0) return 0;
+
+        WTIMER5_CTL_R &= ~TIMER_CTL_TBEN;
+        WTIMER5_TBILR_R = remaining;
+        WTIMER5_CTL_R |= TIMER_CTL_TBEN;                                // wakes WFI at the deadline
+
+        /* no interrupt may slip in between the checks and WFI, a pending one still ends WFI */
+        sr = StartCritical();
+        if (!(wake && *wake) && !Timebase_expired(deadline)) WaitForInterrupt();
+        EndCritical(sr);
+    }
+
+    return 1;
+}
+
+void Timebase_sleepUs(uint32_t us) {
+    Timebase_sleepUntil(Timebase_deadline(us), 0);
+}
+
+void WideTimer5B_Handler(void) {
+    WTIMER5_ICR_R = TIMER_ICR_TBTOCINT;                                 // acknowledge, the sleeper checks the time
+}
@@ -0,0 +1,61 @@
+/*!
+ * @file  Timebase_host.c
+ * @brief Timebase.h for host builds, over clock_gettime(CLOCK_MONOTONIC).
+ * ----------
+ * For future development and updates, please follow this repository: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <time.h>
+#include "Timebase.h"
+
+static uint8_t         started = 0;
+static struct timespec origin;
+
+void Timebase_Init(void) {
+    clock_gettime(CLOCK_MONOTONIC, &origin);
+    started = 1;
+}
+
+uint32_t Timebase_now(void) {
+    struct timespec now;
+
+    if (!started) Timebase_Init();
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)((now.tv_sec - origin.tv_sec) * 1000000ll + (now.tv_nsec - origin.tv_nsec) / 1000);
+}
+
+uint32_t Timebase_deadline(uint32_t us) {
+    return Timebase_now() + us;
+}
+
+int Timebase_expired(uint32_t deadline) {
+    return (int32_t)(Timebase_now() - deadline) >= 0;
+}
+
+int Timebase_sleepUntil(uint32_t deadline, volatile uint8_t* wake) {
+    struct timespec pause = { 0, 50000 };                               // no interrupts here, check the flag every 50 us
+    int32_t         remaining;
+
+    while (!(wake && *wake)) {
+        remaining = deadline - Timebase_now();
+        if (remaining <= 0) return 0;
+        if (!wake) {                                                    // nothing to check, sleep it all
+            pause.tv_sec = remaining / 1000000;
+            pause.tv_nsec = remaining % 1000000 * 1000l;
+        }
+        nanosleep(&pause, 0);
+    }
+
+    return 1;
+}
+
+void Timebase_sleepUs(uint32_t us) {
+    Timebase_sleepUntil(Timebase_deadline(us), 0);
+}
@@ -0,0 +1,294 @@
+/*!
+ * @file  main.c
+ * @brief Check the interrupt driven I2C engine on a Linux host.
+ * ----------
+ * Runs I2C.c against the fake master registers and slave of I2C_sim.h:
+ * the START / RUN / STOP / ACK commands of writes and reads, a NACK on the
+ * address and on a data byte, arbitration lost, a failed group dropping its
+ * queued writes, a full queue and a queue that wraps around several times, then the SCL timer period I2C_setSpeed
+ * picks at every bus clock of PLL.h. Exits non-zero on the first failed check.
+ * ----------
+ * For future development and updates, please follow this repo: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "I2C.h"
+#include "I2C_sim.h"
+#include "PLL.h"
+#include "tm4c123gh6pm.h"
+
+#define BUS         I2C_BUS0
+#define ADDRESS     I2C_SIM_ADDRESS
+#define WRITE_MSA   (ADDRESS << 1)
+#define READ_MSA    (ADDRESS << 1 | I2C_MSA_RS)
+#define ROUNDS      10                          // queue wrap-around rounds
+#define PER_ROUND   7                           // transactions per round
+
+static I2C_Transaction transactions[I2C_QUEUE_SIZE + 1];
+static uint8_t         buffers[I2C_QUEUE_SIZE + 1][2];
+static int             order[ROUNDS * PER_ROUND];
+static int             done = 0;
+
+static void record(I2C_Transaction* transaction) {
+    order[done++] = (int)(intptr_t)transaction->context;
+}
+
+static void setup(I2C_Transaction* transaction, uint8_t direction, uint8_t reg, uint8_t* data, uint32_t count, int tag) {
+    transaction->deviceAddress = ADDRESS;
+    transaction->targetRegister = reg;
+    transaction->direction = direction;
+    transaction->data = data;
+    transaction->count = count;
+    transaction->callback = record;
+    transaction->context = (void *)(intptr_t)tag;
+    transaction->status = 0;
+    transaction->group = 0;
+}
+
+/*
+ *  1 if the log holds exactly these commands, MSA values and bytes.
+ */
+static int logIs(const uint32_t* commands, const uint32_t* msa, const uint8_t* data, uint32_t count) {
+    uint32_t             logged;
+    const I2C_Sim_Event* log = I2C_Sim_getLog(BUS, &logged);
+
+    if (logged != count) return 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (log[i].command != commands[i] || log[i].address != msa[i]) return 0;
+        if (data && log[i].data != data[i]) return 0;
+    }
+    return 1;
+}
+
+#define CHECK(name, cond) do {                  \
+    if (!(cond)) {                              \
+        printf("FAIL %s\n", name);              \
+        return 1;                               \
+    }                                           \
+    printf("ok   %s\n", name);                  \
+} while (0)
+
+int main(void) {
+    I2C_Transaction* t = &transactions[0];
+    uint8_t*         slave;
+    uint8_t          out[2] = { 0xAB, 0xCD };
+    uint8_t          in[3];
+    int              match;
+
+    I2C_Sim_Init();
+    slave = I2C_Sim_getRegisters(BUS);
+
+    /*-- two byte write: START with the register, a byte, the last byte with STOP --*/
+    {
+        const uint32_t commands[] = { I2C_MCS_START | I2C_MCS_RUN, I2C_MCS_RUN, I2C_MCS_STOP | I2C_MCS_RUN };
+        const uint32_t msa[]      = { WRITE_MSA, WRITE_MSA, WRITE_MSA };
+        const uint8_t  data[]     = { 0x10, 0xAB, 0xCD };
+
+        done = 0;
+        setup(t, I2C_TRANSACTION_WRITE, 0x10, out, 2, 0);
+        CHECK("write queued", I2C_submit(BUS, t) == 0 && t->status == I2C_PENDING);
+        I2C_Sim_run(BUS);
+        CHECK("write commands", logIs(commands, msa, data, 3));
+        CHECK("write bytes", slave[0x10] == 0xAB && slave[0x11] == 0xCD);
+        CHECK("write done", t->status == 0 && done == 1 && I2C_isIdle(BUS));
+        CHECK("interrupt masked when idle", BUS->registers->MIMR == 0);
+    }
+
+    /*-- three byte read: register, repeated START with ACK, ACK, the last byte NACKed with STOP --*/
+    {
+        const uint32_t commands[] = { I2C_MCS_START | I2C_MCS_RUN, I2C_MCS_ACK | I2C_MCS_START | I2C_MCS_RUN,
+                                      I2C_MCS_ACK | I2C_MCS_RUN, I2C_MCS_STOP | I2C_MCS_RUN };
+        const uint32_t msa[]      = { WRITE_MSA, READ_MSA, READ_MSA, READ_MSA };
+
+        slave[0x20] = 1; slave[0x21] = 2; slave[0x22] = 3;
+        I2C_Sim_resetLog(BUS);
+        setup(t, I2C_TRANSACTION_READ, 0x20, in, 3, 0);
+        I2C_submit(BUS, t);
+        I2C_Sim_run(BUS);
+        CHECK("read commands", logIs(commands, msa, 0, 4));
+        CHECK("read bytes", t->status == 0 && in[0] == 1 && in[1] == 2 && in[2] == 3);
+    }
+
+    /*-- single byte read: the repeated START carries the STOP --*/
+    {
+        const uint32_t commands[] = { I2C_MCS_START | I2C_MCS_RUN, I2C_MCS_STOP | I2C_MCS_START | I2C_MCS_RUN };
+        const uint32_t msa[]      = { WRITE_MSA, READ_MSA };
+
+        I2C_Sim_resetLog(BUS);
+        setup(t, I2C_TRANSACTION_READ, 0x22, in, 1, 0);
+        I2C_submit(BUS, t);
+        I2C_Sim_run(BUS);
+        CHECK("single read commands", logIs(commands, msa, 0, 2) && in[0] == 3 && t->status == 0);
+    }
+
+    /*-- register pointer only: one command with START and STOP --*/
+    {
+        const uint32_t commands[] = { I2C_MCS_STOP | I2C_MCS_START | I2C_MCS_RUN };
+        const uint32_t msa[]      = { WRITE_MSA };
+
+        I2C_Sim_resetLog(BUS);
+        setup(t, I2C_TRANSACTION_WRITE, 0x30, 0, 0, 0);
+        I2C_submit(BUS, t);
+        I2C_Sim_run(BUS);
+        CHECK("pointer only commands", logIs(commands, msa, 0, 1) && t->status == 0);
+    }
+
+    /*-- nobody at the address: ADRACK, then a STOP to let go of the bus --*/
+    {
+        const uint32_t commands[] = { I2C_MCS_START | I2C_MCS_RUN, I2C_MCS_STOP };
+        const uint32_t msa[]      = { WRITE_MSA, WRITE_MSA };
+
+        I2C_Sim_setAddress(BUS, ADDRESS + 1);
+        I2C_Sim_resetLog(BUS);
+        setup(t, I2C_TRANSACTION_WRITE, 0x10, out, 2, 0);
+        I2C_submit(BUS, t);
+        I2C_Sim_run(BUS);
+        CHECK("address NACK commands", logIs(commands, msa, 0, 2));
+        CHECK("address NACK status", t->status == (I2C_MCS_ADRACK | I2C_MCS_ERROR) && I2C_isIdle(BUS));
+        I2C_Sim_setAddress(BUS, ADDRESS);
+    }
+
+    /*-- data byte NACKed: the rest is not sent, STOP after the error --*/
+    {
+        const uint32_t commands[] = { I2C_MCS_START | I2C_MCS_RUN, I2C_MCS_RUN, I2C_MCS_STOP };
+        const uint32_t msa[]      = { WRITE_MSA, WRITE_MSA, WRITE_MSA };
+
+        slave[0x40] = slave[0x41] = 0;
+        I2C_Sim_resetLog(BUS);
+        setup(t, I2C_TRANSACTION_WRITE, 0x40, out, 2, 0);
+        I2C_submit(BUS, t);
+        I2C_Sim_step(BUS);                      // register byte goes through
+        I2C_Sim_fail(BUS, I2C_MCS_DATACK | I2C_MCS_ERROR);
+        I2C_Sim_run(BUS);
+        CHECK("data NACK commands", logIs(commands, msa, 0, 3));
+        CHECK("data NACK status", t->status == (I2C_MCS_DATACK | I2C_MCS_ERROR) && slave[0x41] == 0);
+    }
+
+    /*-- arbitration lost: no STOP, the bus belongs to the other master, the next transaction still runs --*/
+    {
+        const uint32_t commands[] = { I2C_MCS_START | I2C_MCS_RUN,
+                                      I2C_MCS_START | I2C_MCS_RUN, I2C_MCS_RUN, I2C_MCS_STOP | I2C_MCS_RUN };
+        const uint32_t msa[]      = { WRITE_MSA, WRITE_MSA, WRITE_MSA, WRITE_MSA };
+        I2C_Transaction* next = &transactions[1];
+
+        slave[0x50] = slave[0x51] = 0;
+        I2C_Sim_resetLog(BUS);
+        setup(t, I2C_TRANSACTION_WRITE, 0x10, out, 2, 0);
+        setup(next, I2C_TRANSACTION_WRITE, 0x50, out, 2, 1);
+        I2C_submit(BUS, t);
+        I2C_submit(BUS, next);
+        I2C_Sim_fail(BUS, I2C_MCS_ARBLST | I2C_MCS_ERROR);
+        I2C_Sim_run(BUS);
+        CHECK("arbitration lost commands", logIs(commands, msa, 0, 4));
+        CHECK("arbitration lost status", t->status == I2C_MCS_ERROR);
+        CHECK("next after arbitration lost", next->status == 0 && slave[0x50] == 0xAB && slave[0x51] == 0xCD);
+    }
+
+    /*-- group: a data NACK on its second write drops the rest, an unrelated write in between still runs --*/
+    {
+        volatile int failed = 0;
+        const int    expected[] = { 0, 3, 4, 5, 1, 2 };      // dropped ones complete as the failure is seen
+
+        done = 0;
+        match = 1;
+        for (int i = 0; i < 6; i++) {
+            setup(&transactions[i], I2C_TRANSACTION_WRITE, 0x60 + i, out, 1, i);
+            if (i != 2) transactions[i].group = &failed;
+            I2C_submit(BUS, &transactions[i]);
+        }
+        I2C_Sim_step(BUS);                      // first write, register and data
+        I2C_Sim_step(BUS);
+        CHECK("group runs", transactions[0].status == 0 && failed == 0);
+        I2C_Sim_step(BUS);                      // register byte of the second write
+        I2C_Sim_fail(BUS, I2C_MCS_DATACK | I2C_MCS_ERROR);
+        I2C_Sim_run(BUS);
+        CHECK("group error kept", failed == (I2C_MCS_DATACK | I2C_MCS_ERROR));
+        CHECK("group failed write", transactions[1].status == (I2C_MCS_DATACK | I2C_MCS_ERROR));
+        CHECK("group unrelated write", transactions[2].status == 0);
+        for (int i = 3; i < 6; i++) match = match && transactions[i].status == I2C_DROPPED;
+        CHECK("group rest dropped", match);
+        for (int i = 0; i < 6; i++) match = match && order[i] == expected[i];
+        CHECK("group callbacks", match && done == 6);
+        setup(&transactions[6], I2C_TRANSACTION_WRITE, 0x70, out, 1, 6);
+        transactions[6].group = &failed;
+        CHECK("group closed", I2C_submit(BUS, &transactions[6]) == 0 && transactions[6].status == I2C_DROPPED &&
+              I2C_isIdle(BUS) && done == 7);
+    }
+
+    /*-- full queue: one on the bus and 15 queued, the 17th is refused and left alone --*/
+    done = 0;
+    match = 1;
+    for (int i = 0; i <= I2C_QUEUE_SIZE; i++) {
+        setup(&transactions[i], I2C_TRANSACTION_WRITE, i, buffers[i], 2, i);
+        if (I2C_submit(BUS, &transactions[i]) != (i < I2C_QUEUE_SIZE ? 0 : -1)) match = 0;
+    }
+    CHECK("queue full refused", match);
+    CHECK("refused not pending", transactions[I2C_QUEUE_SIZE].status == 0);
+    I2C_Sim_run(BUS);
+    match = done == I2C_QUEUE_SIZE;
+    for (int i = 0; match && i < I2C_QUEUE_SIZE; i++) match = order[i] == i && transactions[i].status == 0;
+    CHECK("full queue drains in order", match);
+    CHECK("refused one can come back", I2C_submit(BUS, &transactions[I2C_QUEUE_SIZE]) == 0 &&
+          I2C_Sim_run(BUS) == 3 && transactions[I2C_QUEUE_SIZE].status == 0);
+
+    /*-- queue wraps: rounds of submits with a little less than a round run in between --*/
+    done = 0;
+    match = 1;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < PER_ROUND; i++) {
+            int tag = round * PER_ROUND + i;
+
+            setup(&transactions[tag % I2C_QUEUE_SIZE], I2C_TRANSACTION_WRITE, tag,
+                  buffers[tag % I2C_QUEUE_SIZE], 2, tag);
+            if (I2C_submit(BUS, &transactions[tag % I2C_QUEUE_SIZE]) != 0) match = 0;
+        }
+        for (int i = 0; i < 3 * PER_ROUND - 2; i++) I2C_Sim_step(BUS);  // 3 commands a write, never drains
+        if (I2C_isIdle(BUS)) match = 0;
+    }
+    CHECK("wrap accepts", match);
+    I2C_Sim_run(BUS);
+    match = done == ROUNDS * PER_ROUND;
+    for (int i = 0; match && i < ROUNDS * PER_ROUND; i++) match = order[i] == i;
+    CHECK("wrap drains in order", match);
+    CHECK("wrap empty", I2C_isIdle(BUS) && BUS->queueHead == BUS->queueTail);
+
+    CHECK("protocol", I2C_Sim_getErrors(BUS) == 0);
+
+    /*-- MTPR at every bus clock: ceil(bus / (20 * SCL)) - 1, SCL never above the target --*/
+    {
+        const uint32_t speeds[] = { I2C_SPEED_STANDARD, I2C_SPEED_FAST };
+
+        match = 1;
+        for (uint32_t freq = Bus80MHz; freq <= Bus3_125MHz; freq++) {
+            PLL_Init(freq);
+            for (int s = 0; s < 2; s++) {
+                uint32_t bus = PLL_GetBusClock();
+                uint32_t scl = speeds[s] * 1000;
+                uint32_t expected = (bus + 20 * scl - 1) / (20 * scl) - 1;
+                uint32_t tpr;
+
+                if (expected < 1) expected = 1;                 // TPR = 0 is reserved
+                I2C_setSpeed(BUS, speeds[s]);
+                tpr = BUS->registers->MTPR;
+                if (tpr != expected || bus > 20 * scl * (1 + tpr)) {     // SCL = bus / (20 * (1 + TPR))
+                    printf("  %u Hz at %u kHz: MTPR %u, expected %u\n", bus, speeds[s], tpr, expected);
+                    match = 0;
+                }
+            }
+        }
+        CHECK("MTPR table", match);
+        CHECK("MTPR 80 MHz 400 kHz", I2C_computeTPR(80000000, I2C_SPEED_FAST) == 9);
+        CHECK("MTPR 50 MHz 400 kHz", I2C_computeTPR(50000000, I2C_SPEED_FAST) == 6);
+        CHECK("MTPR 80 MHz 100 kHz", I2C_computeTPR(80000000, I2C_SPEED_STANDARD) == 39);
+    }
+
+    return 0;
+}
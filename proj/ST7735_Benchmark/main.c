@@ -0,0 +1,430 @@
+/*!
+ * @file  main.c
+ * @brief Measure ST7735 pixel throughput of the driver on a Linux host.
+ * ----------
+ * The driver runs against the fake registers of ST7735_sim.h, which count
+ * every SSI0 frame with the frame size and SSI0 clock of the time. Pixels per
+ * second come from the time those bits keep the link busy at an 80 MHz bus,
+ * address window included, so the numbers are the ceiling the CPU loop or
+ * uDMA has to keep up with. FillScreen and a line of DrawChar run with the
+ * original 8-bit frames at 8 MHz, with 16-bit frames at 8 MHz, and with
+ * 16-bit frames at the fastest clock the ST7735 takes; the uDMA fill runs at
+ * that clock too. The text rows count SPI bytes per character against the
+ * 13 bytes per font pixel (a DrawPixel each) DrawCharS used to take, and
+ * fail unless opaque text is at least 5 times cheaper. The dashboard rows
+ * print the 4 sensor screen of the SingleRanging demos through the text
+ * cells of ST7735_Text.h and fail unless an unchanged frame sends nothing
+ * and a one digit change sends one cell. The chart rows add samples of 4
+ * traces to the scrolling strip chart of ST7735_Chart.h against 4
+ * PlotPoint and a PlotNextErase per sample, and fail unless a sample is one
+ * line window and a scroll start. The report goes to stdout as CSV
+ * (default) or JSON.
+ * ----------
+ *   ./ST7735_Benchmark [csv|json]
+ * ----------
+ * For future development and updates, please follow this repo: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "PLL.h"
+#include "ST7735.h"
+#include "ST7735_DMA.h"
+#include "ST7735_Text.h"
+#include "ST7735_Chart.h"
+#include "ST7735_sim.h"
+
+#define BASELINE_HZ 8000000                     // SSIClk of the original driver at 80 MHz
+#define FILL_COLOR  ST7735_MAGENTA
+#define TEXT        "0123456789 mm ABCDEFG"     // a full 21 character line
+#define MAX_ROWS    16
+#define PIXEL_BYTES 13                          // DrawPixel: address window and one pixel
+#define CELL_PIXELS (6 * 8)                     // font cell at size 1
+#define CELL_BYTES  (11 + 2 * CELL_PIXELS)      // one cell in its own window
+#define SENSORS     4
+#define CHART_FIRST 40                          // chart below 4 text rows
+#define CHART_LINES 120
+#define CHART_MAX   2000                        // mm
+#define LINE_BYTES  (11 + 2 * ST7735_TFTWIDTH)  // a row in one window
+#define SCROLL_BYTES 3                          // VSCSAD and the start line
+
+typedef struct {
+    char             name[64];
+    uint8_t          ok;
+    uint32_t         spiHz;
+    uint32_t         pixels;
+    ST7735_Sim_Stats stats;
+} Row;
+
+typedef struct {
+    const char* name;
+    uint8_t     stream;                         // 16-bit pixel frames
+    uint32_t    maxHz;
+} Mode;
+
+static const Mode modes[] = {
+    { "8-bit frames, 8 MHz",           0, BASELINE_HZ       },
+    { "16-bit frames, 8 MHz",          1, BASELINE_HZ       },
+    { "16-bit frames, fastest clock",  1, ST7735_SPI_MAX_HZ },
+};
+
+static Row      rows[MAX_ROWS];
+static int      rowCount = 0;
+static uint32_t spiHz;
+
+/**
+ * benchStart
+ * ----------
+ * Description: clear the SSI0 counters and the output capture before a call.
+ */
+static void benchStart(void) {
+    ST7735_Sim_resetStats();
+    ST7735_Sim_resetOutput();
+}
+
+/**
+ * benchEnd
+ * ----------
+ * Description: record the SSI0 counters after a call.
+ */
+static void benchEnd(const char* name, uint32_t pixels, int ok) {
+    Row* row = &rows[rowCount++];
+
+    snprintf(row->name, sizeof(row->name), "%s", name);
+    row->ok = ok;
+    row->spiHz = spiHz;
+    row->pixels = pixels;
+    ST7735_Sim_getStats(&row->stats);
+}
+
+/**
+ * filled
+ * ----------
+ * Description: 1 if the last pixels data frames on the link are all color.
+ */
+static int filled(uint16_t color, uint32_t pixels, uint8_t stream) {
+    uint32_t        count;
+    const uint16_t* out = ST7735_Sim_getOutput(&count);
+    uint32_t        frames = stream ? pixels : 2 * pixels;
+
+    if (count < frames) return 0;
+    out += count - frames;
+    for (uint32_t i = 0; i < pixels; i++) {
+        uint16_t pixel = stream ? out[i] : (out[2 * i] << 8) | (out[2 * i + 1] & 0xFF);
+
+        if (pixel != color) return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * litPixels
+ * ----------
+ * Description: set font pixels of a string, what transparent text draws.
+ */
+static uint32_t litPixels(const char* text) {
+    uint32_t lit = 0;
+
+    // the 5x7 font has no public table, count the text color in a DrawChar of each character
+    for (int i = 0; text[i]; i++) {
+        uint32_t        count;
+        const uint16_t* out;
+
+        ST7735_Sim_resetOutput();
+        ST7735_DrawChar(0, 0, text[i], ST7735_YELLOW, ST7735_BLACK, 1);
+        out = ST7735_Sim_getOutput(&count);
+        for (uint32_t j = 0; j < count; j++) lit += out[j] == ST7735_YELLOW;
+    }
+
+    return lit;
+}
+
+/**
+ * runText
+ * ----------
+ * Description: count SPI bytes per character of the text engine.
+ */
+static void runText(void) {
+    static uint16_t expected[ST7735_SIM_OUTPUT];
+    uint32_t        chars = strlen(TEXT);
+    uint32_t        lit = litPixels(TEXT);
+    uint32_t        expectedCount, count;
+    const uint16_t* out;
+    int             same;
+
+    /*-- opaque, one glyph window per character, same pixels as DrawChar --*/
+    ST7735_Sim_resetOutput();
+    for (int i = 0; TEXT[i]; i++) ST7735_DrawChar(i * 6, 20, TEXT[i], ST7735_YELLOW, ST7735_BLACK, 1);
+    out = ST7735_Sim_getOutput(&expectedCount);
+    memcpy(expected, out, expectedCount * sizeof(uint16_t));
+
+    benchStart();
+    for (int i = 0; TEXT[i]; i++) ST7735_DrawCharS(i * 6, 20, TEXT[i], ST7735_YELLOW, ST7735_BLACK, 1);
+    out = ST7735_Sim_getOutput(&count);
+    same = count == expectedCount && memcmp(out, expected, count * sizeof(uint16_t)) == 0;
+    benchEnd("DrawCharS x21 opaque", chars * CELL_PIXELS, 0);
+    rows[rowCount - 1].ok = same && rows[rowCount - 1].stats.bits / 8 * 5 <= chars * CELL_PIXELS * PIXEL_BYTES;
+
+    /*-- transparent, text pixels only --*/
+    benchStart();
+    for (int i = 0; TEXT[i]; i++) ST7735_DrawCharS(i * 6, 40, TEXT[i], ST7735_GREEN, ST7735_GREEN, 1);
+    out = ST7735_Sim_getOutput(&count);
+    same = 1;
+    for (uint32_t i = 0; i < count; i++) {
+        if (out[i] != ST7735_GREEN && out[i] > 0xFF) same = 0;       // pixels or address window bytes
+    }
+    benchEnd("DrawCharS x21 transparent", lit, 0);
+    rows[rowCount - 1].ok = same && rows[rowCount - 1].stats.bits / 8 < lit * PIXEL_BYTES;
+
+    /*-- console, the whole line in one window --*/
+    ST7735_SetCursor(0, 6);
+    benchStart();
+    ST7735_OutString(TEXT);
+    benchEnd("OutString, 21 characters", chars * CELL_PIXELS, 0);
+    rows[rowCount - 1].ok = rows[rowCount - 1].stats.bits / 8 * 5 <= chars * CELL_PIXELS * PIXEL_BYTES;
+}
+
+/**
+ * printDashboard
+ * ----------
+ * Description: the loop body of VL53L0X_SingleRanging_4_ST7735, through the
+ *              text cells (cells != 0) or the ST7735_Out* console.
+ */
+static void printDashboard(const uint32_t* distance, int cells) {
+    for (int i = 0; i < SENSORS; i++) {
+        char line[24];
+
+        snprintf(line, sizeof(line), "Sensor %d, measuring\n", i + 1);
+        if (cells) ST7735_Text_putString(line);
+        else       ST7735_OutString(line);
+        if (cells) {
+            ST7735_Text_putString("Distance: ");
+            ST7735_Text_putUDec(distance[i]);
+            ST7735_Text_putString(" mm \n");
+        } else {
+            ST7735_OutString("Distance: ");
+            ST7735_OutUDec(distance[i]);
+            ST7735_OutString(" mm \n");
+        }
+    }
+    if (cells) ST7735_Text_setCursor(0, 2);
+    else       ST7735_SetCursor(0, 2);
+}
+
+/**
+ * runDashboard
+ * ----------
+ * Description: count SPI bytes per frame of the distance dashboard.
+ */
+static void runDashboard(void) {
+    uint32_t distance[SENSORS] = { 1234, 87, 456, 2000 };
+    uint32_t sent;
+
+    /*-- console, every line redrawn every frame --*/
+    ST7735_FillScreen(ST7735_BLACK);
+    ST7735_SetCursor(0, 2);
+    printDashboard(distance, 0);
+    benchStart();
+    printDashboard(distance, 0);
+    benchEnd("Dashboard x4 sensors, console frame", 8 * ST7735_TEXT_COLUMNS * CELL_PIXELS, 1);
+
+    /*-- text cells --*/
+    ST7735_FillScreen(ST7735_BLACK);
+    ST7735_Text_Init(ST7735_YELLOW, ST7735_BLACK);
+    ST7735_Text_setCursor(0, 2);
+    printDashboard(distance, 1);
+    benchStart();
+    sent = ST7735_Text_flush();
+    benchEnd("Dashboard x4 sensors, first text frame", sent * CELL_PIXELS, sent != 0);
+
+    printDashboard(distance, 1);
+    benchStart();
+    sent = ST7735_Text_flush();
+    benchEnd("Dashboard x4 sensors, unchanged text frame", 0, 0);
+    rows[rowCount - 1].ok = sent == 0 && rows[rowCount - 1].stats.bits == 0;
+
+    distance[0]++;                                  // 1234 -> 1235
+    printDashboard(distance, 1);
+    benchStart();
+    sent = ST7735_Text_flush();
+    benchEnd("Dashboard x4 sensors, one digit changed", sent * CELL_PIXELS, 0);
+    rows[rowCount - 1].ok = sent == 1 && rows[rowCount - 1].stats.bits / 8 <= CELL_BYTES;
+
+    distance[1] = 1000;                             // 87 -> 1000, the line gets longer
+    printDashboard(distance, 1);
+    benchStart();
+    sent = ST7735_Text_flush();
+    benchEnd("Dashboard x4 sensors, 2 to 4 digits", sent * CELL_PIXELS, 0);
+    rows[rowCount - 1].ok = sent == 7;              // "87 mm " -> "1000 mm ", the last blank stays
+
+    distance[1] = 5;                                // and shorter, the tail is blanked
+    printDashboard(distance, 1);
+    benchStart();
+    sent = ST7735_Text_flush();
+    benchEnd("Dashboard x4 sensors, 4 to 1 digits", sent * CELL_PIXELS, 0);
+    rows[rowCount - 1].ok = sent == 6;              // "1000 mm " -> "5 mm    "
+}
+
+/**
+ * chartSample
+ * ----------
+ * Description: 4 traces moving at different speeds, the last one out of range now and then.
+ */
+static void chartSample(int32_t* values, uint32_t t) {
+    values[0] = 500 + (t * 7) % 1000;
+    values[1] = 1500 - (t * 13) % 1200;
+    values[2] = 800;
+    values[3] = t % 10 == 9 ? ST7735_CHART_GAP : 100 + (t * 29) % 1800;
+}
+
+/**
+ * runChart
+ * ----------
+ * Description: count SPI bytes per sample of the strip chart.
+ */
+static void runChart(void) {
+    int32_t         values[SENSORS];
+    uint32_t        count, lit[SENSORS] = { 0 };
+    const uint16_t* out;
+    int             ok;
+
+    /*-- baseline, the Plot routines: a DrawPixel square per trace and an erased column --*/
+    ST7735_PlotClear(0, CHART_MAX);
+    chartSample(values, 0);
+    benchStart();
+    for (int i = 0; i < SENSORS; i++) ST7735_PlotPoint(values[i] == ST7735_CHART_GAP ? 0 : values[i]);
+    ST7735_PlotNextErase();
+    benchEnd("PlotPoint x4 + PlotNextErase, one sample", 4 * 4 + 128, 1);
+
+    /*-- strip chart --*/
+    ST7735_FillScreen(ST7735_BLACK);
+    ok = ST7735_Chart_Init(CHART_FIRST, CHART_LINES, 0, CHART_MAX, ST7735_BLACK);
+    chartSample(values, 0);
+    ST7735_Chart_plot(values, SENSORS);
+    chartSample(values, 1);
+    benchStart();
+    ok &= ST7735_Chart_plot(values, SENSORS) <= 2 * SENSORS + 1;
+    out = ST7735_Sim_getOutput(&count);
+    ok &= count >= ST7735_TFTWIDTH + 2;                     // the row and the scroll start
+    out += count - ST7735_TFTWIDTH - 2;
+    for (int p = 0; p < ST7735_TFTWIDTH; p++) {
+        for (int i = 0; i < SENSORS; i++) lit[i] += out[p] == ST7735_Chart_getColor(i);
+    }
+    for (int i = 0; i < SENSORS; i++) ok &= lit[i] >= ST7735_CHART_THICKNESS;
+    benchEnd("Strip chart x4 traces, one sample", ST7735_TFTWIDTH, 0);
+    rows[rowCount - 1].ok = ok && rows[rowCount - 1].stats.bits / 8 == LINE_BYTES + SCROLL_BYTES;
+
+    benchStart();
+    for (uint32_t t = 2; t < 2 + 2 * CHART_LINES; t++) {    // wraps around the area twice
+        chartSample(values, t);
+        ST7735_Chart_plot(values, SENSORS);
+    }
+    benchEnd("Strip chart x4 traces, 240 samples", 2 * CHART_LINES * ST7735_TFTWIDTH, 0);
+    rows[rowCount - 1].ok = rows[rowCount - 1].stats.bits / 8 == 2 * CHART_LINES * (LINE_BYTES + SCROLL_BYTES);
+}
+
+/**
+ * runMode
+ * ----------
+ * Description: time FillScreen and a line of DrawChar in one mode.
+ */
+static void runMode(const Mode* mode) {
+    uint32_t textPixels = strlen(TEXT) * 6 * 8;
+    uint32_t count;
+    char     name[64];
+
+    ST7735_SetPixelStream(mode->stream);
+    spiHz = ST7735_SetSPIClock(mode->maxHz);
+
+    snprintf(name, sizeof(name), "FillScreen, %s", mode->name);
+    benchStart();
+    ST7735_FillScreen(FILL_COLOR);
+    benchEnd(name, ST7735_TFTWIDTH * ST7735_TFTHEIGHT,
+             filled(FILL_COLOR, ST7735_TFTWIDTH * ST7735_TFTHEIGHT, mode->stream));
+
+    snprintf(name, sizeof(name), "DrawChar x%u, %s", (unsigned)strlen(TEXT), mode->name);
+    benchStart();
+    for (int i = 0; TEXT[i]; i++) ST7735_DrawChar(i * 6, 0, TEXT[i], ST7735_YELLOW, ST7735_BLACK, 1);
+    ST7735_Sim_getOutput(&count);
+    benchEnd(name, textPixels,
+             count == strlen(TEXT) * 8 + textPixels * (mode->stream ? 1 : 2));  // address window bytes + pixels
+}
+
+/**
+ * pixelsPerSecond
+ * ----------
+ * Description: pixels of a row over the time they keep the link busy, 0 for no traffic.
+ */
+static uint64_t pixelsPerSecond(const Row* row) {
+    if (row->stats.cycles == 0) return 0;
+    return row->pixels * (uint64_t)PLL_GetBusClock() / row->stats.cycles;
+}
+
+static void printCsv(void) {
+    printf("case,ok,spi_hz,pixels,cpu_frames,dma_frames,status_reads,bytes,link_us,pixels_per_s\n");
+    for (int i = 0; i < rowCount; i++) {
+        Row*     row = &rows[i];
+        uint64_t linkUs = row->stats.cycles * 1000000 / PLL_GetBusClock();
+
+        printf("\"%s\",%u,%u,%u,%u,%u,%u,%llu,%llu,%llu\n", row->name, row->ok, row->spiHz, row->pixels,
+               row->stats.frames, row->stats.dmaFrames, row->stats.statusReads,
+               (unsigned long long)row->stats.bits / 8, (unsigned long long)linkUs,
+               (unsigned long long)pixelsPerSecond(row));
+    }
+}
+
+static void printJson(void) {
+    printf("[\n");
+    for (int i = 0; i < rowCount; i++) {
+        Row*     row = &rows[i];
+        uint64_t linkUs = row->stats.cycles * 1000000 / PLL_GetBusClock();
+
+        printf("  {\"case\": \"%s\", \"ok\": %s, \"spi_hz\": %u, \"pixels\": %u, \"cpu_frames\": %u, "
+               "\"dma_frames\": %u, \"status_reads\": %u, \"bytes\": %llu, \"link_us\": %llu, "
+               "\"pixels_per_s\": %llu}%s\n",
+               row->name, row->ok ? "true" : "false", row->spiHz, row->pixels,
+               row->stats.frames, row->stats.dmaFrames, row->stats.statusReads,
+               (unsigned long long)row->stats.bits / 8, (unsigned long long)linkUs,
+               (unsigned long long)pixelsPerSecond(row),
+               i + 1 < rowCount ? "," : "");
+    }
+    printf("]\n");
+}
+
+int main(int argc, char** argv) {
+    int failed = 0;
+
+    PLL_Init(Bus80MHz);
+    ST7735_Sim_Init();
+    ST7735_InitR(INITR_REDTAB);
+
+    for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) runMode(&modes[i]);
+
+    /*-- uDMA fill at the fastest clock --*/
+    benchStart();
+    ST7735_FillScreenDMA(FILL_COLOR, 0);
+    ST7735_DMA_wait();
+    benchEnd("FillScreenDMA, 16-bit frames, fastest clock", ST7735_TFTWIDTH * ST7735_TFTHEIGHT,
+             filled(FILL_COLOR, ST7735_TFTWIDTH * ST7735_TFTHEIGHT, 1));
+
+    runText();
+    runDashboard();
+    runChart();
+
+    if (argc > 1 && strcmp(argv[1], "json") == 0) printJson();
+    else                                          printCsv();
+
+    for (int i = 0; i < rowCount; i++) failed |= !rows[i].ok;
+    failed |= ST7735_Sim_getErrors() != 0;
+
+    return failed;
+}
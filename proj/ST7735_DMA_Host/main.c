@@ -0,0 +1,95 @@
+/*!
+ * @file  main.c
+ * @brief Check the ST7735 uDMA pixel stream on a Linux host.
+ * ----------
+ * Runs ST7735_DMA.c against the fake uDMA and SSI0 registers of ST7735_sim.h:
+ * a full screen fill, a bottom-up bitmap with clipped columns and an empty
+ * job, checking the pixels that reach SSI0, the number of transfers, the
+ * completion callback and the frame size left behind. Exits non-zero on the
+ * first failed check.
+ * ----------
+ * For future development and updates, please follow this repo: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "ST7735_DMA.h"
+#include "ST7735_sim.h"
+
+#define SCREEN_PIXELS   (128 * 160)
+#define IMAGE_W         40
+#define IMAGE_H         30
+#define CLIP_W          25                      // columns left after clipping the right side
+
+static uint16_t image[IMAGE_W * IMAGE_H];       // bottom-up, pixel = row << 8 | column
+static int      doneCalls = 0;
+
+static void done(void) {
+    doneCalls++;
+}
+
+#define CHECK(name, cond) do {                  \
+    if (!(cond)) {                              \
+        printf("FAIL %s\n", name);              \
+        return 1;                               \
+    }                                           \
+    printf("ok   %s\n", name);                  \
+} while (0)
+
+int main(void) {
+    const uint16_t* out;
+    uint32_t        count, chunks;
+    int             match;
+
+    ST7735_Sim_Init();
+    ST7735_DMA_Init();
+
+    /*-- full screen fill, 20 transfers of 1024 pixels --*/
+    doneCalls = 0;
+    ST7735_DMA_fill(0xF81F, SCREEN_PIXELS, done);
+    CHECK("fill frames are 16-bit", (SSI0_CR0_R & SSI_CR0_DSS_M) == SSI_CR0_DSS_16);
+    ST7735_DMA_wait();
+    out = ST7735_Sim_getOutput(&count);
+    match = count == SCREEN_PIXELS;
+    for (uint32_t i = 0; match && i < count; i++) match = out[i] == 0xF81F;
+    CHECK("fill pixels", match);
+    CHECK("fill transfers", ST7735_Sim_getChunks() == SCREEN_PIXELS / ST7735_DMA_MAX_ITEMS);
+    CHECK("fill callback", doneCalls == 1);
+    CHECK("frames back to 8-bit", (SSI0_CR0_R & SSI_CR0_DSS_M) == SSI_CR0_DSS_8);
+
+    /*-- bottom-up bitmap, top row first, right columns cut off --*/
+    for (int row = 0; row < IMAGE_H; row++) {
+        for (int col = 0; col < IMAGE_W; col++) image[row * IMAGE_W + col] = (row << 8) | col;
+    }
+    ST7735_Sim_resetOutput();
+    chunks = ST7735_Sim_getChunks();
+    doneCalls = 0;
+    ST7735_DMA_copy(&image[(IMAGE_H - 1) * IMAGE_W], CLIP_W, IMAGE_H, -IMAGE_W, done);
+    ST7735_DMA_wait();
+    out = ST7735_Sim_getOutput(&count);
+    match = count == CLIP_W * IMAGE_H;
+    for (uint32_t i = 0; match && i < count; i++) {
+        match = out[i] == (((IMAGE_H - 1 - i / CLIP_W) << 8) | (i % CLIP_W));
+    }
+    CHECK("bitmap pixels", match);
+    CHECK("bitmap transfers", ST7735_Sim_getChunks() - chunks == IMAGE_H);
+    CHECK("bitmap callback", doneCalls == 1);
+
+    /*-- nothing to send, callback at once and no transfer --*/
+    chunks = ST7735_Sim_getChunks();
+    doneCalls = 0;
+    ST7735_DMA_fill(0, 0, done);
+    CHECK("empty job", !ST7735_DMA_busy() && doneCalls == 1 && ST7735_Sim_getChunks() == chunks);
+
+    CHECK("channel setup", ST7735_Sim_getErrors() == 0);
+    printf("transfers: %u\n", ST7735_DMA_getChunks());
+
+    return 0;
+}
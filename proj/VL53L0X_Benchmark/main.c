@@ -0,0 +1,193 @@
+/*!
+ * @file  main.c
+ * @brief Count the I2C traffic of the VL53L0X driver APIs on a Linux host.
+ * ----------
+ * Every API call runs against the simulated sensor, whose bus counters give
+ * transactions, data bytes, page switches (writes to 0xFF) and the time the
+ * traffic keeps the bus busy at 100 and 400 kHz. The whole suite runs once
+ * with the register shadow off and once with it on. The report goes to
+ * stdout as CSV (default) or JSON, driver debug output goes to stderr.
+ * The run fails if a call does not succeed, or if a repeated fast single
+ * measurement takes more than half the transactions of the regular one.
+ * ----------
+ *   ./VL53L0X_Benchmark [csv|json]
+ * ----------
+ * ST VL53L0X datasheet: https://www.st.com/resource/en/datasheet/vl53l0x.pdf
+ * ----------
+ * For future development and updates, please follow this repo: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "PLL.h"
+#include "VL53L0X.h"
+#include "VL53L0X_calibration.h"
+#include "VL53L0X_sim.h"
+
+#define BUDGET_US   33000                       // timing budget used by the set budget row
+#define MAX_ROWS    64
+
+typedef struct {
+    const char*       name;
+    uint8_t           shadow;
+    uint8_t           ok;
+    VL53L0X_Sim_Stats stats;
+    uint64_t          elapsedUs;                // simulated time, conversions and polling included
+} Row;
+
+static Row rows[MAX_ROWS];
+static int rowCount = 0;
+static uint8_t shadow = 0;
+
+/**
+ * benchStart
+ * ----------
+ * Description: reset the bus counters of sensor 0 before a call.
+ */
+static uint64_t benchStart(void) {
+    VL53L0X_Sim_resetStats(0);
+    return VL53L0X_Sim_getTimeUs();
+}
+
+/**
+ * benchEnd
+ * ----------
+ * Description: record the bus counters of sensor 0 after a call.
+ */
+static void benchEnd(const char* name, uint64_t start, int ok) {
+    Row* row = &rows[rowCount++];
+
+    row->name = name;
+    row->shadow = shadow;
+    row->ok = ok;
+    VL53L0X_Sim_getStats(0, &row->stats);
+    row->elapsedUs = VL53L0X_Sim_getTimeUs() - start;
+}
+
+#define BENCH(name, ok_expr) do {                   \
+    uint64_t start = benchStart();                  \
+    benchEnd(name, start, (ok_expr));               \
+} while (0)
+
+/**
+ * runSuite
+ * ----------
+ * Description: bring sensor 0 up from power on and time every step.
+ */
+static void runSuite(void) {
+    VL53L0X_Dev_t*                   device = &deviceList[0].device;
+    VL53L0X_RangingMeasurementData_t measurement;
+    VL53L0X_DeviceInfo_t             deviceInfo;
+    Row*                             regular;
+    Row*                             fast;
+    uint32_t                         budget;
+    uint32_t                         refSpadCount;
+    uint8_t                          isApertureSpads, vhvSettings, phaseCal, ready;
+
+    memset(deviceList, 0, sizeof(deviceList));
+    VL53L0X_Sim_Init();
+    VL53L0X_Calibration_setStore(0);            // cold boot, calibrate every time
+    VL53L0X_setShadow(shadow, 0);
+
+    /*-- VL53L0X.c, single ranging --*/
+    BENCH("VL53L0X_Init", VL53L0X_Init(0) == SUCCESS);
+    BENCH("VL53L0X_SingleRanging_Init", VL53L0X_SingleRanging_Init(0) == SUCCESS);
+    BENCH("VL53L0X_getSingleRangingMeasurement",
+          VL53L0X_getSingleRangingMeasurement(&measurement, 0) == VL53L0X_ERROR_NONE);
+    regular = &rows[rowCount - 1];
+    BENCH("VL53L0X_getSingleRangingMeasurementFast (first)",
+          VL53L0X_getSingleRangingMeasurementFast(&measurement, 0) == VL53L0X_ERROR_NONE);
+    BENCH("VL53L0X_getSingleRangingMeasurementFast",
+          VL53L0X_getSingleRangingMeasurementFast(&measurement, 0) == VL53L0X_ERROR_NONE);
+    fast = &rows[rowCount - 1];
+    if (fast->stats.transactions * 2 > regular->stats.transactions) fast->ok = 0;   // fast path lost its point
+    VL53L0X_setDecodeLevel(VL53L0X_RANGEDECODELEVEL_LITE, 0);
+    BENCH("VL53L0X_getSingleRangingMeasurementFast (lite decode)",
+          VL53L0X_getSingleRangingMeasurementFast(&measurement, 0) == VL53L0X_ERROR_NONE);
+    VL53L0X_setDecodeLevel(VL53L0X_RANGEDECODELEVEL_RAW, 0);
+    BENCH("VL53L0X_getSingleRangingMeasurementFast (raw decode)",
+          VL53L0X_getSingleRangingMeasurementFast(&measurement, 0) == VL53L0X_ERROR_NONE &&
+          measurement.RangeStatus == 0);
+    VL53L0X_setDecodeLevel(VL53L0X_RANGEDECODELEVEL_FULL, 0);
+    BENCH("VL53L0X_startRanging", VL53L0X_startRanging(0) == VL53L0X_ERROR_NONE);
+    VL53L0X_Sim_advance(VL53L0X_SIM_RANGING_US);
+    BENCH("VL53L0X_isRangingReady", VL53L0X_isRangingReady(0) == 1);
+    BENCH("VL53L0X_fetchRanging", VL53L0X_fetchRanging(0, &measurement) == VL53L0X_ERROR_NONE);
+
+    /*-- vl53l0x_api.c --*/
+    BENCH("VL53L0X_GetDeviceInfo", VL53L0X_GetDeviceInfo(device, &deviceInfo) == VL53L0X_ERROR_NONE);
+    BENCH("VL53L0X_GetMeasurementTimingBudgetMicroSeconds",
+          VL53L0X_GetMeasurementTimingBudgetMicroSeconds(device, &budget) == VL53L0X_ERROR_NONE);
+    BENCH("VL53L0X_SetMeasurementTimingBudgetMicroSeconds",
+          VL53L0X_SetMeasurementTimingBudgetMicroSeconds(device, BUDGET_US) == VL53L0X_ERROR_NONE);
+    BENCH("VL53L0X_PerformRefSpadManagement",
+          VL53L0X_PerformRefSpadManagement(device, &refSpadCount, &isApertureSpads) == VL53L0X_ERROR_NONE);
+    BENCH("VL53L0X_PerformRefCalibration",
+          VL53L0X_PerformRefCalibration(device, &vhvSettings, &phaseCal) == VL53L0X_ERROR_NONE);
+    BENCH("VL53L0X_PerformSingleRangingMeasurement",
+          VL53L0X_PerformSingleRangingMeasurement(device, &measurement) == VL53L0X_ERROR_NONE);
+
+    /*-- continuous ranging --*/
+    BENCH("VL53L0X_ContinuousRanging_Init", VL53L0X_ContinuousRanging_Init(0) == SUCCESS);
+    BENCH("VL53L0X_StartMeasurement", VL53L0X_StartMeasurement(device) == VL53L0X_ERROR_NONE);
+    VL53L0X_Sim_advance(VL53L0X_SIM_RANGING_US);
+    BENCH("continuous readout (isRangingReady + fetchRanging)",
+          VL53L0X_isRangingReady(0) == 1 && VL53L0X_fetchRanging(0, &measurement) == VL53L0X_ERROR_NONE);
+    VL53L0X_Sim_advance(VL53L0X_SIM_RANGING_US);
+    BENCH("VL53L0X_GetMeasurementDataReady",
+          VL53L0X_GetMeasurementDataReady(device, &ready) == VL53L0X_ERROR_NONE && ready);
+    BENCH("VL53L0X_GetRangingMeasurementData",
+          VL53L0X_GetRangingMeasurementData(device, &measurement) == VL53L0X_ERROR_NONE);
+    BENCH("VL53L0X_ClearInterruptMask", VL53L0X_ClearInterruptMask(device, 0) == VL53L0X_ERROR_NONE);
+    BENCH("VL53L0X_StopMeasurement", VL53L0X_StopMeasurement(device) == VL53L0X_ERROR_NONE);
+}
+
+static void printCsv(void) {
+    printf("api,shadow,ok,transactions,reads,writes,bytes,page_switches,bus_us_100khz,bus_us_400khz,elapsed_us\n");
+    for (int i = 0; i < rowCount; i++) {
+        Row* row = &rows[i];
+        printf("\"%s\",%u,%u,%u,%u,%u,%u,%u,%u,%u,%llu\n", row->name, row->shadow, row->ok,
+               row->stats.transactions, row->stats.reads, row->stats.writes, row->stats.bytes,
+               row->stats.pageSwitches, VL53L0X_Sim_busTimeUs(&row->stats, 100),
+               VL53L0X_Sim_busTimeUs(&row->stats, 400), (unsigned long long)row->elapsedUs);
+    }
+}
+
+static void printJson(void) {
+    printf("[\n");
+    for (int i = 0; i < rowCount; i++) {
+        Row* row = &rows[i];
+        printf("  {\"api\": \"%s\", \"shadow\": %u, \"ok\": %s, \"transactions\": %u, \"reads\": %u, "
+               "\"writes\": %u, \"bytes\": %u, \"page_switches\": %u, \"bus_us_100khz\": %u, "
+               "\"bus_us_400khz\": %u, \"elapsed_us\": %llu}%s\n",
+               row->name, row->shadow, row->ok ? "true" : "false",
+               row->stats.transactions, row->stats.reads, row->stats.writes, row->stats.bytes,
+               row->stats.pageSwitches, VL53L0X_Sim_busTimeUs(&row->stats, 100),
+               VL53L0X_Sim_busTimeUs(&row->stats, 400), (unsigned long long)row->elapsedUs,
+               i + 1 < rowCount ? "," : "");
+    }
+    printf("]\n");
+}
+
+int main(int argc, char** argv) {
+    int failed = 0;
+
+    PLL_Init(Bus80MHz);
+
+    for (shadow = 0; shadow <= 1; shadow++) runSuite();
+
+    if (argc > 1 && strcmp(argv[1], "json") == 0) printJson();
+    else                                          printCsv();
+
+    for (int i = 0; i < rowCount; i++) failed |= !rows[i].ok;
+
+    return failed;
+}
@@ -19,31 +19,45 @@
 #include "I2C.h"
 #include "Serial.h"
 #include "VL53L0X.h"
+#include "VL53L0X_scheduler.h"
+
+#define BUDGET_US   33000                     	    // default ST timing budget
+#define PERIOD_MS   35                        	    // back to back with a little slack
 
 int main(void) {
     /*-- TM4C123 Init --*/
     PLL_Init(Bus80MHz);                   	    // bus clock at 80 MHz
     Serial_Init();                        	    // for serial I/O
 
-    if(!VL53L0X_Init(VL53L0X_I2C_ADDR, 0)) { 	// init and wake up VL53L0X
+    if(!VL53L0X_Init(0) || !VL53L0X_ContinuousRanging_Init(0) ||
+       !VL53L0X_Scheduler_Init(1, BUDGET_US, PERIOD_MS)) { 	// init and start VL53L0X
         Serial_println("Fail to initialize VL53L0X :(");
         delay(1);
         return 0;
     } else {
         Serial_println("VL53L0X Ready~ ");
     }
+    Serial_setTxPolicy(SERIAL_TX_DROP);             // the ranging loop never waits on the serial link
     
-    VL53L0X_RangingMeasurementData_t measurement;
+    const VL53L0X_Slot* slot = VL53L0X_Scheduler_getSlot(0);
+    uint32_t lastSequence = 0;
     
     /*-- loop --*/
     while(1) {                            	    // read and process
-        Serial_println("Measuring... ");
-        VL53L0X_getSingleRangingMeasurement(&measurement, 0);
-        if (measurement.RangeStatus != 4) {
-            Serial_println("Distance: %u mm", measurement.RangeMilliMeter);
+        VL53L0X_Scheduler_Run();
+        if (slot->sequence == lastSequence) continue;   // nothing new yet
+        lastSequence = slot->sequence;
+        if (slot->data.RangeStatus != 4) {
+            Serial_println("#%u Distance: %u mm", slot->sequence, slot->data.RangeMilliMeter);
         } else {
-            Serial_println("Out of range :(");
+            Serial_println("#%u Out of range :(", slot->sequence);
+        }
+#ifdef VL53L0X_PROFILE
+        if (slot->sequence % 100 == 0) {            // API cycle table every 100 samples
+            Serial_setTxPolicy(SERIAL_TX_BLOCK);    // the table is longer than the ring, keep all of it
+            VL53L0X_ProfDump();
+            Serial_setTxPolicy(SERIAL_TX_DROP);
         }
-        delay(1000);                      	    // take a break
+#endif
     }
 }
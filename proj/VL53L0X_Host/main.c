@@ -0,0 +1,310 @@
+/*!
+ * @file  main.c
+ * @brief Run the VL53L0X driver stack on a Linux host against the simulated sensor.
+ * ----------
+ * First runs VL53L0X_StaticInit with the merged tuning table and with the
+ * same table one register per entry, as ST ships it: the register images must
+ * match and the merged table must take fewer I2C transactions.
+ * Brings up sensor 0 with the same calls as the TM4C123 projects, twice: the
+ * cold boot calibrates and stores the result in a file, the warm boot after a
+ * power cycle must restore the same calibration in fewer I2C transactions.
+ * Then it takes single
+ * ranging measurements at a few target distances, ranges four sensors on four
+ * buses at once through the split API, then runs continuous ranging through
+ * the scheduler. Results go to stdout, driver debug output to stderr.
+ * ----------
+ * ST VL53L0X datasheet: https://www.st.com/resource/en/datasheet/vl53l0x.pdf
+ * ----------
+ * For future development and updates, please follow this repo: https://github.com/ZeeLivermorium/VL53L0X_TM4C123G
+ * ----------
+ * If you find any bug or problem, please create new issue or a pull request with a fix in the repository.
+ * Or you can simply email me about the problem or bug at zeelivermorium@gmail.com
+ * Much Appreciated!
+ * ----------
+ * @author Zee Livermorium
+ * @date   Apr 16, 2019
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "PLL.h"
+#include "VL53L0X.h"
+#include "VL53L0X_calibration.h"
+#include "VL53L0X_scheduler.h"
+#include "VL53L0X_sim.h"
+
+#define BUDGET_US   33000                       // timing budget for continuous ranging
+#define PERIOD_MS   35                          // inter-measurement period for continuous ranging
+#define SAMPLES     5                           // continuous samples to collect
+#define RING_SIZE   8                           // records in the capture ring, a power of two
+#define SENSORS     4                           // one per bus for concurrent ranging
+#define POLL_US     500                         // wait between ready polls
+#define TUNING_SIZE 1024                        // bytes of the tuning table one register per entry
+#define SLACK_US    10000                       // bus time and polling allowed on top of the slowest sensor
+
+static const uint16_t targets[] = { 50, 200, 500, 1200, 2000 };
+static VL53L0X_Record ringBuffer[RING_SIZE];
+
+/*
+ *  What VL53L0X_StaticInit wrote and what it cost.
+ */
+typedef struct {
+    uint32_t transactions;
+    uint8_t  registers[2][256];         // pages 0 and 1
+} StaticInit;
+
+extern const uint8_t DefaultTuningSettings[];   // vl53l0x_tuning.h, linked in with vl53l0x_api.c
+static uint8_t       originalTuning[TUNING_SIZE];
+
+/*
+ *  What a boot of sensor 0 cost and the calibration it ended up with.
+ */
+typedef struct {
+    uint32_t transactions;
+    uint32_t refSpadCount;
+    uint8_t  isApertureSpads;
+    uint8_t  vhvSettings;
+    uint8_t  phaseCal;
+} Boot;
+
+static const uint16_t concurrentTargets[SENSORS] = { 100, 400, 900, 1600 };
+static const uint32_t concurrentLatencyUs[SENSORS] = { 20000, 45000, 30000, 60000 };
+
+/*
+ *  Split every entry of a tuning table into single register entries, the
+ *  way ST ships the table. Returns 0 if it does not fit.
+ */
+static int expandTuning(const uint8_t* table, uint8_t* out, uint32_t size) {
+    uint32_t length = 0;
+
+    while (*table != 0) {
+        if (*table == 0xFF) {                   // internal parameter, kept as is
+            if (length + 4 > size) return 0;
+            memcpy(&out[length], table, 4);
+            length += 4;
+            table += 4;
+            continue;
+        }
+        for (uint8_t i = 0; i < table[0]; i++) {
+            if (length + 3 > size) return 0;
+            out[length++] = 1;
+            out[length++] = table[1] + i;
+            out[length++] = table[2 + i];
+        }
+        table += 2 + table[0];
+    }
+    if (length + 1 > size) return 0;
+    out[length] = 0;
+
+    return 1;
+}
+
+/*
+ *  Power cycle the sensors and run VL53L0X_StaticInit on sensor 0 with a
+ *  tuning table, 0 for the built-in one.
+ */
+static int staticInit(const uint8_t* tuning, StaticInit* result) {
+    VL53L0X_DEV       device = &deviceList[0].device;
+    VL53L0X_Sim_Stats stats;
+
+    VL53L0X_Sim_Init();
+    if (!VL53L0X_Init(0)) return 0;
+    if (VL53L0X_SetTuningSettingBuffer(device, tuning, tuning == 0) != VL53L0X_ERROR_NONE) return 0;
+    VL53L0X_Sim_resetStats(0);
+    if (VL53L0X_StaticInit(device) != VL53L0X_ERROR_NONE) return 0;
+
+    VL53L0X_Sim_getStats(0, &stats);
+    result->transactions = stats.transactions;
+    memcpy(result->registers[0], VL53L0X_Sim_getRegisters(0, 0), 256);
+    memcpy(result->registers[1], VL53L0X_Sim_getRegisters(0, 1), 256);
+
+    return 1;
+}
+
+/*
+ *  Power cycle the sensors and bring up sensor 0 for single ranging.
+ */
+static int boot(Boot* result) {
+    VL53L0X_Sim_Stats stats;
+
+    VL53L0X_Sim_Init();
+    if (!VL53L0X_Init(0) || !VL53L0X_SingleRanging_Init(0)) return 0;
+    VL53L0X_Sim_getStats(0, &stats);
+    result->transactions = stats.transactions;
+
+    return VL53L0X_GetReferenceSpads(&deviceList[0].device, &result->refSpadCount, &result->isApertureSpads) ==
+               VL53L0X_ERROR_NONE &&
+           VL53L0X_GetRefCalibration(&deviceList[0].device, &result->vhvSettings, &result->phaseCal) ==
+               VL53L0X_ERROR_NONE;
+}
+
+int main(void) {
+    VL53L0X_RangingMeasurementData_t measurement;
+    uint64_t start;
+    StaticInit merged, original;
+    Boot cold, warm;
+    VL53L0X_Record record;
+    uint32_t count, minUs, avgUs, p99Us, rate;
+    uint32_t samples[SENSORS], elapsedUs, maxUs = 0, sumUs = 0;
+    uint8_t  done[SENSORS] = { 0 };
+    int      pending;
+
+    PLL_Init(Bus80MHz);
+
+    /*-- StaticInit, merged tuning table against one register per entry --*/
+    if (!expandTuning(DefaultTuningSettings, originalTuning, TUNING_SIZE) ||
+        !staticInit(0, &merged) || !staticInit(originalTuning, &original)) {
+        printf("StaticInit failed :(\n");
+        return 1;
+    }
+    printf("static init: %u transactions merged, %u one register per entry\n",
+           merged.transactions, original.transactions);
+    if (memcmp(merged.registers, original.registers, sizeof(merged.registers)) != 0 ||
+        merged.transactions >= original.transactions) {
+        printf("static init: registers %s :(\n",
+               memcmp(merged.registers, original.registers, sizeof(merged.registers)) ? "differ" : "match");
+        return 1;
+    }
+
+    VL53L0X_Calibration_setStore(&VL53L0X_CalStoreFile);
+
+    /*-- cold boot calibrates and stores, warm boot restores --*/
+    remove(VL53L0X_CAL_FILE);
+    if (!boot(&cold)) {
+        printf("Fail to initialize VL53L0X :(\n");
+        return 1;
+    }
+    printf("cold init: %u transactions\n", cold.transactions);
+    if (!boot(&warm)) {
+        printf("Fail to initialize VL53L0X from the stored calibration :(\n");
+        return 1;
+    }
+    printf("warm init: %u transactions, %llu us simulated\n", warm.transactions,
+           (unsigned long long)VL53L0X_Sim_getTimeUs());
+    if (warm.transactions >= cold.transactions ||
+        warm.refSpadCount != cold.refSpadCount || warm.isApertureSpads != cold.isApertureSpads ||
+        warm.vhvSettings != cold.vhvSettings || warm.phaseCal != cold.phaseCal) {
+        printf("warm init: spads %u/%u vhv %u phase %u, cold had spads %u/%u vhv %u phase %u :(\n",
+               warm.refSpadCount, warm.isApertureSpads, warm.vhvSettings, warm.phaseCal,
+               cold.refSpadCount, cold.isApertureSpads, cold.vhvSettings, cold.phaseCal);
+        return 1;
+    }
+
+    /*-- single ranging --*/
+    for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); i++) {
+        VL53L0X_Sim_setTarget(0, targets[i]);
+        start = VL53L0X_Sim_getTimeUs();
+        if (VL53L0X_getSingleRangingMeasurement(&measurement, 0) != VL53L0X_ERROR_NONE ||
+            measurement.RangeMilliMeter != targets[i]) {
+            printf("single: expected %u mm, got %u mm :(\n", targets[i], measurement.RangeMilliMeter);
+            return 1;
+        }
+        printf("single: %u mm status %u in %llu us\n", measurement.RangeMilliMeter, measurement.RangeStatus,
+               (unsigned long long)(VL53L0X_Sim_getTimeUs() - start));
+    }
+
+    /*-- single ranging, fast path --*/
+    for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); i++) {
+        VL53L0X_Sim_setTarget(0, targets[i]);
+        start = VL53L0X_Sim_getTimeUs();
+        if (VL53L0X_getSingleRangingMeasurementFast(&measurement, 0) != VL53L0X_ERROR_NONE ||
+            measurement.RangeMilliMeter != targets[i]) {
+            printf("fast: expected %u mm, got %u mm :(\n", targets[i], measurement.RangeMilliMeter);
+            return 1;
+        }
+        printf("fast: %u mm status %u in %llu us\n", measurement.RangeMilliMeter, measurement.RangeStatus,
+               (unsigned long long)(VL53L0X_Sim_getTimeUs() - start));
+    }
+
+    /*-- four sensors on four buses, started together and collected as they finish --*/
+    for (int i = 0; i < SENSORS; i++) {
+        VL53L0X_Sim_setLatency(i, concurrentLatencyUs[i], VL53L0X_SIM_REF_US);
+        VL53L0X_Sim_setTarget(i, concurrentTargets[i]);
+        if (i > 0 && (!VL53L0X_setBus(i, i) || !VL53L0X_Init(i) || !VL53L0X_SingleRanging_Init(i))) {
+            printf("concurrent: sensor %d init failed :(\n", i);
+            return 1;
+        }
+        samples[i] = VL53L0X_Sim_getSampleCount(i);
+        if (concurrentLatencyUs[i] > maxUs) maxUs = concurrentLatencyUs[i];
+        sumUs += concurrentLatencyUs[i];
+    }
+    start = VL53L0X_Sim_getTimeUs();
+    for (int i = 0; i < SENSORS; i++) {
+        if (VL53L0X_startRanging(i) != VL53L0X_ERROR_NONE) {
+            printf("concurrent: sensor %d did not start :(\n", i);
+            return 1;
+        }
+    }
+    for (pending = SENSORS; pending > 0; VL53L0X_Sim_advance(POLL_US)) {
+        for (int i = 0; i < SENSORS; i++) {
+            if (done[i] || !VL53L0X_isRangingReady(i)) continue;
+            if (VL53L0X_fetchRanging(i, &measurement) != VL53L0X_ERROR_NONE ||
+                measurement.RangeMilliMeter != concurrentTargets[i] ||
+                VL53L0X_Sim_getSampleCount(i) != samples[i] + 1) {
+                printf("concurrent: sensor %d expected %u mm, got %u mm :(\n", i, concurrentTargets[i],
+                       measurement.RangeMilliMeter);
+                return 1;
+            }
+            printf("concurrent: sensor %d %u mm at %llu us\n", i, measurement.RangeMilliMeter,
+                   (unsigned long long)(VL53L0X_Sim_getTimeUs() - start));
+            done[i] = 1;
+            pending--;
+        }
+    }
+    elapsedUs = VL53L0X_Sim_getTimeUs() - start;
+    printf("concurrent: %d sensors in %u us, slowest %u us, sum %u us\n", SENSORS, elapsedUs, maxUs, sumUs);
+    if (elapsedUs < maxUs || elapsedUs > maxUs + SLACK_US) {
+        printf("concurrent: expected about %u us :(\n", maxUs);
+        return 1;
+    }
+    VL53L0X_Sim_setLatency(0, VL53L0X_SIM_RANGING_US, VL53L0X_SIM_REF_US);
+
+    /*-- continuous ranging, every sample also goes to the capture ring --*/
+    VL53L0X_Ring_Init(ringBuffer, RING_SIZE);
+    if (!VL53L0X_ContinuousRanging_Init(0) || !VL53L0X_Scheduler_Init(1, BUDGET_US, PERIOD_MS)) {
+        printf("Continuous Mode init failed :(\n");
+        return 1;
+    }
+    VL53L0X_Sim_setTarget(0, 750);
+    start = VL53L0X_Sim_getTimeUs();
+    while (VL53L0X_Scheduler_getSampleCount() < SAMPLES) {
+        VL53L0X_Scheduler_Run();
+        VL53L0X_Sim_advance(1000);
+    }
+    rate = VL53L0X_Scheduler_getRate();
+    VL53L0X_Scheduler_Stop();
+    if (rate < 1000 / PERIOD_MS * 3 / 4 || rate > 1000 / PERIOD_MS * 5 / 4) {
+        printf("continuous: %u samples/s, expected about %u :(\n", rate, 1000 / PERIOD_MS);
+        return 1;
+    }
+    printf("continuous: %u samples/s\n", rate);
+    printf("continuous: %u mm, %u samples in %llu us\n", VL53L0X_Scheduler_getSlot(0)->data.RangeMilliMeter,
+           SAMPLES, (unsigned long long)(VL53L0X_Sim_getTimeUs() - start));
+    printf("continuous: last sample ready at %u us after %u us\n",
+           VL53L0X_Scheduler_getSlot(0)->data.TimeStamp, VL53L0X_Scheduler_getSlot(0)->data.MeasurementTimeUsec);
+
+    count = 0;
+    while (VL53L0X_Ring_pop(&record)) {
+        if (record.rangeMilliMeter != 750 || record.sensor != 0) {
+            printf("ring: expected 750 mm from sensor 0, got %u mm from %u :(\n", record.rangeMilliMeter, record.sensor);
+            return 1;
+        }
+        printf("ring: %u mm status %u signal %u/256 Mcps +%u us\n", record.rangeMilliMeter, record.status,
+               record.signalRate, record.delta * VL53L0X_RECORD_TICK_US);
+        count++;
+    }
+    if (count != SAMPLES || VL53L0X_Ring_getDropped() != 0) {
+        printf("ring: %u records, %u dropped :(\n", count, VL53L0X_Ring_getDropped());
+        return 1;
+    }
+
+    count = VL53L0X_getLatency(&minUs, &avgUs, &p99Us, 0);
+    printf("latency: %u samples, min %u us, avg %u us, p99 %u us\n", count, minUs, avgUs, p99Us);
+
+#ifdef VL53L0X_PROFILE
+    VL53L0X_ProfDump();
+#endif
+
+    return 0;
+}
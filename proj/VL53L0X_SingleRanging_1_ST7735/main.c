@@ -18,6 +18,7 @@
 #include "PLL.h"
 #include "I2C.h"
 #include "ST7735.h"
+#include "ST7735_Text.h"
 #include "VL53L0X.h"
 #include "VL53L0X_DEBUG.h"
 
@@ -30,40 +31,44 @@ int main(void) {
     /*-- ST7735 Init --*/
     ST7735_InitR(INITR_REDTAB);
     
-    ST7735_SetCursor(0, 0);
-    ST7735_FillScreen(ST7735_BLACK);
+    ST7735_Text_Init(ST7735_YELLOW, ST7735_BLACK);
     
-    ST7735_OutString("@author: Zee Lv");
-    ST7735_OutChar('\n');
-    ST7735_OutString("--------------------");
-    ST7735_OutChar('\n');
+    ST7735_Text_putString("@author: Zee Lv");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_putString("--------------------");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_flush();
     
     /*-- VL53L0X Init --*/
     if(!VL53L0X_Init(0)) {
-        ST7735_OutString("Fail to init VL53L0X");
+        ST7735_Text_putString("Fail to init VL53L0X");
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("VL53L0X Ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("VL53L0X Ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
     }
     if(!VL53L0X_SingleRanging_Init(0)) {
-        ST7735_OutString("SRD Mode init failed :(");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("SRD Mode init failed :(");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("SRD Mode Ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("SRD Mode Ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
     }
     
-    ST7735_SetCursor(0, 0);
-    ST7735_FillScreen(ST7735_BLACK);
+    ST7735_Text_clear();
     
-    ST7735_OutString("@author: Zee Lv");
-    ST7735_OutChar('\n');
-    ST7735_OutString("--------------------");
-    ST7735_OutChar('\n');
+    ST7735_Text_putString("@author: Zee Lv");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_putString("--------------------");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_flush();
     
     VL53L0X_RangingMeasurementData_t measurement;
     
@@ -71,15 +76,16 @@ int main(void) {
     while(1) {
         VL53L0X_getSingleRangingMeasurement(&measurement, 0);
         if (measurement.RangeStatus != 4) {
-            ST7735_OutString("Distance: ");
-            ST7735_OutUDec(measurement.RangeMilliMeter);
-            ST7735_OutString(" mm ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Distance: ");
+            ST7735_Text_putUDec(measurement.RangeMilliMeter);
+            ST7735_Text_putString(" mm ");
+            ST7735_Text_putChar('\n');
         } else {
-            ST7735_OutString("Out of range :( ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Out of range :( ");
+            ST7735_Text_putChar('\n');
         }
         // delay(1000);                                // take a break
-        ST7735_SetCursor(0, 2);
+        ST7735_Text_flush();                       // only the digits that changed
+        ST7735_Text_setCursor(0, 2);
     }
 }
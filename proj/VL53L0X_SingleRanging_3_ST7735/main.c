@@ -18,6 +18,7 @@
 #include "PLL.h"
 #include "I2C.h"
 #include "ST7735.h"
+#include "ST7735_Text.h"
 #include "VL53L0X.h"
 #include "VL53L0X_DEBUG.h"
 #include "xshut.h"
@@ -32,34 +33,38 @@ int main(void) {
     /*-- ST7735 Init --*/
     ST7735_InitR(INITR_REDTAB);
     
-    ST7735_SetCursor(0, 0);
-    ST7735_FillScreen(ST7735_BLACK);
+    ST7735_Text_Init(ST7735_YELLOW, ST7735_BLACK);
     
-    ST7735_OutString("@author: Zee Lv");
-    ST7735_OutChar('\n');
-    ST7735_OutString("--------------------");
-    ST7735_OutChar('\n');
+    ST7735_Text_putString("@author: Zee Lv");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_putString("--------------------");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_flush();
     
     /*-- VL53L0X Init --*/
     // must always inititalize with address 0x29
     // init and wake up VL53L0X sensor 1
     if(!VL53L0X_Init(0)) {
-        ST7735_OutString("Fail to init sensor 1");
+        ST7735_Text_putString("Fail to init sensor 1");
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("Sensor 1 ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("Sensor 1 ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         VL53L0X_setAddress(VL53L0X_I2C_ADDR + 1, 0); // change address after initialization
     }
     if(!VL53L0X_SingleRanging_Init(0)) {
-        ST7735_OutString("S1 SRD Mode failed");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S1 SRD Mode failed");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("S1 SRD Mode ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S1 SRD Mode ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
     }
     
     // switch to initaialize next sensor
@@ -68,22 +73,26 @@ int main(void) {
     // must always inititalize with address 0x29
     // init and wake up VL53L0X sensor 2
     if(!VL53L0X_Init(1)) {
-        ST7735_OutString("Fail to init sensor 2");
+        ST7735_Text_putString("Fail to init sensor 2");
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("Sensor 2 ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("Sensor 2 ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         VL53L0X_setAddress(VL53L0X_I2C_ADDR + 2, 1); // change address after initialization
     }
     if(!VL53L0X_SingleRanging_Init(1)) {
-        ST7735_OutString("S2 SRD Mode failed");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S2 SRD Mode failed");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("S2 SRD Mode ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S2 SRD Mode ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
     }
     
     // switch to initaialize next sensor
@@ -92,30 +101,34 @@ int main(void) {
     // must always inititalize with address 0x29
     // init and wake up VL53L0X sensor 3
     if(!VL53L0X_Init(2)) {
-        ST7735_OutString("Fail to init sensor 3");
+        ST7735_Text_putString("Fail to init sensor 3");
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("Sensor 3 ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("Sensor 3 ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
     }
     if(!VL53L0X_SingleRanging_Init(2)) {
-        ST7735_OutString("S3 SRD Mode failed");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S3 SRD Mode failed");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("S3 SRD Mode ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S3 SRD Mode ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
     }
     
-    ST7735_SetCursor(0, 0);
-    ST7735_FillScreen(ST7735_BLACK);
+    ST7735_Text_clear();
     
-    ST7735_OutString("@author: Zee Lv");
-    ST7735_OutChar('\n');
-    ST7735_OutString("--------------------");
-    ST7735_OutChar('\n');
+    ST7735_Text_putString("@author: Zee Lv");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_putString("--------------------");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_flush();
     
     VL53L0X_RangingMeasurementData_t measurement1;
     VL53L0X_RangingMeasurementData_t measurement2;
@@ -123,48 +136,50 @@ int main(void) {
     
     /*-- loop --*/
     while(1) {
-        ST7735_OutString("Sensor 1, measuring");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("Sensor 1, measuring");
+        ST7735_Text_putChar('\n');
         VL53L0X_getSingleRangingMeasurement(&measurement1, 0);
         // 8000 cap to avoid out of range #
         if (measurement1.RangeStatus != 4 || measurement1.RangeMilliMeter < 8000) {
-            ST7735_OutString("Distance: ");
-            ST7735_OutUDec(measurement1.RangeMilliMeter);
-            ST7735_OutString(" mm ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Distance: ");
+            ST7735_Text_putUDec(measurement1.RangeMilliMeter);
+            ST7735_Text_putString(" mm ");
+            ST7735_Text_putChar('\n');
         } else {
-            ST7735_OutString("Out of range :( ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Out of range :( ");
+            ST7735_Text_putChar('\n');
         }
         
-        ST7735_OutString("Sensor 2, measuring");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("Sensor 2, measuring");
+        ST7735_Text_putChar('\n');
         VL53L0X_getSingleRangingMeasurement(&measurement2, 1);
         // 8000 cap to avoid out of range #
         if (measurement2.RangeStatus != 4 || measurement2.RangeMilliMeter < 8000) {
-            ST7735_OutString("Distance: ");
-            ST7735_OutUDec(measurement2.RangeMilliMeter);
-            ST7735_OutString(" mm ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Distance: ");
+            ST7735_Text_putUDec(measurement2.RangeMilliMeter);
+            ST7735_Text_putString(" mm ");
+            ST7735_Text_putChar('\n');
         } else {
-            ST7735_OutString("Out of range :( ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Out of range :( ");
+            ST7735_Text_putChar('\n');
         }
         
-        ST7735_OutString("Sensor 3, measuring");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("Sensor 3, measuring");
+        ST7735_Text_putChar('\n');
         VL53L0X_getSingleRangingMeasurement(&measurement3, 2);
         // 8000 cap to avoid out of range #
         if (measurement3.RangeStatus != 4 || measurement3.RangeMilliMeter < 8000) {
-            ST7735_OutString("Distance: ");
-            ST7735_OutUDec(measurement3.RangeMilliMeter);
-            ST7735_OutString(" mm ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Distance: ");
+            ST7735_Text_putUDec(measurement3.RangeMilliMeter);
+            ST7735_Text_putString(" mm ");
+            ST7735_Text_putChar('\n');
         } else {
-            ST7735_OutString("Out of range :( ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Out of range :( ");
+            ST7735_Text_putChar('\n');
         }
         
-        ST7735_SetCursor(0, 2);
+        ST7735_Text_flush();                       // only the digits that changed
+        
+        ST7735_Text_setCursor(0, 2);
     }
 }
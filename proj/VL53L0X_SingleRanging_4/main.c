@@ -21,12 +21,16 @@
 #include "Serial.h"
 #include "VL53L0X.h"
 #include "xshut.h"
+#include "EEPROM.h"
+#include "VL53L0X_calibration.h"
 
 int main(void) {
     /*-- TM4C123 Init --*/
     PLL_Init(Bus80MHz);                   	     		    // bus clock at 80 MHz
     Serial_Init();                        	     		    // for serial I/O
     xshut_Init();                                		    // for multi senesor setup
+    EEPROM_Init();                                          // for stored calibration
+    VL53L0X_Calibration_setStore(&VL53L0X_CalStoreEEPROM);  // warm boot skips calibration
     
     // must always inititalize with address 0x29
     if(!VL53L0X_Init(0)) {                                  // init and wake up VL53L0X sensor 1
@@ -109,9 +113,16 @@ int main(void) {
     
     /*-- loop --*/
     while(1) {                            	     		// read and process
+        // range on all sensors at once, a frame takes one timing budget
+        for (int i = 0; i < 4; i++) VL53L0X_startRanging(i);
+        while (!(VL53L0X_isRangingReady(0) && VL53L0X_isRangingReady(1) &&
+                 VL53L0X_isRangingReady(2) && VL53L0X_isRangingReady(3))) {};
+        VL53L0X_fetchRanging(0, &measurement1);
+        VL53L0X_fetchRanging(1, &measurement2);
+        VL53L0X_fetchRanging(2, &measurement3);
+        VL53L0X_fetchRanging(3, &measurement4);
         
         Serial_println("Sensor 1, measuring... ");
-        VL53L0X_getSingleRangingMeasurement(&measurement1, 0);
         if (measurement1.RangeStatus != 4 || measurement1.RangeMilliMeter < 8000) {			// 8000 cap to avoid out of range #
             Serial_println("Distance: %u mm", measurement1.RangeMilliMeter);
         } else {
@@ -119,7 +130,6 @@ int main(void) {
         }
         
         Serial_println("Sensor 2, measuring... ");
-        VL53L0X_getSingleRangingMeasurement(&measurement2, 1);
         if (measurement2.RangeStatus != 4 || measurement2.RangeMilliMeter < 8000) {			// 8000 cap to avoid out of range #
             Serial_println("Distance: %u mm", measurement2.RangeMilliMeter);
         } else {
@@ -127,7 +137,6 @@ int main(void) {
         }
         
         Serial_println("Sensor 3, measuring... ");
-        VL53L0X_getSingleRangingMeasurement(&measurement3, 2);
         if (measurement3.RangeStatus != 4 || measurement3.RangeMilliMeter < 8000) {			// 8000 cap to avoid out of range #
             Serial_println("Distance: %u mm", measurement3.RangeMilliMeter);
         } else {
@@ -135,7 +144,6 @@ int main(void) {
         }
         
         Serial_println("Sensor 4, measuring... ");
-        VL53L0X_getSingleRangingMeasurement(&measurement4, 3);
         if (measurement4.RangeStatus != 4 || measurement4.RangeMilliMeter < 8000) {			// 8000 cap to avoid out of range #
             Serial_println("Distance: %u mm", measurement4.RangeMilliMeter);
         } else {
@@ -18,48 +18,58 @@
 #include "PLL.h"
 #include "I2C.h"
 #include "ST7735.h"
+#include "ST7735_Text.h"
+#include "ST7735_Chart.h"
 #include "VL53L0X.h"
 #include "VL53L0X_DEBUG.h"
 #include "xshut.h"
+#include "EEPROM.h"
+#include "VL53L0X_calibration.h"
 
 int main(void) {
     /*-- TM4C123 Init --*/
     PLL_Init(Bus80MHz);                             // bus clock at 80 MHz
     xshut_Init();                                   // for multi senesor setup
+    EEPROM_Init();                                  // for stored calibration
+    VL53L0X_Calibration_setStore(&VL53L0X_CalStoreEEPROM); // warm boot skips calibration
 
     VL53L0X_DEBUG_INIT();
     
     /*-- ST7735 Init --*/
     ST7735_InitR(INITR_REDTAB);
     
-    ST7735_SetCursor(0, 0);
-    ST7735_FillScreen(ST7735_BLACK);
+    ST7735_Text_Init(ST7735_YELLOW, ST7735_BLACK);
     
-    ST7735_OutString("@author: Zee Lv");
-    ST7735_OutChar('\n');
-    ST7735_OutString("--------------------");
-    ST7735_OutChar('\n');
+    ST7735_Text_putString("@author: Zee Lv");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_putString("--------------------");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_flush();
     
     /*-- VL53L0X Init --*/
     // must always inititalize with address 0x29
     // init and wake up VL53L0X sensor 1
     if(!VL53L0X_Init(0)) {
-        ST7735_OutString("Fail to init sensor 1");
+        ST7735_Text_putString("Fail to init sensor 1");
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("Sensor 1 ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("Sensor 1 ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         VL53L0X_setAddress(VL53L0X_I2C_ADDR + 1, 0); // change address after initialization
     }
     if(!VL53L0X_SingleRanging_Init(0)) {
-        ST7735_OutString("S1 SRD Mode failed");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S1 SRD Mode failed");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("S1 SRD Mode ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S1 SRD Mode ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
     }
     
     // switch to initaialize next sensor
@@ -68,22 +78,26 @@ int main(void) {
     // must always inititalize with address 0x29
     // init and wake up VL53L0X sensor 2
     if(!VL53L0X_Init(1)) {
-        ST7735_OutString("Fail to init sensor 2");
+        ST7735_Text_putString("Fail to init sensor 2");
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("Sensor 2 ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("Sensor 2 ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         VL53L0X_setAddress(VL53L0X_I2C_ADDR + 2, 1); // change address after initialization
     }
     if(!VL53L0X_SingleRanging_Init(1)) {
-        ST7735_OutString("S2 SRD Mode failed");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S2 SRD Mode failed");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("S2 SRD Mode ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S2 SRD Mode ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
     }
     
     // switch to initaialize next sensor
@@ -92,22 +106,26 @@ int main(void) {
     // must always inititalize with address 0x29
     // init and wake up VL53L0X sensor 3
     if(!VL53L0X_Init(2)) {
-        ST7735_OutString("Fail to init sensor 3");
+        ST7735_Text_putString("Fail to init sensor 3");
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("Sensor 3 ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("Sensor 3 ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         VL53L0X_setAddress(VL53L0X_I2C_ADDR + 3, 2); // change address after initialization
     }
     if(!VL53L0X_SingleRanging_Init(2)) {
-        ST7735_OutString("S3 SRD Mode failed");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S3 SRD Mode failed");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("S3 SRD Mode ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S3 SRD Mode ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
     }
     
     // switch to initaialize next sensor
@@ -116,30 +134,37 @@ int main(void) {
     // must always inititalize with address 0x29
     // init and wake up VL53L0X sensor 4
     if(!VL53L0X_Init(3)) {
-        ST7735_OutString("Fail to init sensor 4");
+        ST7735_Text_putString("Fail to init sensor 4");
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("Sensor 4 ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("Sensor 4 ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
     }
     if(!VL53L0X_SingleRanging_Init(3)) {
-        ST7735_OutString("S4 SRD Mode failed");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S4 SRD Mode failed");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
         delay(1);
         return 0;
     } else {
-        ST7735_OutString("S4 SRD Mode ready~ ");
-        ST7735_OutChar('\n');
+        ST7735_Text_putString("S4 SRD Mode ready~ ");
+        ST7735_Text_putChar('\n');
+        ST7735_Text_flush();
     }
     
-    ST7735_SetCursor(0, 0);
-    ST7735_FillScreen(ST7735_BLACK);
+    ST7735_Text_clear();
     
-    ST7735_OutString("@author: Zee Lv");
-    ST7735_OutChar('\n');
-    ST7735_OutString("--------------------");
-    ST7735_OutChar('\n');
+    ST7735_Text_putString("@author: Zee Lv");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_putString("--------------------");
+    ST7735_Text_putChar('\n');
+    ST7735_Text_flush();
+    
+    // distance history of the 4 sensors below the text, 0 to 2000 mm across
+    ST7735_Chart_Init(100, 60, 0, 2000, ST7735_BLACK);
     
     VL53L0X_RangingMeasurementData_t measurement1;
     VL53L0X_RangingMeasurementData_t measurement2;
@@ -148,62 +173,81 @@ int main(void) {
     
     /*-- loop --*/
     while(1) {
-        ST7735_OutString("Sensor 1, measuring");
-        ST7735_OutChar('\n');
-        VL53L0X_getSingleRangingMeasurement(&measurement1, 0);
+        // range on all sensors at once, a frame takes one timing budget
+        for (int i = 0; i < 4; i++) VL53L0X_startRanging(i);
+        while (!(VL53L0X_isRangingReady(0) && VL53L0X_isRangingReady(1) &&
+                 VL53L0X_isRangingReady(2) && VL53L0X_isRangingReady(3))) {};
+        VL53L0X_fetchRanging(0, &measurement1);
+        VL53L0X_fetchRanging(1, &measurement2);
+        VL53L0X_fetchRanging(2, &measurement3);
+        VL53L0X_fetchRanging(3, &measurement4);
+        
+        ST7735_Text_setColor(ST7735_Chart_getColor(0), ST7735_BLACK); // legend, the trace color
+        ST7735_Text_putString("Sensor 1, measuring");
+        ST7735_Text_putChar('\n');
         // 8000 cap to avoid out of range #
         if (measurement1.RangeStatus != 4 || measurement1.RangeMilliMeter < 8000) {
-            ST7735_OutString("Distance: ");
-            ST7735_OutUDec(measurement1.RangeMilliMeter - 20);
-            ST7735_OutString(" mm ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Distance: ");
+            ST7735_Text_putUDec(measurement1.RangeMilliMeter - 20);
+            ST7735_Text_putString(" mm ");
+            ST7735_Text_putChar('\n');
         } else {
-            ST7735_OutString("Out of range :( ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Out of range :( ");
+            ST7735_Text_putChar('\n');
         }
         
-        ST7735_OutString("Sensor 2, measuring");
-        ST7735_OutChar('\n');
-        VL53L0X_getSingleRangingMeasurement(&measurement2, 1);
+        ST7735_Text_setColor(ST7735_Chart_getColor(1), ST7735_BLACK); // legend, the trace color
+        ST7735_Text_putString("Sensor 2, measuring");
+        ST7735_Text_putChar('\n');
         // 8000 cap to avoid out of range #
         if (measurement2.RangeStatus != 4 || measurement2.RangeMilliMeter < 8000) {
-            ST7735_OutString("Distance: ");
-            ST7735_OutUDec(measurement2.RangeMilliMeter - 20);
-            ST7735_OutString(" mm ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Distance: ");
+            ST7735_Text_putUDec(measurement2.RangeMilliMeter - 20);
+            ST7735_Text_putString(" mm ");
+            ST7735_Text_putChar('\n');
         } else {
-            ST7735_OutString("Out of range :( ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Out of range :( ");
+            ST7735_Text_putChar('\n');
         }
         
-        ST7735_OutString("Sensor 3, measuring");
-        ST7735_OutChar('\n');
-        VL53L0X_getSingleRangingMeasurement(&measurement3, 2);
+        ST7735_Text_setColor(ST7735_Chart_getColor(2), ST7735_BLACK); // legend, the trace color
+        ST7735_Text_putString("Sensor 3, measuring");
+        ST7735_Text_putChar('\n');
         // 8000 cap to avoid out of range #
         if (measurement3.RangeStatus != 4 || measurement3.RangeMilliMeter < 8000) {
-            ST7735_OutString("Distance: ");
-            ST7735_OutUDec(measurement3.RangeMilliMeter - 10);
-            ST7735_OutString(" mm ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Distance: ");
+            ST7735_Text_putUDec(measurement3.RangeMilliMeter - 10);
+            ST7735_Text_putString(" mm ");
+            ST7735_Text_putChar('\n');
         } else {
-            ST7735_OutString("Out of range :( ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Out of range :( ");
+            ST7735_Text_putChar('\n');
         }
         
-        ST7735_OutString("Sensor 4, measuring");
-        ST7735_OutChar('\n');
-        VL53L0X_getSingleRangingMeasurement(&measurement4, 3);
+        ST7735_Text_setColor(ST7735_Chart_getColor(3), ST7735_BLACK); // legend, the trace color
+        ST7735_Text_putString("Sensor 4, measuring");
+        ST7735_Text_putChar('\n');
         // 8000 cap to avoid out of range #
         if (measurement3.RangeStatus != 4 || measurement4.RangeMilliMeter < 8000) {
-            ST7735_OutString("Distance: ");
-            ST7735_OutUDec(measurement4.RangeMilliMeter);
-            ST7735_OutString(" mm ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Distance: ");
+            ST7735_Text_putUDec(measurement4.RangeMilliMeter);
+            ST7735_Text_putString(" mm ");
+            ST7735_Text_putChar('\n');
         } else {
-            ST7735_OutString("Out of range :( ");
-            ST7735_OutChar('\n');
+            ST7735_Text_putString("Out of range :( ");
+            ST7735_Text_putChar('\n');
         }
 
-        ST7735_SetCursor(0, 2);
+        ST7735_Text_flush();                       // only the digits that changed
+
+        ST7735_Text_setCursor(0, 2);
+        
+        int32_t distances[4] = {
+            measurement1.RangeStatus != 4 ? measurement1.RangeMilliMeter - 20 : ST7735_CHART_GAP,
+            measurement2.RangeStatus != 4 ? measurement2.RangeMilliMeter - 20 : ST7735_CHART_GAP,
+            measurement3.RangeStatus != 4 ? measurement3.RangeMilliMeter - 10 : ST7735_CHART_GAP,
+            measurement4.RangeStatus != 4 ? measurement4.RangeMilliMeter      : ST7735_CHART_GAP,
+        };
+        ST7735_Chart_plot(distances, 4);           // one row and a scroll per frame
     }
 }